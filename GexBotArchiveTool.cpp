@@ -0,0 +1,2101 @@
+// GexBot Archive Tool
+// Standalone command line tool (not a Sierra Chart study) for the data tree
+// written by GexBotDataCollector / GexBotTerminalAPI.
+//
+// Build:
+//   Windows (MSVC): cl /std:c++17 /O2 /EHsc GexBotArchiveTool.cpp
+//   Linux/MinGW:    g++ -std=c++17 -O2 -pthread GexBotArchiveTool.cpp -o GexBotArchiveTool
+//   Reading / writing the Terminal's SQLite .db files needs -DGEXBOT_SQLITE and
+//   sqlite3 (g++: -lsqlite3; MSVC: add sqlite3.c or sqlite3.lib).
+//
+// Usage:
+//   GexBotArchiveTool compact <DataDir> [--threads N] [--keep-source]
+//       Converts every closed day (folder date before today) into Ticker.gexz
+//       and removes the .csv / .csv.commit / .csv.idx / .gexb sources once the
+//       archive has been verified. .grid files are left in place. The ticker
+//       catalogs are updated to list the .gexz files instead of the sources.
+//
+//   GexBotArchiveTool catalog <DataDir>
+//       Rebuilds every <DataDir>\<Ticker>.catalog from the day folders (for
+//       data written before the catalog existed, or after manual edits).
+//
+//   GexBotArchiveTool summary <DataDir> [--threads N]
+//       Rebuilds <DataDir>\<Ticker>.summary (one line per closed day) from the
+//       .gexz archives or CSVs still on disk. compact adds the days it archives.
+//
+//   GexBotArchiveTool export <DataDir> <OutDir> [--tickers A,B] [--from YYYYMMDD]
+//                            [--to YYYYMMDD] [--threads N]
+//       Writes <OutDir>\<Ticker>.arrow (Arrow IPC file, one record batch per
+//       day) from the .gexz archives or CSVs, for pyarrow / pandas / polars.
+//
+//   GexBotArchiveTool convert <DataDir> <OutDir> --format csv|gexz|db [--tickers A,B]
+//                             [--from YYYYMMDD] [--to YYYYMMDD] [--threads N]
+//       Merges every source of a day (.gexz, .csv, .db) into one table sorted
+//       by time with one row per timestamp, zeroed columns filled from the
+//       other sources, and writes <OutDir>\Tickers MM.DD.YYYY\<Ticker>.<format>.
+//       OutDir may be DataDir (files are swapped in). Reports rows/s.
+//
+//   GexBotArchiveTool validate <DataDir> [--tickers A,B] [--from YYYYMMDD]
+//                              [--to YYYYMMDD] [--threads N]
+//       Reads every source file and reports bad lines, out-of-order and
+//       duplicate timestamps, rows outside the folder date, NaN values, rows
+//       without zero_gamma and rows repeated across sources. Exit code 2 when
+//       a file has errors.
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <filesystem>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <climits>
+#include <limits>
+#include <cmath>
+#include <chrono>
+#ifdef GEXBOT_SQLITE
+#include <sqlite3.h>
+#endif
+
+namespace fs = std::filesystem;
+
+#define ARCHIVE_TOOL_VERSION "1.4.6"  // 2026-10-18: Summary updates hold <summary>.lock and use their own temp file
+
+// =========================
+//     ARCHIVE FORMAT (.gexz)
+// =========================
+// One file per ticker per closed day:
+//   GexzHeader
+//   field names (comma-separated, NUL padded to NamesBytes)
+//   FrameCount x GexzFrameEntry   (time-range index)
+//   frames
+// A frame covers one aligned GEXZ_FRAME_SECONDS window. Inside a frame every
+// column is encoded separately:
+//   timestamps: int64 first Unix ms, then (zigzag delta, run length) varint pairs
+//   floats:     tokens varint((repeat << 2) | (nbytes - 1)) + nbytes low bytes of
+//               (bits XOR previous bits); the value is then repeated 'repeat' times
+// Readers use the index to decode only the frames overlapping their window.
+
+#define GEXZ_MAGIC         0x5A585847u  // "GXXZ"
+#define GEXZ_VERSION       1u
+#define GEXZ_FRAME_SECONDS 300
+
+struct GexzHeader
+{
+    unsigned int Magic;
+    unsigned int Version;
+    unsigned int FieldCount;
+    unsigned int FrameCount;
+    unsigned long long RowCount;
+    unsigned int NamesBytes;
+    unsigned int Reserved;
+};
+
+struct GexzFrameEntry
+{
+    long long FirstTsMs;
+    long long LastTsMs;
+    unsigned long long Offset;   // From the start of the file
+    unsigned int Bytes;
+    unsigned int Rows;
+};
+
+// Decoded (or to-be-encoded) day: row-major values, FieldCount per row
+struct DayTable
+{
+    std::string Names;
+    int FieldCount = 0;
+    std::vector<long long> TsMs;
+    std::vector<float> Values;
+};
+
+// =========================
+//        VARINTS
+// =========================
+
+void PutVarint(std::string& out, unsigned long long v)
+{
+    while (v >= 0x80)
+    {
+        out += (char)(unsigned char)(v | 0x80);
+        v >>= 7;
+    }
+    out += (char)(unsigned char)v;
+}
+
+bool GetVarint(const unsigned char*& p, const unsigned char* end, unsigned long long& v)
+{
+    v = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7)
+    {
+        unsigned char b = *p++;
+        v |= (unsigned long long)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+unsigned long long ZigZag(long long v) { return ((unsigned long long)v << 1) ^ (unsigned long long)(v >> 63); }
+long long UnZigZag(unsigned long long v) { return (long long)(v >> 1) ^ -(long long)(v & 1); }
+
+// =========================
+//      FRAME CODEC
+// =========================
+
+std::string EncodeFrame(const DayTable& t, size_t first, size_t rows)
+{
+    std::string out;
+    out.append((const char*)&t.TsMs[first], sizeof(long long));
+
+    // Timestamps: runs of equal deltas (a 1 s collector is one token per frame)
+    size_t i = 1;
+    while (i < rows)
+    {
+        long long delta = t.TsMs[first + i] - t.TsMs[first + i - 1];
+        size_t run = 1;
+        while (i + run < rows && t.TsMs[first + i + run] - t.TsMs[first + i + run - 1] == delta) ++run;
+        PutVarint(out, ZigZag(delta));
+        PutVarint(out, run);
+        i += run;
+    }
+
+    for (int f = 0; f < t.FieldCount; ++f)
+    {
+        unsigned int prev = 0;
+        size_t r = 0;
+        while (r < rows)
+        {
+            unsigned int bits;
+            memcpy(&bits, &t.Values[(first + r) * t.FieldCount + f], sizeof(bits));
+            size_t repeat = 0;
+            while (r + 1 + repeat < rows &&
+                   memcmp(&t.Values[(first + r + 1 + repeat) * t.FieldCount + f], &bits, sizeof(bits)) == 0)
+                ++repeat;
+
+            unsigned int x = bits ^ prev;
+            int nbytes = (x >> 24) ? 4 : (x >> 16) ? 3 : (x >> 8) ? 2 : 1;
+            PutVarint(out, ((unsigned long long)repeat << 2) | (unsigned long long)(nbytes - 1));
+            for (int b = 0; b < nbytes; ++b) out += (char)(unsigned char)(x >> (8 * b));
+
+            prev = bits;
+            r += 1 + repeat;
+        }
+    }
+    return out;
+}
+
+bool DecodeFrame(const unsigned char* p, const unsigned char* end, int fieldCount, size_t rows,
+    std::vector<long long>& tsMs, std::vector<float>& values)
+{
+    size_t base = tsMs.size();
+    if (rows == 0 || end - p < (long)sizeof(long long)) return false;
+    tsMs.resize(base + rows);
+    values.resize((base + rows) * fieldCount);
+
+    memcpy(&tsMs[base], p, sizeof(long long));
+    p += sizeof(long long);
+    size_t i = 1;
+    while (i < rows)
+    {
+        unsigned long long zz, run;
+        if (!GetVarint(p, end, zz) || !GetVarint(p, end, run) || run == 0 || i + run > rows) return false;
+        long long delta = UnZigZag(zz);
+        for (unsigned long long k = 0; k < run; ++k, ++i)
+            tsMs[base + i] = tsMs[base + i - 1] + delta;
+    }
+
+    for (int f = 0; f < fieldCount; ++f)
+    {
+        unsigned int prev = 0;
+        size_t r = 0;
+        while (r < rows)
+        {
+            unsigned long long token;
+            if (!GetVarint(p, end, token)) return false;
+            int nbytes = (int)(token & 3) + 1;
+            unsigned long long repeat = token >> 2;
+            if (end - p < nbytes || r + 1 + repeat > rows) return false;
+
+            unsigned int x = 0;
+            for (int b = 0; b < nbytes; ++b) x |= (unsigned int)p[b] << (8 * b);
+            p += nbytes;
+
+            unsigned int bits = prev ^ x;
+            float v;
+            memcpy(&v, &bits, sizeof(v));
+            for (unsigned long long k = 0; k <= repeat; ++k, ++r)
+                values[(base + r) * fieldCount + f] = v;
+            prev = bits;
+        }
+    }
+    return true;
+}
+
+// =========================
+//     ARCHIVE FILE I/O
+// =========================
+
+bool WriteArchive(const std::string& path, const DayTable& t)
+{
+    // Split into aligned time windows
+    std::vector<std::pair<size_t, size_t>> frames; // (first row, rows)
+    const long long frameMs = GEXZ_FRAME_SECONDS * 1000LL;
+    size_t start = 0;
+    for (size_t r = 1; r <= t.TsMs.size(); ++r)
+    {
+        if (r == t.TsMs.size() || t.TsMs[r] / frameMs != t.TsMs[start] / frameMs)
+        {
+            frames.push_back(std::make_pair(start, r - start));
+            start = r;
+        }
+    }
+
+    GexzHeader hdr;
+    hdr.Magic = GEXZ_MAGIC;
+    hdr.Version = GEXZ_VERSION;
+    hdr.FieldCount = (unsigned int)t.FieldCount;
+    hdr.FrameCount = (unsigned int)frames.size();
+    hdr.RowCount = t.TsMs.size();
+    hdr.NamesBytes = (unsigned int)((t.Names.size() + 1 + 7) & ~(size_t)7);
+    hdr.Reserved = 0;
+
+    std::vector<std::string> payloads;
+    std::vector<GexzFrameEntry> index;
+    unsigned long long offset = sizeof(hdr) + hdr.NamesBytes + frames.size() * sizeof(GexzFrameEntry);
+    for (const auto& fr : frames)
+    {
+        payloads.push_back(EncodeFrame(t, fr.first, fr.second));
+        GexzFrameEntry e;
+        e.FirstTsMs = t.TsMs[fr.first];
+        e.LastTsMs = t.TsMs[fr.first + fr.second - 1];
+        e.Offset = offset;
+        e.Bytes = (unsigned int)payloads.back().size();
+        e.Rows = (unsigned int)fr.second;
+        index.push_back(e);
+        offset += e.Bytes;
+    }
+
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        std::string names = t.Names;
+        names.resize(hdr.NamesBytes, '\0');
+        out.write((const char*)&hdr, sizeof(hdr));
+        out.write(names.data(), names.size());
+        if (!index.empty()) out.write((const char*)index.data(), index.size() * sizeof(GexzFrameEntry));
+        for (const std::string& p : payloads) out.write(p.data(), p.size());
+        if (!out.good()) { out.close(); fs::remove(tmpPath); return false; }
+    }
+
+    std::error_code ec;
+    fs::rename(tmpPath, path, ec);
+    if (ec) { fs::remove(tmpPath, ec); return false; }
+    return true;
+}
+
+// Decodes frames overlapping [fromMs, toMs] (the whole day by default)
+bool ReadArchive(const std::string& path, DayTable& t, long long fromMs = LLONG_MIN, long long toMs = LLONG_MAX)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    GexzHeader hdr;
+    in.read((char*)&hdr, sizeof(hdr));
+    if (!in || hdr.Magic != GEXZ_MAGIC || hdr.Version != GEXZ_VERSION || hdr.FieldCount == 0) return false;
+
+    std::string names(hdr.NamesBytes, '\0');
+    in.read(&names[0], names.size());
+    std::vector<GexzFrameEntry> index(hdr.FrameCount);
+    if (hdr.FrameCount) in.read((char*)index.data(), index.size() * sizeof(GexzFrameEntry));
+    if (!in) return false;
+
+    t.Names = names.c_str();
+    t.FieldCount = (int)hdr.FieldCount;
+    t.TsMs.clear();
+    t.Values.clear();
+
+    std::string buf;
+    for (const GexzFrameEntry& e : index)
+    {
+        if (e.LastTsMs < fromMs || e.FirstTsMs > toMs) continue;
+        buf.resize(e.Bytes);
+        in.seekg((std::streamoff)e.Offset);
+        in.read(&buf[0], e.Bytes);
+        if (!in) return false;
+        const unsigned char* p = (const unsigned char*)buf.data();
+        if (!DecodeFrame(p, p + buf.size(), t.FieldCount, e.Rows, t.TsMs, t.Values)) return false;
+    }
+    return true;
+}
+
+// =========================
+//     SOURCE DAY FILES
+// =========================
+
+#define COMMIT_MAGIC   0x4D435847u  // "GXCM"
+#define COMMIT_VERSION 1u
+
+struct CommitRecord
+{
+    unsigned int Magic;
+    unsigned int Version;
+    unsigned long long CommittedBytes;
+    unsigned long long RowCount;
+    unsigned long long Checksum;
+};
+
+unsigned long long CommitChecksum(const CommitRecord& rec)
+{
+    return (rec.CommittedBytes * 0x9E3779B97F4A7C15ull) ^ (rec.RowCount + 0x632BE59BD9B4E019ull) ^ rec.Magic;
+}
+
+// Delimiters are found 16 bytes at a time with SSE2 (every x64 CPU has it)
+// and each field is converted in place with std::from_chars: no substrings,
+// no allocations, no exceptions. Other targets use the scalar loop.
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define CSV_TOKENIZER_SSE2 1
+#endif
+
+#ifdef CSV_TOKENIZER_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Bit i set = byte i of the 16 at p is ',' or '\n'
+inline unsigned int CsvDelimiterMask(const char* p)
+{
+    __m128i block = _mm_loadu_si128((const __m128i*)p);
+    __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(',')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\n')));
+    return (unsigned int)_mm_movemask_epi8(hits);
+}
+
+inline int LowestSetBit(unsigned int mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+// Blanks around the number are ignored; empty or non-numeric fields read as 0
+inline double ParseCsvNumber(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    while (end > p && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) --end;
+    if (p < end && *p == '+') ++p;
+    double v = 0.0;
+    if (std::from_chars(p, end, v).ec != std::errc()) return 0.0;
+    return v;
+}
+
+// Splits [begin, end) into lines and calls onRow(values, columnCount,
+// lineBegin, lineEnd) for every non-blank line (lineEnd excludes the '\n').
+// File column c is converted into values[slots[c]]; columns without a slot
+// (-1, or past the end of slots) are only scanned over. values[0, valueCount)
+// is NaN for every slot the line did not fill.
+template <typename RowFn>
+void TokenizeCsv(const char* begin, const char* end, const std::vector<int>& slots, double* values, int valueCount, RowFn onRow)
+{
+    const char* lineStart = begin;
+    const char* fieldStart = begin;
+    const int* slot = slots.data();
+    const int slotCount = (int)slots.size();
+    int column = 0;
+    std::fill(values, values + valueCount, std::numeric_limits<double>::quiet_NaN());
+
+    auto endLine = [&](const char* lineEnd) {
+        bool blank = (lineEnd == lineStart) || (lineEnd - lineStart == 1 && *lineStart == '\r');
+        if (!blank) onRow(values, column, lineStart, lineEnd);
+        column = 0;
+        lineStart = lineEnd + 1;
+        std::fill(values, values + valueCount, std::numeric_limits<double>::quiet_NaN());
+    };
+    auto delimiter = [&](const char* d) {
+        if (column < slotCount && slot[column] >= 0) values[slot[column]] = ParseCsvNumber(fieldStart, d);
+        ++column;
+        fieldStart = d + 1;
+        if (*d == '\n') endLine(d);
+    };
+
+    const char* p = begin;
+#ifdef CSV_TOKENIZER_SSE2
+    for (; end - p >= 16; p += 16)
+    {
+        for (unsigned int mask = CsvDelimiterMask(p); mask; mask &= mask - 1)
+            delimiter(p + LowestSetBit(mask));
+    }
+#endif
+    for (; p < end; ++p)
+        if (*p == ',' || *p == '\n') delimiter(p);
+
+    // Last line without a newline
+    if (lineStart < end)
+    {
+        if (column < slotCount && slot[column] >= 0) values[slot[column]] = ParseCsvNumber(fieldStart, end);
+        ++column;
+        endLine(end);
+    }
+}
+
+// Stable sort of the rows by timestamp (no copy when already in order)
+void SortTable(DayTable& t)
+{
+    std::vector<size_t> order(t.TsMs.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return t.TsMs[a] < t.TsMs[b]; });
+    bool sorted = true;
+    for (size_t i = 0; i < order.size() && sorted; ++i) sorted = (order[i] == i);
+    if (sorted) return;
+
+    DayTable s;
+    s.Names = t.Names;
+    s.FieldCount = t.FieldCount;
+    for (size_t i : order)
+    {
+        s.TsMs.push_back(t.TsMs[i]);
+        s.Values.insert(s.Values.end(), t.Values.begin() + i * t.FieldCount, t.Values.begin() + (i + 1) * t.FieldCount);
+    }
+    t = s;
+}
+
+// Problems found while reading / checking one day file (validate, convert)
+struct DayCheck
+{
+    unsigned long long Rows = 0;
+    unsigned long long BadLines = 0;    // Unparseable or non-positive timestamp
+    unsigned long long Unordered = 0;   // Row earlier than the row stored before it
+    unsigned long long Duplicates = 0;  // Timestamp already seen in the same file
+    unsigned long long OutOfDay = 0;    // Timestamp too far from the folder date
+    unsigned long long BadValues = 0;   // NaN / infinite values
+    unsigned long long ZeroRows = 0;    // zero_gamma missing (column zeroed by the writer)
+
+    bool Failed() const { return BadLines || Unordered || Duplicates || OutOfDay || BadValues; }
+};
+
+// Reads the committed part of a day CSV (see the commit protocol in GexBotDataCollector.cpp).
+// check: counts skipped lines and out-of-order rows as stored (the table comes back sorted).
+bool ReadCsvDay(const std::string& path, DayTable& t, DayCheck* check = nullptr)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    std::ifstream commitIn(path + ".commit", std::ios::binary);
+    CommitRecord rec;
+    if (commitIn.read((char*)&rec, sizeof(rec)) && rec.Magic == COMMIT_MAGIC && rec.Version == COMMIT_VERSION &&
+        rec.Checksum == CommitChecksum(rec) && rec.CommittedBytes <= content.size())
+        content.resize((size_t)rec.CommittedBytes);
+
+    // Complete lines only: a torn tail has no newline yet
+    size_t parseEnd = content.find_last_of('\n');
+    size_t headerStart = content.find_first_not_of("\r\n");
+    if (parseEnd == std::string::npos || headerStart > parseEnd) return true;
+    size_t headerEnd = content.find('\n', headerStart);
+    std::string header = content.substr(headerStart, headerEnd - headerStart);
+    if (!header.empty() && header.back() == '\r') header.pop_back();
+    if (isdigit((unsigned char)header[0]) || header[0] == '-') return false; // No header
+    t.Names = header.substr(header.find(',') + 1);
+    t.FieldCount = (int)std::count(header.begin(), header.end(), ',');
+    if (t.FieldCount == 0) return false;
+
+    std::vector<double> values(t.FieldCount + 1);
+    std::vector<int> slots(values.size());
+    for (size_t c = 0; c < slots.size(); ++c) slots[c] = (int)c;
+    TokenizeCsv(content.data() + headerEnd + 1, content.data() + parseEnd + 1, slots, values.data(), (int)values.size(),
+        [&](const double* row, int fieldCount, const char*, const char*) {
+            if (row[0] <= 0)
+            {
+                if (check) ++check->BadLines;
+                return;
+            }
+            long long tsMs = (long long)(row[0] * 1000.0 + 0.5);
+            if (check && !t.TsMs.empty() && tsMs < t.TsMs.back()) ++check->Unordered;
+            t.TsMs.push_back(tsMs);
+            for (int f = 1; f <= t.FieldCount; ++f)
+                t.Values.push_back(f < fieldCount ? (float)row[f] : 0.0f);
+        });
+
+    // Rows of a day are appended in time order, but a backfill merge or clock step can break that
+    SortTable(t);
+    return true;
+}
+
+// =========================
+//       DAY CATALOG
+// =========================
+// Same file as the studies: "<DataDir>\<Ticker>.catalog", one line per day
+// and format: date,format,rows,min_ts,max_ts,bytes (Unix seconds, rows -1 =
+// unknown), sorted by date.
+
+#define CATALOG_HEADER "# GexBot day catalog v1: date,format,rows,min_ts,max_ts,bytes\r\n"
+
+struct CatalogEntry
+{
+    int Date;
+    std::string Format;
+    long long Rows;
+    double MinTs;
+    double MaxTs;
+    unsigned long long Bytes;
+};
+
+bool ReadCatalog(const fs::path& path, std::vector<CatalogEntry>& entries)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#') continue;
+        CatalogEntry e;
+        char format[16] = {0};
+        if (sscanf(line.c_str(), "%d,%15[^,],%lld,%lf,%lf,%llu", &e.Date, format, &e.Rows, &e.MinTs, &e.MaxTs, &e.Bytes) != 6)
+            continue;
+        e.Format = format;
+        entries.push_back(e);
+    }
+    return true;
+}
+
+// Writers (this tool, the Collector, the API study, GexBotTerminal.cpp) serialize
+// their read-modify-write on "<catalog>.lock". Here it is created exclusively and
+// kept open while held; the studies open it without sharing and delete it on
+// close, so either side waits for the other.
+#define CATALOG_LOCK_TRIES     500
+#define CATALOG_LOCK_WAIT_MS   10
+#define CATALOG_LOCK_STALE_SEC 60     // Older = left by a run that died (a writer holds it for milliseconds)
+
+struct CatalogLock
+{
+    fs::path Path;
+    FILE* File = nullptr;
+
+    explicit CatalogLock(const fs::path& catalogPath) : Path(catalogPath.string() + ".lock")
+    {
+        for (int attempt = 0; attempt < CATALOG_LOCK_TRIES; ++attempt)
+        {
+            File = fopen(Path.string().c_str(), "wx");
+            if (File) return;
+
+            std::error_code ec;
+            fs::file_time_type written = fs::last_write_time(Path, ec);
+            if (!ec && fs::file_time_type::clock::now() - written > std::chrono::seconds(CATALOG_LOCK_STALE_SEC))
+                fs::remove(Path, ec);
+            else
+                std::this_thread::sleep_for(std::chrono::milliseconds(CATALOG_LOCK_WAIT_MS));
+        }
+    }
+
+    ~CatalogLock()
+    {
+        if (!File) return;
+        fclose(File);
+        std::error_code ec;
+        fs::remove(Path, ec);
+    }
+
+    bool Held() const { return File != nullptr; }
+};
+
+// Call with the path's CatalogLock held
+bool WriteCatalog(const fs::path& path, std::vector<CatalogEntry> entries)
+{
+    std::sort(entries.begin(), entries.end(), [](const CatalogEntry& a, const CatalogEntry& b) {
+        return a.Date != b.Date ? a.Date < b.Date : a.Format < b.Format;
+    });
+
+    // Own temp name: a study may be swapping in its catalog next to this one
+    fs::path tmp = path.string() + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "." +
+        std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        out << CATALOG_HEADER;
+        char line[160];
+        for (const CatalogEntry& e : entries)
+        {
+            snprintf(line, sizeof(line), "%d,%s,%lld,%.1f,%.1f,%llu\r\n", e.Date, e.Format.c_str(), e.Rows, e.MinTs, e.MaxTs, e.Bytes);
+            out << line;
+        }
+        if (!out) return false;
+    }
+
+    std::error_code ec;
+    fs::rename(tmp, path, ec);
+    if (ec) fs::remove(tmp, ec);
+    return !ec;
+}
+
+// Describes one day file; rows/timestamps are read where the format makes that cheap
+CatalogEntry DescribeDayFile(int ymd, const fs::path& file)
+{
+    std::error_code ec;
+    CatalogEntry e = { ymd, file.extension().string().substr(1), -1, 0.0, 0.0, fs::file_size(file, ec) };
+
+    if (e.Format == "csv")
+    {
+        DayTable t;
+        if (ReadCsvDay(file.string(), t))
+        {
+            e.Rows = (long long)t.TsMs.size();
+            if (!t.TsMs.empty()) { e.MinTs = t.TsMs.front() / 1000.0; e.MaxTs = t.TsMs.back() / 1000.0; }
+        }
+    }
+    else if (e.Format == "gexz")
+    {
+        std::ifstream in(file, std::ios::binary);
+        GexzHeader hdr;
+        if (in.read((char*)&hdr, sizeof(hdr)) && hdr.Magic == GEXZ_MAGIC)
+        {
+            e.Rows = (long long)hdr.RowCount;
+            std::vector<GexzFrameEntry> index(hdr.FrameCount);
+            in.seekg(sizeof(hdr) + hdr.NamesBytes);
+            if (hdr.FrameCount && in.read((char*)index.data(), index.size() * sizeof(GexzFrameEntry)))
+            {
+                e.MinTs = index.front().FirstTsMs / 1000.0;
+                e.MaxTs = index.back().LastTsMs / 1000.0;
+            }
+        }
+    }
+    else if (e.Format == "gexb")
+    {
+        // GexbHeader: Magic, Version, FieldCount, Capacity, RowCount, NamesBytes; then the ms column
+        std::ifstream in(file, std::ios::binary);
+        unsigned int hdr[6];
+        if (in.read((char*)hdr, sizeof(hdr)) && hdr[0] == 0x4E425847u)
+        {
+            e.Rows = (int)hdr[4];
+            long long first = 0, last = 0;
+            in.seekg(sizeof(hdr) + hdr[5]);
+            in.read((char*)&first, sizeof(first));
+            in.seekg(sizeof(hdr) + hdr[5] + (unsigned long long)(e.Rows - 1) * sizeof(long long));
+            in.read((char*)&last, sizeof(last));
+            if (in && e.Rows > 0) { e.MinTs = first / 1000.0; e.MaxTs = last / 1000.0; }
+        }
+    }
+    return e;
+}
+
+// =========================
+//      DAILY SUMMARY
+// =========================
+// Same file as GexBotDataCollector.cpp: "<DataDir>\<Ticker>.summary", one line
+// per closed session (zero gamma / spot OHLC, closing walls, wall moves, time
+// above / below zero gamma). Written here for every day that gets compacted.
+
+#define SUMMARY_HEADER "# GexBot daily summary v1: date,rows,zero_open,zero_high,zero_low,zero_close," \
+    "spot_open,spot_high,spot_low,spot_close,pos_vol_close,neg_vol_close,pos_oi_close,neg_oi_close," \
+    "pos_vol_moves,neg_vol_moves,sec_above_zero,sec_below_zero\r\n"
+
+struct DaySummary
+{
+    int Date;                   // YYYYMMDD of the "Tickers MM.DD.YYYY" folder
+    long long Rows;
+    double ZeroOpen, ZeroHigh, ZeroLow, ZeroClose;
+    double SpotOpen, SpotHigh, SpotLow, SpotClose;
+    double PosVolClose, NegVolClose, PosOiClose, NegOiClose;
+    int PosVolMoves, NegVolMoves;
+    int SecAboveZero, SecBelowZero;
+};
+
+bool ReadSummaries(const fs::path& path, std::vector<DaySummary>& days)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#') continue;
+        DaySummary d;
+        if (sscanf(line.c_str(), "%d,%lld,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%d,%d,%d,%d",
+                &d.Date, &d.Rows, &d.ZeroOpen, &d.ZeroHigh, &d.ZeroLow, &d.ZeroClose,
+                &d.SpotOpen, &d.SpotHigh, &d.SpotLow, &d.SpotClose,
+                &d.PosVolClose, &d.NegVolClose, &d.PosOiClose, &d.NegOiClose,
+                &d.PosVolMoves, &d.NegVolMoves, &d.SecAboveZero, &d.SecBelowZero) != 18)
+            continue;
+        days.push_back(d);
+    }
+    return true;
+}
+
+#define SUMMARY_MAX_GAP_SEC 60   // A longer gap between rows is not counted as time above/below zero
+
+// Summary of one day. values: row-major, fieldCount per row, CSV column order after
+// the timestamp. Only the base columns (primary source) are summarized; extra
+// package blocks from field 14 on are skipped.
+DaySummary SummarizeDay(int date, const std::vector<double>& ts, const std::vector<float>& values, int fieldCount)
+{
+    DaySummary d = { date, (long long)ts.size(), 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    double prevPosVol = 0, prevNegVol = 0, prevZero = 0, prevSpot = 0, prevTs = 0;
+
+    for (size_t r = 0; r < ts.size(); ++r)
+    {
+        const float* row = &values[r * fieldCount];
+        auto field = [&](int f) -> double {
+            double v = (f < fieldCount) ? row[f] : 0.0;
+            return (v != v) ? 0.0 : v;
+        };
+        double spot = field(0), zero = field(1), posVol = field(2), negVol = field(3);
+        double posOi = field(4), negOi = field(5);
+
+        // Time since the previous row goes to the side spot was on at that row
+        if (r > 0 && prevZero != 0 && prevSpot != 0)
+        {
+            double dt = std::min(ts[r] - prevTs, (double)SUMMARY_MAX_GAP_SEC);
+            if (dt > 0) (prevSpot > prevZero ? d.SecAboveZero : d.SecBelowZero) += (int)(dt + 0.5);
+        }
+        prevTs = ts[r];
+        if (zero != 0) prevZero = zero;
+        if (spot != 0) prevSpot = spot;
+
+        if (zero != 0)
+        {
+            if (d.ZeroOpen == 0) d.ZeroOpen = d.ZeroHigh = d.ZeroLow = zero;
+            d.ZeroHigh = std::max(d.ZeroHigh, zero);
+            d.ZeroLow = std::min(d.ZeroLow, zero);
+            d.ZeroClose = zero;
+        }
+        if (spot != 0)
+        {
+            if (d.SpotOpen == 0) d.SpotOpen = d.SpotHigh = d.SpotLow = spot;
+            d.SpotHigh = std::max(d.SpotHigh, spot);
+            d.SpotLow = std::min(d.SpotLow, spot);
+            d.SpotClose = spot;
+        }
+        if (posVol != 0)
+        {
+            if (prevPosVol != 0 && posVol != prevPosVol) ++d.PosVolMoves;
+            prevPosVol = d.PosVolClose = posVol;
+        }
+        if (negVol != 0)
+        {
+            if (prevNegVol != 0 && negVol != prevNegVol) ++d.NegVolMoves;
+            prevNegVol = d.NegVolClose = negVol;
+        }
+        if (posOi != 0) d.PosOiClose = posOi;
+        if (negOi != 0) d.NegOiClose = negOi;
+    }
+    return d;
+}
+
+std::string FormatSummaries(std::vector<DaySummary> days)
+{
+    std::sort(days.begin(), days.end(), [](const DaySummary& a, const DaySummary& b) { return a.Date < b.Date; });
+
+    std::string out = SUMMARY_HEADER;
+    char line[512];
+    for (const DaySummary& d : days)
+    {
+        snprintf(line, sizeof(line), "%d,%lld,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%d,%d,%d,%d\r\n",
+            d.Date, d.Rows, d.ZeroOpen, d.ZeroHigh, d.ZeroLow, d.ZeroClose,
+            d.SpotOpen, d.SpotHigh, d.SpotLow, d.SpotClose,
+            d.PosVolClose, d.NegVolClose, d.PosOiClose, d.NegOiClose,
+            d.PosVolMoves, d.NegVolMoves, d.SecAboveZero, d.SecBelowZero);
+        out += line;
+    }
+    return out;
+}
+
+// Replaces (or adds) the entries for the given dates
+void MergeSummaries(std::vector<DaySummary>& days, const std::vector<DaySummary>& updates)
+{
+    for (const DaySummary& u : updates)
+    {
+        days.erase(std::remove_if(days.begin(), days.end(), [&](const DaySummary& d) { return d.Date == u.Date; }), days.end());
+        days.push_back(u);
+    }
+}
+
+// Call with the path's CatalogLock held (the Collector locks "<summary>.lock" too)
+bool WriteSummaries(const fs::path& path, const std::vector<DaySummary>& days)
+{
+    // Own temp name, as for the catalog
+    fs::path tmp = path.string() + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "." +
+        std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        out << FormatSummaries(days);
+        if (!out) return false;
+    }
+
+    std::error_code ec;
+    fs::rename(tmp, path, ec);
+    if (ec) fs::remove(tmp, ec);
+    return !ec;
+}
+
+DaySummary SummarizeTable(int date, const DayTable& t)
+{
+    std::vector<double> ts(t.TsMs.size());
+    for (size_t i = 0; i < ts.size(); ++i) ts[i] = t.TsMs[i] / 1000.0;
+    return SummarizeDay(date, ts, t.Values, t.FieldCount);
+}
+
+// Adds the new day summaries of each ticker to its summary file
+int UpdateSummaryFiles(const std::string& dataDir, const std::map<std::string, std::vector<DaySummary>>& updates)
+{
+    int failed = 0;
+    for (const auto& kv : updates)
+    {
+        fs::path path = fs::path(dataDir) / (kv.first + ".summary");
+        CatalogLock lock(path);
+        if (!lock.Held())
+        {
+            fprintf(stderr, "Cannot lock %s, not updated (run 'summary' later)\n", path.string().c_str());
+            ++failed;
+            continue;
+        }
+        std::vector<DaySummary> days;
+        ReadSummaries(path, days);
+        MergeSummaries(days, kv.second);
+        if (!WriteSummaries(path, days))
+        {
+            fprintf(stderr, "Cannot update %s\n", path.string().c_str());
+            ++failed;
+        }
+    }
+    return failed;
+}
+
+// =========================
+//    ARROW IPC EXPORT
+// =========================
+// Research export: one Arrow IPC file (Feather v2, uncompressed) per ticker
+// with a timestamp[ms, UTC] column and one float32 column per CSV field, one
+// record batch per day. pyarrow / pandas / polars map it without parsing:
+//   pyarrow.ipc.open_file(pyarrow.memory_map(path)).read_all()
+// The flatbuffer metadata is written by the small builder below (no Arrow
+// dependency); only the parts of the format this file needs are covered.
+
+// Back-to-front flatbuffer builder. References are "distance from the end",
+// as in the reference implementation, so children are built before parents.
+class FlatBuilder
+{
+public:
+    size_t Size() const { return Buf.size(); }
+
+    void Align(size_t alignment, size_t extra = 0)
+    {
+        while ((Buf.size() + extra) % alignment) Buf.push_back(0);
+        MaxAlign = std::max(MaxAlign, alignment);
+    }
+
+    template <class T> void Prepend(const T& v)
+    {
+        const unsigned char* p = (const unsigned char*)&v;
+        for (size_t i = sizeof(T); i-- > 0; ) Buf.push_back(p[i]);
+    }
+
+    void PrependBytes(const void* data, size_t n)
+    {
+        const unsigned char* p = (const unsigned char*)data;
+        for (size_t i = n; i-- > 0; ) Buf.push_back(p[i]);
+    }
+
+    void PrependOffset(size_t ref)
+    {
+        Align(4, 4);
+        Prepend((unsigned int)(Buf.size() + 4 - ref));
+    }
+
+    size_t CreateString(const std::string& s)
+    {
+        Align(4, s.size() + 1);
+        Buf.push_back(0);
+        PrependBytes(s.data(), s.size());
+        Prepend((unsigned int)s.size());
+        return Buf.size();
+    }
+
+    size_t CreateOffsetVector(const std::vector<size_t>& refs)
+    {
+        Align(4, refs.size() * 4);
+        for (size_t i = refs.size(); i-- > 0; ) PrependOffset(refs[i]);
+        Prepend((unsigned int)refs.size());
+        return Buf.size();
+    }
+
+    // Structs are passed already laid out (little endian, padded to structAlign)
+    size_t CreateStructVector(const void* data, size_t count, size_t structSize, size_t structAlign)
+    {
+        Align(std::max<size_t>(structAlign, 4), count * structSize);
+        PrependBytes(data, count * structSize);
+        Prepend((unsigned int)count);
+        return Buf.size();
+    }
+
+    // Fields are added after BeginTable; any child object must be created before it
+    void BeginTable()
+    {
+        Fields.clear();
+        TableStart = Buf.size();
+    }
+
+    template <class T> void AddScalar(int id, T v)
+    {
+        Align(sizeof(T), sizeof(T));
+        Prepend(v);
+        Fields.push_back(std::make_pair(id, Buf.size()));
+    }
+
+    void AddOffset(int id, size_t ref)
+    {
+        PrependOffset(ref);
+        Fields.push_back(std::make_pair(id, Buf.size()));
+    }
+
+    size_t EndTable()
+    {
+        Align(4, 4);
+        Prepend((int)0);  // soffset to the vtable, patched below
+        size_t table = Buf.size();
+
+        int maxId = -1;
+        for (const auto& f : Fields) maxId = std::max(maxId, f.first);
+        std::vector<unsigned short> slots(maxId + 1, 0);
+        for (const auto& f : Fields) slots[f.first] = (unsigned short)(table - f.second);
+
+        for (size_t i = slots.size(); i-- > 0; ) Prepend(slots[i]);
+        Prepend((unsigned short)(table - TableStart));
+        Prepend((unsigned short)(4 + 2 * slots.size()));
+
+        // The vtable sits right before the table: soffset = table address - vtable address
+        unsigned int soffset = (unsigned int)(Buf.size() - table);
+        for (int i = 0; i < 4; ++i) Buf[table - 1 - i] = (unsigned char)(soffset >> (8 * i));
+        return table;
+    }
+
+    std::string Finish(size_t root)
+    {
+        Align(std::max<size_t>(MaxAlign, 8), 4);
+        PrependOffset(root);
+        return std::string(Buf.rbegin(), Buf.rend());
+    }
+
+private:
+    std::vector<unsigned char> Buf;  // Stored reversed; Finish() flips it
+    std::vector<std::pair<int, size_t>> Fields;
+    size_t TableStart = 0;
+    size_t MaxAlign = 1;
+};
+
+#define ARROW_METADATA_V5     4
+#define ARROW_HEADER_SCHEMA   1
+#define ARROW_HEADER_BATCH    3
+#define ARROW_TYPE_FLOAT      3
+#define ARROW_TYPE_TIMESTAMP  10
+#define ARROW_PRECISION_SINGLE 1
+#define ARROW_UNIT_MS         1
+
+// Footer entry locating one record batch message in the file
+struct ArrowBlock
+{
+    long long Offset;
+    int MetaDataLength;
+    int Pad;
+    long long BodyLength;
+};
+
+// Schema table: timestamp[ms, UTC] then one float32 column per field name
+size_t BuildArrowSchema(FlatBuilder& b, const std::vector<std::string>& fieldNames)
+{
+    std::vector<size_t> fields;
+    for (size_t i = 0; i <= fieldNames.size(); ++i)
+    {
+        bool isTs = (i == 0);
+        size_t name = b.CreateString(isTs ? "timestamp" : fieldNames[i - 1]);
+        size_t type;
+        if (isTs)
+        {
+            size_t tz = b.CreateString("UTC");
+            b.BeginTable();
+            b.AddScalar<short>(0, ARROW_UNIT_MS);
+            b.AddOffset(1, tz);
+            type = b.EndTable();
+        }
+        else
+        {
+            b.BeginTable();
+            b.AddScalar<short>(0, ARROW_PRECISION_SINGLE);
+            type = b.EndTable();
+        }
+        size_t children = b.CreateOffsetVector(std::vector<size_t>());
+
+        b.BeginTable();
+        b.AddOffset(0, name);
+        b.AddOffset(3, type);
+        b.AddOffset(5, children);
+        b.AddScalar<unsigned char>(1, 0);  // Not nullable
+        b.AddScalar<unsigned char>(2, isTs ? ARROW_TYPE_TIMESTAMP : ARROW_TYPE_FLOAT);
+        fields.push_back(b.EndTable());
+    }
+    size_t vec = b.CreateOffsetVector(fields);
+
+    b.BeginTable();
+    b.AddOffset(1, vec);
+    b.AddScalar<short>(0, 0);  // Little endian
+    return b.EndTable();
+}
+
+std::string FinishArrowMessage(FlatBuilder& b, unsigned char headerType, size_t header, long long bodyLength)
+{
+    b.BeginTable();
+    b.AddScalar<long long>(3, bodyLength);
+    b.AddOffset(2, header);
+    b.AddScalar<short>(0, ARROW_METADATA_V5);
+    b.AddScalar<unsigned char>(1, headerType);
+    return b.Finish(b.EndTable());
+}
+
+// One day as a record batch: metadata + body (columns transposed out of the row-major table)
+std::string BuildArrowBatch(const DayTable& t, std::string& body)
+{
+    size_t rows = t.TsMs.size();
+    std::vector<long long> nodes;    // FieldNode {length, null_count}
+    std::vector<long long> buffers;  // Buffer {offset, length}: validity (none), then values
+    body.clear();
+
+    auto addColumn = [&](const void* data, size_t bytes) {
+        nodes.push_back((long long)rows);
+        nodes.push_back(0);
+        buffers.push_back((long long)body.size());
+        buffers.push_back(0);
+        buffers.push_back((long long)body.size());
+        buffers.push_back((long long)bytes);
+        body.append((const char*)data, bytes);
+        body.append((8 - body.size() % 8) % 8, '\0');
+    };
+
+    addColumn(t.TsMs.data(), rows * sizeof(long long));
+    std::vector<float> column(rows);
+    for (int f = 0; f < t.FieldCount; ++f)
+    {
+        for (size_t r = 0; r < rows; ++r)
+            column[r] = t.Values[r * t.FieldCount + f];
+        addColumn(column.data(), rows * sizeof(float));
+    }
+
+    FlatBuilder b;
+    size_t nodesVec = b.CreateStructVector(nodes.data(), nodes.size() / 2, 16, 8);
+    size_t buffersVec = b.CreateStructVector(buffers.data(), buffers.size() / 2, 16, 8);
+    b.BeginTable();
+    b.AddScalar<long long>(0, (long long)rows);
+    b.AddOffset(1, nodesVec);
+    b.AddOffset(2, buffersVec);
+    return FinishArrowMessage(b, ARROW_HEADER_BATCH, b.EndTable(), (long long)body.size());
+}
+
+// Encapsulated message: continuation marker, metadata length (8-byte padded), metadata, body
+void WriteArrowMessage(std::ofstream& out, unsigned long long& pos, const std::string& metadata, const std::string& body, ArrowBlock* block)
+{
+    int metaLength = (int)((metadata.size() + 8 + 7) / 8 * 8 - 8);
+    unsigned int marker = 0xFFFFFFFFu;
+    out.write((const char*)&marker, 4);
+    out.write((const char*)&metaLength, 4);
+    out.write(metadata.data(), metadata.size());
+    out.write(std::string(metaLength - metadata.size(), '\0').data(), metaLength - metadata.size());
+    out.write(body.data(), body.size());
+
+    if (block)
+    {
+        block->Offset = (long long)pos;
+        block->MetaDataLength = metaLength + 8;
+        block->Pad = 0;
+        block->BodyLength = (long long)body.size();
+    }
+    pos += 8 + metaLength + body.size();
+}
+
+std::vector<std::string> SplitNames(const std::string& names)
+{
+    std::vector<std::string> out;
+    std::stringstream ss(names);
+    std::string name;
+    while (std::getline(ss, name, ',')) out.push_back(name);
+    return out;
+}
+
+// =========================
+//        COMPACTOR
+// =========================
+
+struct CompactJob
+{
+    fs::path CsvPath;
+    int Date;
+};
+
+// "Tickers MM.DD.YYYY" -> YYYYMMDD, 0 if not a day folder
+int ParseDayFolder(const std::string& name)
+{
+    int m, d, y;
+    if (sscanf(name.c_str(), "Tickers %d.%d.%d", &m, &d, &y) != 3) return 0;
+    return y * 10000 + m * 100 + d;
+}
+
+int TodayYmd()
+{
+    std::time_t now = std::time(nullptr);
+    std::tm local = *std::localtime(&now);
+    return (local.tm_year + 1900) * 10000 + (local.tm_mon + 1) * 100 + local.tm_mday;
+}
+
+bool TablesEqual(const DayTable& a, const DayTable& b)
+{
+    return a.FieldCount == b.FieldCount && a.Names == b.Names && a.TsMs == b.TsMs &&
+        a.Values.size() == b.Values.size() &&
+        (a.Values.empty() || memcmp(a.Values.data(), b.Values.data(), a.Values.size() * sizeof(float)) == 0);
+}
+
+int RunCompact(const std::string& dataDir, int threads, bool keepSource)
+{
+    int today = TodayYmd();
+    std::vector<CompactJob> jobs;
+
+    std::error_code ec;
+    for (const auto& dayDir : fs::directory_iterator(dataDir, ec))
+    {
+        if (!dayDir.is_directory()) continue;
+        int ymd = ParseDayFolder(dayDir.path().filename().string());
+        if (ymd == 0 || ymd >= today) continue; // Still open
+
+        for (const auto& file : fs::directory_iterator(dayDir.path(), ec))
+            if (file.is_regular_file() && file.path().extension() == ".csv")
+                jobs.push_back(CompactJob{ file.path(), ymd });
+    }
+    if (ec)
+    {
+        fprintf(stderr, "Cannot list %s: %s\n", dataDir.c_str(), ec.message().c_str());
+        return 1;
+    }
+
+    // Days x tickers in parallel; each job owns its files
+    std::atomic<size_t> next(0);
+    std::atomic<int> done(0), failed(0);
+    std::atomic<unsigned long long> bytesIn(0), bytesOut(0);
+    std::mutex logMutex;
+    std::map<std::string, std::vector<CatalogEntry>> archived;  // Ticker -> new .gexz entries
+    std::map<std::string, std::vector<DaySummary>> summaries;
+
+    auto worker = [&]() {
+        for (size_t j = next++; j < jobs.size(); j = next++)
+        {
+            const fs::path& csv = jobs[j].CsvPath;
+            fs::path gexz = csv; gexz.replace_extension(".gexz");
+
+            DayTable table, check;
+            bool ok = ReadCsvDay(csv.string(), table) && WriteArchive(gexz.string(), table) &&
+                ReadArchive(gexz.string(), check) && TablesEqual(table, check);
+
+            std::error_code fec;
+            if (!ok)
+            {
+                fs::remove(gexz, fec);
+                ++failed;
+                std::lock_guard<std::mutex> lock(logMutex);
+                fprintf(stderr, "FAILED %s\n", csv.string().c_str());
+                continue;
+            }
+
+            unsigned long long in = fs::file_size(csv, fec);
+            unsigned long long out = fs::file_size(gexz, fec);
+            bytesIn += in;
+            bytesOut += out;
+
+            if (!keepSource)
+            {
+                fs::path gexb = csv; gexb.replace_extension(".gexb");
+                fs::remove(csv, fec);
+                fs::remove(csv.string() + ".commit", fec);
+                fs::remove(csv.string() + ".idx", fec);
+                fs::remove(gexb, fec);
+            }
+
+            CatalogEntry entry = DescribeDayFile(jobs[j].Date, gexz);
+            entry.Rows = (long long)table.TsMs.size();
+            {
+                std::lock_guard<std::mutex> lock(logMutex);
+                archived[csv.stem().string()].push_back(entry);
+                summaries[csv.stem().string()].push_back(SummarizeTable(jobs[j].Date, table));
+            }
+            ++done;
+        }
+    };
+
+    if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; ++i) pool.emplace_back(worker);
+    for (std::thread& t : pool) t.join();
+
+    // Catalogs: the archived days now list .gexz instead of the removed sources
+    for (const auto& kv : archived)
+    {
+        fs::path catalogPath = fs::path(dataDir) / (kv.first + ".catalog");
+        CatalogLock lock(catalogPath);
+        if (!lock.Held())
+        {
+            fprintf(stderr, "Cannot lock %s, not updated (run 'catalog' later)\n", catalogPath.string().c_str());
+            continue;
+        }
+        std::vector<CatalogEntry> entries;
+        ReadCatalog(catalogPath, entries);
+        for (const CatalogEntry& a : kv.second)
+        {
+            entries.erase(std::remove_if(entries.begin(), entries.end(), [&](const CatalogEntry& e) {
+                return e.Date == a.Date && (e.Format == "gexz" || (!keepSource && (e.Format == "csv" || e.Format == "gexb")));
+            }), entries.end());
+            entries.push_back(a);
+        }
+        if (!WriteCatalog(catalogPath, entries))
+            fprintf(stderr, "Cannot update %s\n", catalogPath.string().c_str());
+    }
+
+    UpdateSummaryFiles(dataDir, summaries);
+
+    printf("Compacted %d day files (%d failed): %.1f MB -> %.1f MB\n", done.load(), failed.load(),
+        bytesIn.load() / 1048576.0, bytesOut.load() / 1048576.0);
+    return failed.load() ? 2 : 0;
+}
+
+// Rebuilds all ticker catalogs from the day folders
+int RunCatalog(const std::string& dataDir)
+{
+    std::map<std::string, std::vector<CatalogEntry>> catalogs;
+
+    std::error_code ec;
+    for (const auto& dayDir : fs::directory_iterator(dataDir, ec))
+    {
+        if (!dayDir.is_directory()) continue;
+        int ymd = ParseDayFolder(dayDir.path().filename().string());
+        if (ymd == 0) continue;
+
+        for (const auto& file : fs::directory_iterator(dayDir.path(), ec))
+        {
+            std::string ext = file.path().extension().string();
+            if (!file.is_regular_file() ||
+                (ext != ".csv" && ext != ".gexb" && ext != ".grid" && ext != ".gexz" && ext != ".db"))
+                continue;
+            catalogs[file.path().stem().string()].push_back(DescribeDayFile(ymd, file.path()));
+        }
+    }
+    if (ec)
+    {
+        fprintf(stderr, "Cannot list %s: %s\n", dataDir.c_str(), ec.message().c_str());
+        return 1;
+    }
+
+    int failed = 0;
+    for (const auto& kv : catalogs)
+    {
+        fs::path catalogPath = fs::path(dataDir) / (kv.first + ".catalog");
+        CatalogLock lock(catalogPath);
+        if (lock.Held() && WriteCatalog(catalogPath, kv.second))
+            printf("%s: %d day files\n", catalogPath.string().c_str(), (int)kv.second.size());
+        else
+        {
+            fprintf(stderr, "FAILED %s\n", catalogPath.string().c_str());
+            ++failed;
+        }
+    }
+    return failed ? 2 : 0;
+}
+
+// Rebuilds the daily summaries of every closed day still on disk (.gexz, else .csv)
+int RunSummary(const std::string& dataDir, int threads)
+{
+    struct SummaryJob
+    {
+        std::string Ticker;
+        int Date;
+        fs::path Path;
+    };
+    std::map<std::pair<std::string, int>, fs::path> sources;
+    int today = TodayYmd();
+
+    std::error_code ec;
+    for (const auto& dayDir : fs::directory_iterator(dataDir, ec))
+    {
+        if (!dayDir.is_directory()) continue;
+        int ymd = ParseDayFolder(dayDir.path().filename().string());
+        if (ymd == 0 || ymd >= today) continue;
+
+        for (const auto& file : fs::directory_iterator(dayDir.path(), ec))
+        {
+            std::string ext = file.path().extension().string();
+            if (!file.is_regular_file() || (ext != ".gexz" && ext != ".csv")) continue;
+            fs::path& source = sources[std::make_pair(file.path().stem().string(), ymd)];
+            if (source.empty() || ext == ".gexz") source = file.path();
+        }
+    }
+    if (ec)
+    {
+        fprintf(stderr, "Cannot list %s: %s\n", dataDir.c_str(), ec.message().c_str());
+        return 1;
+    }
+
+    std::vector<SummaryJob> jobs;
+    for (const auto& kv : sources)
+        jobs.push_back(SummaryJob{ kv.first.first, kv.first.second, kv.second });
+
+    std::atomic<size_t> next(0);
+    std::mutex resultMutex;
+    std::map<std::string, std::vector<DaySummary>> summaries;
+    auto worker = [&]() {
+        for (size_t j = next++; j < jobs.size(); j = next++)
+        {
+            DayTable t;
+            const fs::path& path = jobs[j].Path;
+            bool ok = (path.extension() == ".gexz") ? ReadArchive(path.string(), t) : ReadCsvDay(path.string(), t);
+            if (!ok || t.TsMs.empty()) continue;
+            DaySummary d = SummarizeTable(jobs[j].Date, t);
+            std::lock_guard<std::mutex> lock(resultMutex);
+            summaries[jobs[j].Ticker].push_back(d);
+        }
+    };
+
+    if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; ++i) pool.emplace_back(worker);
+    for (std::thread& t : pool) t.join();
+
+    int failed = UpdateSummaryFiles(dataDir, summaries);
+    for (const auto& kv : summaries)
+        printf("%s: %d days\n", kv.first.c_str(), (int)kv.second.size());
+    return failed ? 2 : 0;
+}
+
+// Exports [fromYmd, toYmd] of the selected tickers (all when empty) to <OutDir>\<Ticker>.arrow.
+// Days are read and encoded in parallel, then appended in date order.
+int RunExport(const std::string& dataDir, const std::string& outDir, const std::set<std::string>& tickers,
+    int fromYmd, int toYmd, int threads)
+{
+    // Ticker -> date -> source (a compacted .gexz, else the CSV)
+    std::map<std::string, std::map<int, fs::path>> sources;
+
+    std::error_code ec;
+    for (const auto& dayDir : fs::directory_iterator(dataDir, ec))
+    {
+        if (!dayDir.is_directory()) continue;
+        int ymd = ParseDayFolder(dayDir.path().filename().string());
+        if (ymd == 0 || ymd < fromYmd || ymd > toYmd) continue;
+
+        for (const auto& file : fs::directory_iterator(dayDir.path(), ec))
+        {
+            std::string ext = file.path().extension().string();
+            std::string ticker = file.path().stem().string();
+            if (!file.is_regular_file() || (ext != ".gexz" && ext != ".csv")) continue;
+            if (!tickers.empty() && !tickers.count(ticker)) continue;
+
+            fs::path& source = sources[ticker][ymd];
+            if (source.empty() || ext == ".gexz") source = file.path();
+        }
+    }
+    if (ec)
+    {
+        fprintf(stderr, "Cannot list %s: %s\n", dataDir.c_str(), ec.message().c_str());
+        return 1;
+    }
+
+    fs::create_directories(outDir, ec);
+    if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+
+    struct EncodedDay
+    {
+        bool Ok = false;
+        int FieldCount = 0;
+        std::string Names;
+        size_t Rows = 0;
+        std::string Metadata;
+        std::string Body;
+    };
+
+    int failed = 0;
+    for (const auto& kv : sources)
+    {
+        std::vector<std::pair<int, fs::path>> days(kv.second.begin(), kv.second.end());
+        fs::path outPath = fs::path(outDir) / (kv.first + ".arrow");
+        fs::path tmpPath = outPath.string() + ".tmp";
+        std::ofstream out;
+        unsigned long long pos = 0;
+        std::string names;
+        std::vector<std::string> fieldNames;
+        std::vector<ArrowBlock> blocks;
+        size_t totalRows = 0;
+
+        // A bounded window of days in memory at a time
+        size_t chunk = (size_t)threads * 2;
+        for (size_t first = 0; first < days.size(); first += chunk)
+        {
+            size_t count = std::min(chunk, days.size() - first);
+            std::vector<EncodedDay> encoded(count);
+            std::atomic<size_t> next(0);
+
+            auto worker = [&]() {
+                for (size_t j = next++; j < count; j = next++)
+                {
+                    const fs::path& path = days[first + j].second;
+                    DayTable t;
+                    bool ok = (path.extension() == ".gexz") ? ReadArchive(path.string(), t) : ReadCsvDay(path.string(), t);
+                    if (!ok || t.TsMs.empty()) continue;
+                    encoded[j].Ok = true;
+                    encoded[j].FieldCount = t.FieldCount;
+                    encoded[j].Names = t.Names;
+                    encoded[j].Rows = t.TsMs.size();
+                    encoded[j].Metadata = BuildArrowBatch(t, encoded[j].Body);
+                }
+            };
+            std::vector<std::thread> pool;
+            for (int i = 0; i < threads && i < (int)count; ++i) pool.emplace_back(worker);
+            for (std::thread& th : pool) th.join();
+
+            for (size_t j = 0; j < count; ++j)
+            {
+                EncodedDay& day = encoded[j];
+                if (!day.Ok) continue;
+
+                if (!out.is_open())
+                {
+                    // The first exported day fixes the schema
+                    names = day.Names;
+                    fieldNames = SplitNames(names);
+                    out.open(tmpPath, std::ios::binary | std::ios::trunc);
+                    if (!out.is_open()) break;
+                    out.write("ARROW1\0\0", 8);
+                    pos = 8;
+
+                    FlatBuilder b;
+                    std::string schema = FinishArrowMessage(b, ARROW_HEADER_SCHEMA, BuildArrowSchema(b, fieldNames), 0);
+                    WriteArrowMessage(out, pos, schema, std::string(), nullptr);
+                }
+                if (day.Names != names || day.FieldCount != (int)fieldNames.size())
+                {
+                    fprintf(stderr, "Skipped %s: column layout differs from the first exported day\n",
+                        days[first + j].second.string().c_str());
+                    continue;
+                }
+
+                ArrowBlock block;
+                WriteArrowMessage(out, pos, day.Metadata, day.Body, &block);
+                blocks.push_back(block);
+                totalRows += day.Rows;
+            }
+        }
+
+        if (!out.is_open())
+        {
+            if (!days.empty()) ++failed;
+            continue;
+        }
+
+        // End-of-stream marker, then the footer (schema again + batch locations)
+        unsigned int eos[2] = { 0xFFFFFFFFu, 0 };
+        out.write((const char*)eos, sizeof(eos));
+
+        FlatBuilder b;
+        size_t schema = BuildArrowSchema(b, fieldNames);
+        size_t batches = b.CreateStructVector(blocks.data(), blocks.size(), sizeof(ArrowBlock), 8);
+        b.BeginTable();
+        b.AddOffset(1, schema);
+        b.AddOffset(3, batches);
+        b.AddScalar<short>(0, ARROW_METADATA_V5);
+        std::string footer = b.Finish(b.EndTable());
+        int footerLength = (int)footer.size();
+        out.write(footer.data(), footer.size());
+        out.write((const char*)&footerLength, 4);
+        out.write("ARROW1", 6);
+        out.close();
+
+        std::error_code fec;
+        fs::rename(tmpPath, outPath, fec);
+        if (!out || fec)
+        {
+            fs::remove(tmpPath, fec);
+            fprintf(stderr, "FAILED %s\n", outPath.string().c_str());
+            ++failed;
+            continue;
+        }
+        printf("%s: %d days, %llu rows\n", outPath.string().c_str(), (int)blocks.size(), (unsigned long long)totalRows);
+    }
+    return failed ? 2 : 0;
+}
+
+// =========================
+//    CONVERT / VALIDATE
+// =========================
+// Every format a day can be stored in is read into a DayTable: the CSV of the
+// Collector / API study, .gexz, and the Terminal's ticker_data SQLite .db
+// (only when built with GEXBOT_SQLITE). convert merges all sources of a
+// (ticker, day) into one sorted, de-duplicated table and writes it in one
+// format; validate only reports.
+
+#define DAY_SLACK_SEC (12 * 3600)  // Folder dates are local: allow rows up to 12 h either side of the UTC day
+
+// Days since 1970-01-01 of a YYYYMMDD date
+long long YmdToUnixDay(int ymd)
+{
+    long long y = ymd / 10000, m = ymd / 100 % 100, d = ymd % 100;
+    y -= m <= 2;
+    long long era = (y >= 0 ? y : y - 399) / 400;
+    long long yoe = y - era * 400;
+    long long doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    return era * 146097 + yoe * 365 + yoe / 4 - yoe / 100 + doy - 719468;
+}
+
+std::string DayFolderName(int ymd)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "Tickers %02d.%02d.%04d", ymd / 100 % 100, ymd % 100, ymd / 10000);
+    return name;
+}
+
+// Checks a sorted table against its folder date
+void CheckTable(int ymd, const DayTable& t, DayCheck& c)
+{
+    long long dayStartMs = (YmdToUnixDay(ymd) * 86400LL - DAY_SLACK_SEC) * 1000LL;
+    long long dayEndMs = ((YmdToUnixDay(ymd) + 1) * 86400LL + DAY_SLACK_SEC) * 1000LL;
+    std::vector<std::string> names = SplitNames(t.Names);
+    int zeroField = (int)(std::find(names.begin(), names.end(), "zero_gamma") - names.begin());
+
+    c.Rows += t.TsMs.size();
+    for (size_t r = 0; r < t.TsMs.size(); ++r)
+    {
+        if (r > 0 && t.TsMs[r] == t.TsMs[r - 1]) ++c.Duplicates;
+        if (t.TsMs[r] < dayStartMs || t.TsMs[r] >= dayEndMs) ++c.OutOfDay;
+
+        const float* row = &t.Values[r * t.FieldCount];
+        bool bad = false;
+        for (int f = 0; f < t.FieldCount; ++f) bad |= !std::isfinite(row[f]);
+        if (bad) ++c.BadValues;
+        if (zeroField < t.FieldCount && row[zeroField] == 0) ++c.ZeroRows;
+    }
+}
+
+// Written back exactly: %.9g round-trips every float, and timestamps keep the
+// writers' one decimal unless a row carries finer milliseconds.
+bool WriteCsvDay(const std::string& path, const DayTable& t)
+{
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        out << "timestamp," << t.Names << "\r\n";
+        char field[64];
+        std::string line;
+        for (size_t r = 0; r < t.TsMs.size(); ++r)
+        {
+            snprintf(field, sizeof(field), t.TsMs[r] % 100 == 0 ? "%.1f" : "%.3f", t.TsMs[r] / 1000.0);
+            line = field;
+            for (int f = 0; f < t.FieldCount; ++f)
+            {
+                snprintf(field, sizeof(field), ",%.9g", t.Values[r * t.FieldCount + f]);
+                line += field;
+            }
+            line += "\r\n";
+            out << line;
+        }
+        if (!out.good()) { out.close(); fs::remove(tmpPath); return false; }
+    }
+
+    std::error_code ec;
+    fs::rename(tmpPath, path, ec);
+    if (ec) { fs::remove(tmpPath, ec); return false; }
+    return true;
+}
+
+#ifdef GEXBOT_SQLITE
+// ticker_data columns (same names and order as the CSV written by the studies)
+static const char* DB_COLUMNS = "spot,zero_gamma,major_pos_vol,major_neg_vol,major_pos_oi,major_neg_oi,"
+    "sum_gex_vol,sum_gex_oi,delta_risk_reversal,major_long_gamma,major_short_gamma,major_positive,major_negative,net";
+#define DB_FIELD_COUNT 14
+
+// Terminal day database. Rows come back in insertion order, so ordering can be checked.
+bool ReadDbDay(const std::string& path, DayTable& t, DayCheck* check = nullptr)
+{
+    sqlite3* db = nullptr;
+    if (sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK)
+    {
+        sqlite3_close(db);
+        return false;
+    }
+
+    std::string query = "SELECT timestamp";
+    for (const std::string& c : SplitNames(DB_COLUMNS)) query += ",COALESCE(" + c + ",0)";
+    query += " FROM ticker_data ORDER BY rowid;";
+
+    sqlite3_stmt* st = nullptr;
+    bool ok = sqlite3_prepare_v2(db, query.c_str(), -1, &st, nullptr) == SQLITE_OK;
+    if (ok)
+    {
+        t.Names = DB_COLUMNS;
+        t.FieldCount = DB_FIELD_COUNT;
+        while (sqlite3_step(st) == SQLITE_ROW)
+        {
+            double ts = sqlite3_column_double(st, 0);
+            if (ts <= 0)
+            {
+                if (check) ++check->BadLines;
+                continue;
+            }
+            long long tsMs = (long long)(ts * 1000.0 + 0.5);
+            if (check && !t.TsMs.empty() && tsMs < t.TsMs.back()) ++check->Unordered;
+            t.TsMs.push_back(tsMs);
+            for (int f = 0; f < DB_FIELD_COUNT; ++f)
+                t.Values.push_back((float)sqlite3_column_double(st, f + 1));
+        }
+    }
+    sqlite3_finalize(st);
+    sqlite3_close(db);
+
+    if (ok) SortTable(t);
+    return ok;
+}
+
+// Same schema as the Terminal study; columns the table does not have are written as 0 (not available)
+bool WriteDbDay(const std::string& path, const DayTable& t)
+{
+    std::vector<std::string> names = SplitNames(t.Names);
+    std::vector<std::string> columns = SplitNames(DB_COLUMNS);
+    std::vector<int> source(columns.size());
+    for (size_t c = 0; c < columns.size(); ++c)
+        source[c] = (int)(std::find(names.begin(), names.end(), columns[c]) - names.begin());
+
+    std::string tmpPath = path + ".tmp";
+    std::error_code ec;
+    fs::remove(tmpPath, ec);
+
+    sqlite3* db = nullptr;
+    if (sqlite3_open(tmpPath.c_str(), &db) != SQLITE_OK)
+    {
+        sqlite3_close(db);
+        return false;
+    }
+
+    std::string create = "CREATE TABLE ticker_data (timestamp REAL PRIMARY KEY";
+    std::string insert = "INSERT OR REPLACE INTO ticker_data (timestamp";
+    std::string params = "?";
+    for (const std::string& c : columns)
+    {
+        create += "," + c + " REAL";
+        insert += "," + c;
+        params += ",?";
+    }
+    create += ");";
+    insert += ") VALUES (" + params + ");";
+
+    sqlite3_stmt* st = nullptr;
+    bool ok = sqlite3_exec(db, create.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK &&
+        sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr) == SQLITE_OK &&
+        sqlite3_prepare_v2(db, insert.c_str(), -1, &st, nullptr) == SQLITE_OK;
+    for (size_t r = 0; ok && r < t.TsMs.size(); ++r)
+    {
+        sqlite3_bind_double(st, 1, t.TsMs[r] / 1000.0);
+        for (size_t c = 0; c < columns.size(); ++c)
+            sqlite3_bind_double(st, (int)c + 2, source[c] < t.FieldCount ? t.Values[r * t.FieldCount + source[c]] : 0.0);
+        ok = sqlite3_step(st) == SQLITE_DONE;
+        sqlite3_reset(st);
+    }
+    sqlite3_finalize(st);
+    ok = ok && sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr) == SQLITE_OK;
+    sqlite3_close(db);
+
+    if (ok) fs::rename(tmpPath, path, ec);
+    if (!ok || ec) { fs::remove(tmpPath, ec); return false; }
+    return true;
+}
+#endif
+
+bool ReadDaySource(const fs::path& path, DayTable& t, DayCheck* check)
+{
+    std::string ext = path.extension().string();
+    if (ext == ".gexz") return ReadArchive(path.string(), t); // Written sorted and de-duplicated
+    if (ext == ".csv") return ReadCsvDay(path.string(), t, check);
+#ifdef GEXBOT_SQLITE
+    if (ext == ".db") return ReadDbDay(path.string(), t, check);
+#endif
+    return false;
+}
+
+// Union of the sources by timestamp, columns matched by name. Per field the
+// first source (priority order) with a usable non-zero value wins, so a CSV
+// with zeroed columns is completed from another source that has them.
+DayTable MergeTables(const std::vector<DayTable>& sources)
+{
+    std::vector<std::string> names;
+    std::vector<std::vector<int>> columns(sources.size()); // Source field -> merged field
+    for (size_t s = 0; s < sources.size(); ++s)
+    {
+        std::vector<std::string> sourceNames = SplitNames(sources[s].Names);
+        sourceNames.resize(sources[s].FieldCount);
+        for (const std::string& n : sourceNames)
+        {
+            size_t f = std::find(names.begin(), names.end(), n) - names.begin();
+            if (f == names.size()) names.push_back(n);
+            columns[s].push_back((int)f);
+        }
+    }
+
+    int fieldCount = (int)names.size();
+    std::map<long long, size_t> rows; // Timestamp -> row in 'values'
+    std::vector<float> values;
+    for (size_t s = 0; s < sources.size(); ++s)
+    {
+        const DayTable& t = sources[s];
+        for (size_t r = 0; r < t.TsMs.size(); ++r)
+        {
+            auto it = rows.emplace(t.TsMs[r], rows.size()).first;
+            if (values.size() < rows.size() * fieldCount) values.resize(rows.size() * fieldCount, 0.0f);
+            float* dst = &values[it->second * fieldCount];
+            for (int f = 0; f < t.FieldCount; ++f)
+            {
+                float v = t.Values[r * t.FieldCount + f];
+                float& d = dst[columns[s][f]];
+                if (d == 0 && v != 0 && std::isfinite(v)) d = v;
+            }
+        }
+    }
+
+    DayTable m;
+    m.FieldCount = fieldCount;
+    for (int f = 0; f < fieldCount; ++f) m.Names += (f ? "," : "") + names[f];
+    m.TsMs.reserve(rows.size());
+    m.Values.reserve(values.size());
+    for (const auto& kv : rows)
+    {
+        m.TsMs.push_back(kv.first);
+        m.Values.insert(m.Values.end(), values.begin() + kv.second * fieldCount, values.begin() + (kv.second + 1) * fieldCount);
+    }
+    return m;
+}
+
+struct DayJob
+{
+    std::string Ticker;
+    int Date;
+    std::vector<fs::path> Sources;  // Priority order: .gexz, .csv, .db
+    unsigned long long Bytes;
+};
+
+// One job per (ticker, day), largest first so the last jobs to finish are small
+bool CollectDayJobs(const std::string& dataDir, const std::set<std::string>& tickers, int fromYmd, int toYmd,
+    std::vector<DayJob>& jobs)
+{
+    static const char* formats[] = { ".gexz", ".csv", ".db" };
+    std::map<std::pair<std::string, int>, DayJob> days;
+    int skippedDb = 0;
+
+    std::error_code ec;
+    for (const auto& dayDir : fs::directory_iterator(dataDir, ec))
+    {
+        if (!dayDir.is_directory()) continue;
+        int ymd = ParseDayFolder(dayDir.path().filename().string());
+        if (ymd == 0 || ymd < fromYmd || ymd > toYmd) continue;
+
+        for (const auto& file : fs::directory_iterator(dayDir.path(), ec))
+        {
+            std::string ext = file.path().extension().string();
+            std::string ticker = file.path().stem().string();
+            if (!file.is_regular_file() || (ext != ".gexz" && ext != ".csv" && ext != ".db")) continue;
+            if (!tickers.empty() && !tickers.count(ticker)) continue;
+#ifndef GEXBOT_SQLITE
+            if (ext == ".db") { ++skippedDb; continue; }
+#endif
+            DayJob& job = days[std::make_pair(ticker, ymd)];
+            job.Ticker = ticker;
+            job.Date = ymd;
+            job.Sources.push_back(file.path());
+        }
+    }
+    if (ec)
+    {
+        fprintf(stderr, "Cannot list %s: %s\n", dataDir.c_str(), ec.message().c_str());
+        return false;
+    }
+    if (skippedDb)
+        fprintf(stderr, "Skipped %d .db files (build with -DGEXBOT_SQLITE to read them)\n", skippedDb);
+
+    for (auto& kv : days)
+    {
+        DayJob& job = kv.second;
+        std::sort(job.Sources.begin(), job.Sources.end(), [](const fs::path& a, const fs::path& b) {
+            auto rank = [](const fs::path& p) {
+                return (int)(std::find(std::begin(formats), std::end(formats), p.extension().string()) - std::begin(formats));
+            };
+            return rank(a) < rank(b);
+        });
+        job.Bytes = 0;
+        for (const fs::path& p : job.Sources)
+        {
+            std::error_code fec;
+            job.Bytes += fs::file_size(p, fec);
+        }
+        jobs.push_back(job);
+    }
+    std::sort(jobs.begin(), jobs.end(), [](const DayJob& a, const DayJob& b) { return a.Bytes > b.Bytes; });
+    return true;
+}
+
+double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Reads every source file of the selected days and reports what is wrong with it
+int RunValidate(const std::string& dataDir, const std::set<std::string>& tickers, int fromYmd, int toYmd, int threads)
+{
+    std::vector<DayJob> jobs;
+    if (!CollectDayJobs(dataDir, tickers, fromYmd, toYmd, jobs)) return 1;
+
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> next(0);
+    std::atomic<int> files(0), failedFiles(0);
+    std::atomic<unsigned long long> rows(0), overlapping(0), zeroRows(0);
+    std::mutex logMutex;
+
+    auto worker = [&]() {
+        for (size_t j = next++; j < jobs.size(); j = next++)
+        {
+            const DayJob& job = jobs[j];
+            std::vector<long long> allTs; // Distinct timestamps of each source, concatenated
+            for (const fs::path& path : job.Sources)
+            {
+                DayTable t;
+                DayCheck c;
+                bool ok = ReadDaySource(path, t, &c);
+                if (ok) CheckTable(job.Date, t, c);
+                ++files;
+                rows += c.Rows;
+                zeroRows += c.ZeroRows;
+
+                if (!ok || c.Failed())
+                {
+                    ++failedFiles;
+                    std::lock_guard<std::mutex> lock(logMutex);
+                    if (!ok)
+                        fprintf(stderr, "UNREADABLE %s\n", path.string().c_str());
+                    else
+                        fprintf(stderr, "%s: %llu rows, %llu bad lines, %llu out of order, %llu duplicates, %llu outside the day, %llu with NaN/inf\n",
+                            path.string().c_str(), c.Rows, c.BadLines, c.Unordered, c.Duplicates, c.OutOfDay, c.BadValues);
+                }
+                for (size_t r = 0; r < t.TsMs.size(); ++r)
+                    if (r == 0 || t.TsMs[r] != t.TsMs[r - 1]) allTs.push_back(t.TsMs[r]);
+            }
+
+            // Rows present in more than one source of the same day (convert keeps one)
+            std::sort(allTs.begin(), allTs.end());
+            for (size_t i = 1; i < allTs.size(); ++i)
+                if (allTs[i] == allTs[i - 1]) ++overlapping;
+        }
+    };
+
+    if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; ++i) pool.emplace_back(worker);
+    for (std::thread& t : pool) t.join();
+
+    double seconds = SecondsSince(start);
+    printf("Checked %d files (%d days): %llu rows, %llu overlapping between sources, %llu without zero_gamma\n",
+        files.load(), (int)jobs.size(), rows.load(), overlapping.load(), zeroRows.load());
+    printf("%d files with errors; %.1f s (%.0f rows/s)\n", failedFiles.load(), seconds, seconds > 0 ? rows.load() / seconds : 0.0);
+    return failedFiles.load() ? 2 : 0;
+}
+
+// Merges the sources of each selected day and writes <OutDir>\Tickers MM.DD.YYYY\<Ticker>.<format>
+int RunConvert(const std::string& dataDir, const std::string& outDir, const std::string& format,
+    const std::set<std::string>& tickers, int fromYmd, int toYmd, int threads)
+{
+#ifndef GEXBOT_SQLITE
+    if (format == "db")
+    {
+        fprintf(stderr, "Writing .db needs a build with -DGEXBOT_SQLITE\n");
+        return 1;
+    }
+#endif
+    if (format != "csv" && format != "gexz" && format != "db")
+    {
+        fprintf(stderr, "Unknown format '%s' (csv, gexz, db)\n", format.c_str());
+        return 1;
+    }
+
+    std::vector<DayJob> jobs;
+    if (!CollectDayJobs(dataDir, tickers, fromYmd, toYmd, jobs)) return 1;
+
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> next(0);
+    std::atomic<int> done(0), failed(0);
+    std::atomic<unsigned long long> rowsIn(0), rowsOut(0);
+    std::mutex logMutex;
+    std::map<std::string, std::vector<CatalogEntry>> written; // Ticker -> catalog entries in OutDir
+
+    auto worker = [&]() {
+        for (size_t j = next++; j < jobs.size(); j = next++)
+        {
+            const DayJob& job = jobs[j];
+            std::vector<DayTable> tables;
+            for (const fs::path& path : job.Sources)
+            {
+                DayTable t;
+                if (!ReadDaySource(path, t, nullptr))
+                {
+                    std::lock_guard<std::mutex> lock(logMutex);
+                    fprintf(stderr, "UNREADABLE %s\n", path.string().c_str());
+                    continue;
+                }
+                rowsIn += t.TsMs.size();
+                tables.push_back(std::move(t));
+            }
+            DayTable merged = MergeTables(tables);
+            if (merged.TsMs.empty()) continue;
+
+            fs::path dayDir = fs::path(outDir) / DayFolderName(job.Date);
+            fs::path outPath = dayDir / (job.Ticker + "." + format);
+            std::error_code ec;
+            fs::create_directories(dayDir, ec);
+
+            bool ok;
+            if (format == "gexz") ok = WriteArchive(outPath.string(), merged);
+#ifdef GEXBOT_SQLITE
+            else if (format == "db") ok = WriteDbDay(outPath.string(), merged);
+#endif
+            else
+            {
+                ok = WriteCsvDay(outPath.string(), merged);
+                // Sidecars of a CSV that was just replaced no longer describe it
+                fs::path gexb = outPath; gexb.replace_extension(".gexb");
+                fs::remove(outPath.string() + ".commit", ec);
+                fs::remove(outPath.string() + ".idx", ec);
+                fs::remove(gexb, ec);
+            }
+
+            if (!ok)
+            {
+                ++failed;
+                std::lock_guard<std::mutex> lock(logMutex);
+                fprintf(stderr, "FAILED %s\n", outPath.string().c_str());
+                continue;
+            }
+            rowsOut += merged.TsMs.size();
+            ++done;
+
+            CatalogEntry entry = DescribeDayFile(job.Date, outPath);
+            entry.Rows = (long long)merged.TsMs.size();
+            entry.MinTs = merged.TsMs.front() / 1000.0;
+            entry.MaxTs = merged.TsMs.back() / 1000.0;
+            std::lock_guard<std::mutex> lock(logMutex);
+            written[job.Ticker].push_back(entry);
+        }
+    };
+
+    if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; ++i) pool.emplace_back(worker);
+    for (std::thread& t : pool) t.join();
+
+    // OutDir catalogs list the written files (and drop a .gexb twin removed next to a rewritten CSV)
+    for (const auto& kv : written)
+    {
+        fs::path catalogPath = fs::path(outDir) / (kv.first + ".catalog");
+        CatalogLock lock(catalogPath);
+        if (!lock.Held())
+        {
+            fprintf(stderr, "Cannot lock %s, not updated (run 'catalog' later)\n", catalogPath.string().c_str());
+            continue;
+        }
+        std::vector<CatalogEntry> entries;
+        ReadCatalog(catalogPath, entries);
+        for (const CatalogEntry& w : kv.second)
+        {
+            entries.erase(std::remove_if(entries.begin(), entries.end(), [&](const CatalogEntry& e) {
+                return e.Date == w.Date && (e.Format == w.Format || (w.Format == "csv" && e.Format == "gexb"));
+            }), entries.end());
+            entries.push_back(w);
+        }
+        if (!WriteCatalog(catalogPath, entries))
+            fprintf(stderr, "Cannot update %s\n", catalogPath.string().c_str());
+    }
+
+    double seconds = SecondsSince(start);
+    printf("Converted %d days to .%s (%d failed): %llu rows read, %llu written; %.1f s (%.0f rows/s)\n",
+        done.load(), format.c_str(), failed.load(), rowsIn.load(), rowsOut.load(), seconds,
+        seconds > 0 ? rowsIn.load() / seconds : 0.0);
+    return failed.load() ? 2 : 0;
+}
+
+// =========================
+//          MAIN
+// =========================
+
+void PrintUsage()
+{
+    printf("GexBot Archive Tool v" ARCHIVE_TOOL_VERSION "\n"
+           "  compact <DataDir> [--threads N] [--keep-source]\n"
+           "  catalog <DataDir>\n"
+           "  summary <DataDir> [--threads N]\n"
+           "  export <DataDir> <OutDir> [--tickers A,B] [--from YYYYMMDD] [--to YYYYMMDD] [--threads N]\n"
+           "  convert <DataDir> <OutDir> --format csv|gexz|db [--tickers A,B] [--from YYYYMMDD] [--to YYYYMMDD] [--threads N]\n"
+           "  validate <DataDir> [--tickers A,B] [--from YYYYMMDD] [--to YYYYMMDD] [--threads N]\n");
+}
+
+#ifndef GEXBOT_ARCHIVE_TOOL_NO_MAIN   // Defined by tests/CsvReaderTest.cpp, which includes this file
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string command = argv[1];
+    std::string dataDir = argv[2];
+    int threads = 0;
+    bool keepSource = false;
+    std::set<std::string> tickers;
+    int fromYmd = 0, toYmd = INT_MAX;
+    std::string format;
+    for (int i = 3; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (arg == "--keep-source") keepSource = true;
+        else if (arg == "--from" && i + 1 < argc) fromYmd = atoi(argv[++i]);
+        else if (arg == "--to" && i + 1 < argc) toYmd = atoi(argv[++i]);
+        else if (arg == "--format" && i + 1 < argc) format = argv[++i];
+        else if (arg == "--tickers" && i + 1 < argc)
+            for (const std::string& t : SplitNames(argv[++i])) tickers.insert(t);
+    }
+
+    if (command == "compact")
+        return RunCompact(dataDir, threads, keepSource);
+    if (command == "catalog")
+        return RunCatalog(dataDir);
+    if (command == "summary")
+        return RunSummary(dataDir, threads);
+    if (command == "export" && argc >= 4 && argv[3][0] != '-')
+        return RunExport(dataDir, argv[3], tickers, fromYmd, toYmd, threads);
+    if (command == "convert" && argc >= 4 && argv[3][0] != '-' && !format.empty())
+        return RunConvert(dataDir, argv[3], format, tickers, fromYmd, toYmd, threads);
+    if (command == "validate")
+        return RunValidate(dataDir, tickers, fromYmd, toYmd, threads);
+
+    PrintUsage();
+    return 1;
+}
+#endif
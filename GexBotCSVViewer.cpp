@@ -1,5 +1,6 @@
 #include "sierrachart.h"
 #include <map>
+#include <set>
 #include <vector>
 #include <string>
 #include <sstream>
@@ -7,251 +8,2098 @@
 #include <iomanip>
 #include <cmath>
 #include <cfloat>
+#include <limits>
+#include <climits>
+#include <algorithm>
+#include <charconv>
+#include <atomic>
+#include <thread>
+#include <chrono>
 
 SCDLLName("GEX_CSV_VIEWER")
 
-#define VIEWER_VERSION "2.1.0"  // 2026-02-12: Auto TZ, full-bar render, Net OI
+#define VIEWER_VERSION "2.10.8"  // 2026-10-18: Keep UpdateAlways on until the pager has covered the visible range
 
 // =========================
 //        STRUCTURES
 // =========================
 
+// One wall-clock grid day file (see GexBotDataCollector.cpp). Slot k is the
+// sample at SessionOpenUnix + k * StrideSec; values are forward-filled on load
+// so a bar lookup is a single array index.
+struct GridDay
+{
+    long long SessionOpenUnix = 0;
+    int StrideSec = 0;
+    int FieldCount = 0;
+    int LoadedSlots = 0;
+    unsigned long long FileId = 0; // Replaced file (backfill) -> reload from slot 0
+    std::vector<float> Values;    // LoadedSlots * FieldCount, NaN = no sample yet
+};
+
+// Grid field order = CSV columns after the timestamp
+enum GridField
+{
+    GF_SPOT = 0, GF_ZERO, GF_POS_VOL, GF_NEG_VOL, GF_POS_OI, GF_NEG_OI, GF_NET_VOL, GF_NET_OI,
+    GF_DELTA_RR, GF_LONG, GF_SHORT, GF_MAJ_POS, GF_MAJ_NEG, GF_NET,
+    GF_PACKAGE      // Extra package k field f at GF_PACKAGE + k * PACKAGE_FIELDS + f (rows are FieldCount wide)
+};
+
+// One line of "<Ticker>.summary" (see DAILY SUMMARY below)
+struct DaySummary
+{
+    int Date;                   // YYYYMMDD of the "Tickers MM.DD.YYYY" folder
+    long long Rows;
+    double ZeroOpen, ZeroHigh, ZeroLow, ZeroClose;
+    double SpotOpen, SpotHigh, SpotLow, SpotClose;
+    double PosVolClose, NegVolClose, PosOiClose, NegOiClose;
+    int PosVolMoves, NegVolMoves;
+    int SecAboveZero, SecBelowZero;
+};
+
+// Extra source packages (see GexBotDataCollector.cpp): "<label>.<field>" blocks after the 15 base columns
+#define PACKAGE_FIELDS      7
+#define VIEWER_MAX_PACKAGES 3
+#define PACKAGE_SUBGRAPH    13  // SG14: package k field f is subgraph PACKAGE_SUBGRAPH + k * PACKAGE_FIELDS + f
+
+// Series kept per timestamp, in snapshot order (see WARM-START CACHE). Package k
+// field f (PACKAGE_FIELD_NAMES order) is series VS_PACKAGE + k * PACKAGE_FIELDS + f.
+enum ViewerSeries
+{
+    VS_ZERO = 0, VS_POS_VOL, VS_NEG_VOL, VS_POS_OI, VS_NEG_OI, VS_NET_VOL, VS_NET_OI,
+    VS_LONG, VS_SHORT, VS_MAJ_POS, VS_MAJ_NEG, VS_PACKAGE,
+    VS_COUNT = VS_PACKAGE + VIEWER_MAX_PACKAGES * PACKAGE_FIELDS
+};
+
+// History as one sorted timestamp vector and a float column per series. A
+// series missing from a row is forward-filled on insert from its last value
+// on the same date (NaN = none yet that day), so a single binary search
+// serves every series at a bar. Rows older than the last one (paged-in days,
+// overlapping pieces) wait in Pending until Flush merges them in. A column is
+// only allocated once its series has a value (files without packages pay
+// nothing for the package series).
+struct SeriesStore
+{
+    static const size_t NONE = (size_t)-1;
+
+    std::vector<double> Times;                  // SCDateTime values, ascending, unique
+    std::vector<float> Columns[VS_COUNT];       // Times.size() each when active, empty otherwise
+    std::vector<unsigned int> Observed;         // Bit s: series s came with the row (not filled)
+    unsigned int Active;                        // Bit s: Columns[s] is allocated
+
+    struct Row { double Time; float Values[VS_COUNT]; };
+    std::vector<Row> Pending;                   // Out-of-order rows, in arrival order
+    size_t Last[VS_COUNT];                      // Row of each series' latest value, NONE = none
+    double ChangedFrom;                         // Earliest time whose rows moved since the study last drew, DBL_MAX = none
+
+    SeriesStore() { Clear(); }
+
+    size_t Size() const { return Times.size() + Pending.size(); }
+    bool Empty() const { return Size() == 0; }
+    bool IsActive(int s) const { return (Active & (1u << s)) != 0; }
+
+    // Memory held by the rows, for the history budget
+    size_t Bytes() const
+    {
+        size_t columns = 0;
+        for (int s = 0; s < VS_COUNT; ++s) columns += IsActive(s);
+        return Times.size() * (sizeof(double) + sizeof(unsigned int) + columns * sizeof(float)) + Pending.size() * sizeof(Row);
+    }
+
+    // Cell of series s at row (NaN = no value)
+    float Value(size_t row, int s) const { return IsActive(s) ? Columns[s][row] : NAN; }
+
+    void Clear()
+    {
+        Times.clear();
+        Observed.clear();
+        Pending.clear();
+        Active = 0;
+        for (int s = 0; s < VS_COUNT; ++s) { Columns[s].clear(); Last[s] = NONE; }
+        ChangedFrom = -DBL_MAX;                 // Everything
+    }
+
+    // Allocates series s for the rows held so far (no value in any of them)
+    void Activate(int s)
+    {
+        if (IsActive(s)) return;
+        Columns[s].assign(Times.size(), NAN);
+        Active |= 1u << s;
+    }
+
+    // A value carries over to a later row of the same date only (see GetValue)
+    static bool Fills(double source, double t) { return SCDateTime(source).GetDate() == SCDateTime(t).GetDate(); }
+
+    // values: one per series, NaN = not in this row. A row at an existing time
+    // overwrites the series it carries and keeps the others.
+    void Add(double t, const float* values)
+    {
+        ChangedFrom = std::min(ChangedFrom, t);
+        if (!Pending.empty() || (!Times.empty() && t < Times.back()))
+        {
+            Row row;
+            row.Time = t;
+            memcpy(row.Values, values, sizeof(row.Values));
+            Pending.push_back(row);
+            return;
+        }
+        for (int s = 0; s < VS_COUNT; ++s)
+            if (!std::isnan(values[s])) Activate(s);
+        if (Times.empty() || t > Times.back())
+        {
+            Times.push_back(t);
+            Observed.push_back(0);
+            for (int s = 0; s < VS_COUNT; ++s)
+                if (IsActive(s)) Columns[s].push_back(NAN);
+        }
+        size_t r = Times.size() - 1;
+        for (int s = 0; s < VS_COUNT; ++s)
+        {
+            if (!IsActive(s)) continue;
+            if (!std::isnan(values[s])) { Columns[s][r] = values[s]; Observed[r] |= 1u << s; Last[s] = r; }
+            else if (!(Observed[r] & (1u << s)))
+                Columns[s][r] = (Last[s] != NONE && Fills(Times[Last[s]], t)) ? Columns[s][Last[s]] : NAN;
+        }
+    }
+
+    // The values row r was stored with (filled cells as NaN), for re-adding it
+    void ObservedRow(size_t r, float* values) const
+    {
+        for (int s = 0; s < VS_COUNT; ++s) values[s] = (Observed[r] & (1u << s)) ? Columns[s][r] : NAN;
+    }
+
+    // Merges Pending into the sorted rows; only the rows from the oldest pending one on are rebuilt
+    void Flush()
+    {
+        if (Pending.empty()) return;
+        std::stable_sort(Pending.begin(), Pending.end(), [](const Row& a, const Row& b) { return a.Time < b.Time; });
+        size_t from = std::lower_bound(Times.begin(), Times.end(), Pending.front().Time) - Times.begin();
+
+        std::vector<Row> pending;
+        pending.swap(Pending);
+        SeriesStore tail;
+        float values[VS_COUNT];
+        size_t i = from, j = 0;
+        while (i < Times.size() || j < pending.size())
+        {
+            // Equal times: the stored row first, so the pending one overwrites it
+            if (j == pending.size() || (i < Times.size() && Times[i] <= pending[j].Time))
+            {
+                ObservedRow(i, values);
+                tail.Add(Times[i++], values);
+            }
+            else
+            {
+                tail.Add(pending[j].Time, pending[j].Values);
+                ++j;
+            }
+        }
+        Truncate(from);
+        Append(tail);
+        Refill(from);
+    }
+
+    // Moves other's rows in (other is left empty)
+    void MergeFrom(SeriesStore& other)
+    {
+        other.Flush();
+        Flush();
+        if (other.Times.empty()) return;
+        double changedFrom = std::min(ChangedFrom, other.Times.front());
+        if (Times.empty())
+        {
+            *this = std::move(other);
+        }
+        else if (other.Times.front() > Times.back())
+        {
+            // Chunks merged in time order: a plain append
+            size_t from = Times.size();
+            Append(other);
+            Refill(from);
+        }
+        else
+        {
+            float values[VS_COUNT];
+            for (size_t k = 0; k < other.Times.size(); ++k)
+            {
+                other.ObservedRow(k, values);
+                Add(other.Times[k], values);
+            }
+            Flush();
+        }
+        ChangedFrom = changedFrom;
+        other.Clear();
+    }
+
+    // Drops the rows in [from, to)
+    void Erase(double from, double to)
+    {
+        Flush();
+        size_t a = std::lower_bound(Times.begin(), Times.end(), from) - Times.begin();
+        size_t b = std::lower_bound(Times.begin(), Times.end(), to) - Times.begin();
+        if (a == b) return;
+        ChangedFrom = std::min(ChangedFrom, from);
+        Times.erase(Times.begin() + a, Times.begin() + b);
+        Observed.erase(Observed.begin() + a, Observed.begin() + b);
+        for (int s = 0; s < VS_COUNT; ++s)
+            if (IsActive(s)) Columns[s].erase(Columns[s].begin() + a, Columns[s].begin() + b);
+        Refill(a);
+    }
+
+    // Row of the last time <= t, NONE before the first one. Bars are visited in
+    // increasing time: cursor (rows <= the previous t, 0 to start) walks forward
+    // from there, so a full recalculation costs O(bars + rows) instead of a
+    // search per bar; a t before the previous one searches again.
+    size_t Seek(double t, size_t& cursor) const
+    {
+        if (cursor > Times.size() || (cursor > 0 && Times[cursor - 1] > t))
+            cursor = std::upper_bound(Times.begin(), Times.end(), t) - Times.begin();
+        while (cursor < Times.size() && Times[cursor] <= t) ++cursor;
+        return cursor == 0 ? NONE : cursor - 1;
+    }
+
+    void Truncate(size_t rows)
+    {
+        Times.resize(rows);
+        Observed.resize(rows);
+        for (int s = 0; s < VS_COUNT; ++s)
+            if (IsActive(s)) Columns[s].resize(rows);
+    }
+
+    void Append(const SeriesStore& other)
+    {
+        for (int s = 0; s < VS_COUNT; ++s)
+            if (other.IsActive(s)) Activate(s);
+        Times.insert(Times.end(), other.Times.begin(), other.Times.end());
+        Observed.insert(Observed.end(), other.Observed.begin(), other.Observed.end());
+        for (int s = 0; s < VS_COUNT; ++s)
+        {
+            if (!IsActive(s)) continue;
+            if (other.IsActive(s)) Columns[s].insert(Columns[s].end(), other.Columns[s].begin(), other.Columns[s].end());
+            else Columns[s].resize(Times.size(), NAN);
+        }
+    }
+
+    // Recomputes the filled cells from row `from` on, and Last
+    void Refill(size_t from)
+    {
+        for (int s = 0; s < VS_COUNT; ++s)
+        {
+            if (!IsActive(s)) { Last[s] = NONE; continue; }
+
+            // Source of row from - 1: back over its filled run to the observed row (a NaN = none)
+            size_t src = from;
+            while (src > 0 && !(Observed[src - 1] & (1u << s)) && !std::isnan(Columns[s][src - 1])) --src;
+            Last[s] = (src > 0 && (Observed[src - 1] & (1u << s))) ? src - 1 : NONE;
+
+            for (size_t r = from; r < Times.size(); ++r)
+            {
+                if (Observed[r] & (1u << s)) Last[s] = r;
+                else Columns[s][r] = (Last[s] != NONE && Fills(Times[Last[s]], Times[r])) ? Columns[s][Last[s]] : NAN;
+            }
+        }
+    }
+};
+
+// Chart times of the first and last row read from one file (From > To = none yet)
+struct LoadedSpan
+{
+    double From = DBL_MAX;
+    double To = -DBL_MAX;
+
+    void Widen(double t) { From = std::min(From, t); To = std::max(To, t); }
+    void Widen(const LoadedSpan& other) { From = std::min(From, other.From); To = std::max(To, other.To); }
+};
+
+// Formats of each day in the ticker's catalog (see DAY CATALOG), kept between refreshes
+struct DayCatalog
+{
+    std::string Path;
+    unsigned long long Size = 0;        // Of the file when read, with WriteTime: read again when either changes
+    unsigned long long WriteTime = 0;
+    std::map<int, std::set<std::string>> Days;
+
+    // Between the first and the last day listed, the catalog speaks for every day
+    bool Covers(int ymd) const { return !Days.empty() && ymd >= Days.begin()->first && ymd <= Days.rbegin()->first; }
+
+    bool Lists(int ymd, const char* format) const
+    {
+        auto day = Days.find(ymd);
+        return day != Days.end() && day->second.count(format) > 0;
+    }
+};
+
 struct ViewerData
 {
-    // Historical maps
-    std::map<SCDateTime, float> zeroMap;
-    std::map<SCDateTime, float> posVolMap;
-    std::map<SCDateTime, float> negVolMap;
-    std::map<SCDateTime, float> posOiMap;
-    std::map<SCDateTime, float> negOiMap;
-    std::map<SCDateTime, float> netVolMap;
-    std::map<SCDateTime, float> netOiMap;
-    std::map<SCDateTime, float> longMap;
-    std::map<SCDateTime, float> shortMap;
-    std::map<SCDateTime, float> majPosMap;
-    std::map<SCDateTime, float> majNegMap;
+    // History of every series (not the grid days, see GridDays)
+    SeriesStore Series;
     
     // Cache State
     std::string LastBasePath;
     std::string LastTicker;
     int LastDaysCount = -1;
+    int LastTzOffset = 99;
+    unsigned int LastFieldMask = 0; // Base columns feeding a visible subgraph (see GetViewerFieldMask)
     SCDateTime LastUpdate;
+    int VisibleDay = -1;            // Day (0 = today) of the first visible bar at the last load, -1 = nothing loaded yet
+    int FirstUnreadDay = -1;        // Nearest closed day with a file not read, paged out or queued yet, -1 = none
+    size_t BarCursor = 0;           // Series.Seek position of the last bar drawn
+    double GridChangedFrom = DBL_MAX; // Chart time of the first grid slot read since the study last drew
+
+    // Time-budgeted loading (see LOAD BUDGET): a read stopped at the deadline, in which file and how far
+    bool LoadPending = false;
+    std::string LoadingPath;
+    int LoadingPercent = 0;
+    std::string ShownProgress;      // Text of the progress drawing on the chart ("" = none)
+
+    // Warm-start snapshot (see WARM-START CACHE): last save time and row count it held
+    SCDateTime LastCacheSave;
+    size_t CacheSavedRows = 0;
+    
+    // File Tracking for Incremental Updates (byte offset just past the last parsed row)
+    std::map<std::string, unsigned long long> FileOffsets; 
+    // File identity at the time of that offset; a change means the file was replaced (e.g. Collector backfill)
+    std::map<std::string, unsigned long long> FileIds;
+    // First values[] slot of each extra package block per file (CSV: from its header, .gexb: its names)
+    std::map<std::string, std::vector<int>> PackageColumns;
+    // values[] slot of each CSV column (-1 = not read), from its header and the field mask
+    std::map<std::string, std::vector<int>> ColumnSlots;
+    // Window start each CSV was first read from via its .idx (LLONG_MIN = from the top)
+    std::map<std::string, long long> CsvLoadedFromMs;
+    // Earliest Unix ms decoded from each .gexz archive (frames before it were skipped)
+    std::map<std::string, long long> ArchiveLoadedFromMs;
+    // .gexz archives that could not be read (true once logged); their days fall back to the .gexb or .csv
+    std::map<std::string, bool> BadArchives;
+    // Day catalog of the ticker (see DAY CATALOG)
+    DayCatalog Catalog;
+    // Rows read from each day file so far; evicting the day erases exactly this span (see HISTORY PAGING)
+    std::map<std::string, LoadedSpan> LoadedSpans;
+    // Paged day files that gave no rows (header only); not queued again until the inputs change
+    std::set<std::string> EmptyPages;
+
+    // Wall-clock grid days, keyed by chart date (SCDateTime::GetDate) of the session
+    std::map<int, GridDay> GridDays;
+
+    // Daily Summary Mode: one entry per session, sorted by date
+    std::vector<DaySummary> Summaries;
+};
+
+// =========================
+//        UTILITIES
+// =========================
+
+std::string FormatDateSuffix(const SCDateTime& dt)
+{
+    int year = dt.GetYear();
+    int month = dt.GetMonth();
+    int day = dt.GetDay();
     
-    // File Tracking for Incremental Updates
-    std::map<std::string, std::streampos> FileOffsets; 
+    char buffer[20];
+    snprintf(buffer, sizeof(buffer), "%02d.%02d.%04d", month, day, year);
+    return buffer;
+}
+
+SCDateTime SubtractDays(SCDateTime base, int days)
+{
+    double adjusted = base.GetAsDouble() - days;
+    return SCDateTime(adjusted);
+}
+
+bool FileExists(const std::string& path)
+{
+    std::wstring wPath(path.begin(), path.end());
+    DWORD dwAttrib = GetFileAttributesW(wPath.c_str());
+    return (dwAttrib != INVALID_FILE_ATTRIBUTES && !(dwAttrib & FILE_ATTRIBUTE_DIRECTORY));
+}
+
+bool GetFileSize64(const std::string& path, unsigned long long& size)
+{
+    std::wstring wPath(path.begin(), path.end());
+    WIN32_FILE_ATTRIBUTE_DATA info;
+    if (!GetFileAttributesExW(wPath.c_str(), GetFileExInfoStandard, &info)) return false;
+    size = ((unsigned long long)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+    return true;
+}
+
+// Volume serial + NTFS file index. Survives appends, changes when the file is
+// swapped in by rename (creation time does not, because of tunneling).
+bool GetFileId(const std::string& path, unsigned long long& id)
+{
+    std::wstring wPath(path.begin(), path.end());
+    HANDLE h = CreateFileW(wPath.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return false;
+
+    BY_HANDLE_FILE_INFORMATION info;
+    BOOL ok = GetFileInformationByHandle(h, &info);
+    CloseHandle(h);
+    if (!ok) return false;
+
+    id = (((unsigned long long)info.nFileIndexHigh << 32) | info.nFileIndexLow) ^ ((unsigned long long)info.dwVolumeSerialNumber << 48);
+    return true;
+}
+
+// Read-only view of a whole file; unmapped on Close/destruction so writers can still replace it
+struct MappedFile
+{
+    HANDLE File = INVALID_HANDLE_VALUE;
+    HANDLE Mapping = NULL;
+    const char* Data = nullptr;
+    unsigned long long Size = 0;
+
+    bool Open(const std::string& path)
+    {
+        std::wstring wPath(path.begin(), path.end());
+        File = CreateFileW(wPath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (File == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(File, &size) || size.QuadPart == 0) { Close(); return false; }
+        Size = (unsigned long long)size.QuadPart;
+
+        Mapping = CreateFileMappingW(File, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!Mapping) { Close(); return false; }
+        Data = (const char*)MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!Data) { Close(); return false; }
+        return true;
+    }
+
+    void Close()
+    {
+        if (Data) UnmapViewOfFile(Data);
+        if (Mapping) CloseHandle(Mapping);
+        if (File != INVALID_HANDLE_VALUE) CloseHandle(File);
+        Data = nullptr;
+        Mapping = NULL;
+        File = INVALID_HANDLE_VALUE;
+        Size = 0;
+    }
+
+    ~MappedFile() { Close(); }
+};
+
+// =========================
+//       DAY CATALOG
+// =========================
+// "<base>\<Ticker>.catalog" lists the day files that exist for a ticker, one
+// line per day and format: date,format,rows,min_ts,max_ts,bytes (Unix
+// seconds, rows -1 = unknown). Written by the Collector / API study (see
+// GexBotDataCollector.cpp). For the days between its first and last entry it is
+// trusted instead of probing each file; it is read again only when it changes.
+
+#define CATALOG_HEADER "# GexBot day catalog v1: date,format,rows,min_ts,max_ts,bytes\r\n"
+
+struct CatalogEntry
+{
+    int Date;                   // YYYYMMDD of the "Tickers MM.DD.YYYY" folder
+    std::string Format;         // csv, gexb, grid, gexz, db
+    long long Rows;
+    double MinTs;
+    double MaxTs;
+    unsigned long long Bytes;
+};
+
+std::string GetCatalogPath(const std::string& baseFolder, const std::string& ticker)
+{
+    return baseFolder + "\\" + ticker + ".catalog";
+}
+
+bool ReadCatalog(const std::string& path, std::vector<CatalogEntry>& entries)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#') continue;
+        CatalogEntry e;
+        char format[16] = {0};
+        if (sscanf(line.c_str(), "%d,%15[^,],%lld,%lf,%lf,%llu", &e.Date, format, &e.Rows, &e.MinTs, &e.MaxTs, &e.Bytes) != 6)
+            continue;
+        e.Format = format;
+        entries.push_back(e);
+    }
+    return true;
+}
+
+// Reads the catalog again only when its size or write time changed (writers rewrite it whole)
+void RefreshDayCatalog(DayCatalog& catalog, const std::string& path)
+{
+    unsigned long long size = 0, writeTime = 0;
+    std::wstring wPath(path.begin(), path.end());
+    WIN32_FILE_ATTRIBUTE_DATA info;
+    if (GetFileAttributesExW(wPath.c_str(), GetFileExInfoStandard, &info))
+    {
+        size = ((unsigned long long)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+        writeTime = ((unsigned long long)info.ftLastWriteTime.dwHighDateTime << 32) | info.ftLastWriteTime.dwLowDateTime;
+    }
+    if (path == catalog.Path && size == catalog.Size && writeTime == catalog.WriteTime) return;
+
+    catalog.Path = path;
+    catalog.Size = size;
+    catalog.WriteTime = writeTime;
+    catalog.Days.clear();
+    std::vector<CatalogEntry> entries;
+    ReadCatalog(path, entries);
+    for (const CatalogEntry& e : entries)
+        catalog.Days[e.Date].insert(e.Format);
+}
+
+// =========================
+//      DAILY SUMMARY
+// =========================
+// "<base>\<Ticker>.summary", written by the Collector at the session close and
+// by GexBotArchiveTool: one line per day with the day's zero gamma / spot OHLC,
+// closing walls, wall moves and time above / below zero gamma. Daily Summary
+// Mode draws it on daily/weekly charts instead of loading intraday rows.
+
+#define SUMMARY_HEADER "# GexBot daily summary v1: date,rows,zero_open,zero_high,zero_low,zero_close," \
+    "spot_open,spot_high,spot_low,spot_close,pos_vol_close,neg_vol_close,pos_oi_close,neg_oi_close," \
+    "pos_vol_moves,neg_vol_moves,sec_above_zero,sec_below_zero\r\n"
+
+std::string GetSummaryPath(const std::string& baseFolder, const std::string& ticker)
+{
+    return baseFolder + "\\" + ticker + ".summary";
+}
+
+bool ReadSummaries(const std::string& path, std::vector<DaySummary>& days)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#') continue;
+        DaySummary d;
+        if (sscanf(line.c_str(), "%d,%lld,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%d,%d,%d,%d",
+                &d.Date, &d.Rows, &d.ZeroOpen, &d.ZeroHigh, &d.ZeroLow, &d.ZeroClose,
+                &d.SpotOpen, &d.SpotHigh, &d.SpotLow, &d.SpotClose,
+                &d.PosVolClose, &d.NegVolClose, &d.PosOiClose, &d.NegOiClose,
+                &d.PosVolMoves, &d.NegVolMoves, &d.SecAboveZero, &d.SecBelowZero) != 18)
+            continue;
+        days.push_back(d);
+    }
+    return true;
+}
+
+// =========================
+//     COMMIT PROTOCOL
+// =========================
+// The Collector publishes the byte length of fully written rows in
+// "<file>.commit" after every flush (see GexBotDataCollector.cpp).
+
+#define COMMIT_MAGIC   0x4D435847u  // "GXCM"
+#define COMMIT_VERSION 1u
+
+struct CommitRecord
+{
+    unsigned int Magic;
+    unsigned int Version;
+    unsigned long long CommittedBytes;
+    unsigned long long RowCount;
+    unsigned long long Checksum;
 };
 
+unsigned long long CommitChecksum(const CommitRecord& rec)
+{
+    return (rec.CommittedBytes * 0x9E3779B97F4A7C15ull) ^ (rec.RowCount + 0x632BE59BD9B4E019ull) ^ rec.Magic;
+}
+
+bool ReadCommitRecord(const std::string& dataPath, CommitRecord& rec)
+{
+    std::string commitPath = dataPath + ".commit";
+    std::wstring wPath(commitPath.begin(), commitPath.end());
+    HANDLE h = CreateFileW(wPath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return false;
+
+    DWORD bytesRead = 0;
+    BOOL ok = ReadFile(h, &rec, sizeof(rec), &bytesRead, NULL);
+    CloseHandle(h);
+
+    return ok && bytesRead == sizeof(rec) && rec.Magic == COMMIT_MAGIC &&
+        rec.Version == COMMIT_VERSION && rec.Checksum == CommitChecksum(rec);
+}
+
+// Readable end of a data file: the committed length when the writer published
+// one, otherwise the physical size (the caller still stops at the last newline).
+unsigned long long GetCommittedLength(const std::string& dataPath, unsigned long long fileSize)
+{
+    CommitRecord rec;
+    if (ReadCommitRecord(dataPath, rec) && rec.CommittedBytes <= fileSize)
+        return rec.CommittedBytes;
+    return fileSize;
+}
+
+// =========================
+//     TIME-SEEK INDEX
+// =========================
+// "<file>.idx" next to a day CSV (written by the Collector and the API study):
+// a header, then one (Unix ms, byte offset) entry for the first row of every
+// minute. Lets a reader start parsing at its window instead of at byte 0.
+
+#define CSV_INDEX_MAGIC   0x58495847u  // "GXIX"
+#define CSV_INDEX_VERSION 1u
+
+struct CsvIndexHeader
+{
+    unsigned int Magic;
+    unsigned int Version;
+};
+
+struct CsvIndexEntry
+{
+    long long TsMs;
+    unsigned long long Offset;
+};
+
+// Where to start parsing csvPath for rows at or after fromMs: the last indexed
+// row at or before fromMs. 0 (read from the top) when there is no usable index.
+// The row at the offset is checked against the entry, so an index left over
+// from a replaced CSV is never trusted.
+unsigned long long FindCsvSeekOffset(const std::string& csvPath, long long fromMs, unsigned long long limit)
+{
+    std::ifstream idx(csvPath + ".idx", std::ios::binary);
+    if (!idx.is_open()) return 0;
+
+    CsvIndexHeader hdr;
+    if (!idx.read((char*)&hdr, sizeof(hdr)) || hdr.Magic != CSV_INDEX_MAGIC || hdr.Version != CSV_INDEX_VERSION)
+        return 0;
+
+    std::vector<CsvIndexEntry> entries;
+    CsvIndexEntry e;
+    while (idx.read((char*)&e, sizeof(e)))
+        entries.push_back(e);
+
+    auto it = std::upper_bound(entries.begin(), entries.end(), fromMs,
+        [](long long ts, const CsvIndexEntry& entry) { return ts < entry.TsMs; });
+    if (it == entries.begin()) return 0;
+    --it;
+    if (it->Offset == 0 || it->Offset >= limit) return 0;
+
+    std::ifstream csv(csvPath, std::ios::binary);
+    char probe[40] = {0};
+    csv.seekg((std::streamoff)(it->Offset - 1));
+    csv.read(probe, sizeof(probe) - 1);
+    if (csv.gcount() < 2 || probe[0] != '\n') return 0;
+    double ts = strtod(probe + 1, nullptr);
+    if ((long long)floor(ts * 1000.0 + 0.5) != it->TsMs) return 0;
+
+    return it->Offset;
+}
+
+// =========================
+//     CSV PARSING
+// =========================
+
+// Delimiters are found 16 bytes at a time with SSE2 (every x64 CPU has it)
+// and each field is converted in place with std::from_chars: no substrings,
+// no allocations, no exceptions. Other targets use the scalar loop.
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define CSV_TOKENIZER_SSE2 1
+#endif
+
+#ifdef CSV_TOKENIZER_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Bit i set = byte i of the 16 at p is ',' or '\n'
+inline unsigned int CsvDelimiterMask(const char* p)
+{
+    __m128i block = _mm_loadu_si128((const __m128i*)p);
+    __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(',')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\n')));
+    return (unsigned int)_mm_movemask_epi8(hits);
+}
+
+inline int LowestSetBit(unsigned int mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+// Blanks around the number are ignored; empty or non-numeric fields read as 0
+inline double ParseCsvNumber(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    while (end > p && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) --end;
+    if (p < end && *p == '+') ++p;
+    double v = 0.0;
+    if (std::from_chars(p, end, v).ec != std::errc()) return 0.0;
+    return v;
+}
+
+// Splits [begin, end) into lines and calls onRow(values, columnCount,
+// lineBegin, lineEnd) for every non-blank line (lineEnd excludes the '\n').
+// File column c is converted into values[slots[c]]; columns without a slot
+// (-1, or past the end of slots) are only scanned over. values[0, valueCount)
+// is NaN for every slot the line did not fill.
+template <typename RowFn>
+void TokenizeCsv(const char* begin, const char* end, const std::vector<int>& slots, double* values, int valueCount, RowFn onRow)
+{
+    const char* lineStart = begin;
+    const char* fieldStart = begin;
+    const int* slot = slots.data();
+    const int slotCount = (int)slots.size();
+    int column = 0;
+    std::fill(values, values + valueCount, std::numeric_limits<double>::quiet_NaN());
+
+    auto endLine = [&](const char* lineEnd) {
+        bool blank = (lineEnd == lineStart) || (lineEnd - lineStart == 1 && *lineStart == '\r');
+        if (!blank) onRow(values, column, lineStart, lineEnd);
+        column = 0;
+        lineStart = lineEnd + 1;
+        std::fill(values, values + valueCount, std::numeric_limits<double>::quiet_NaN());
+    };
+    auto delimiter = [&](const char* d) {
+        if (column < slotCount && slot[column] >= 0) values[slot[column]] = ParseCsvNumber(fieldStart, d);
+        ++column;
+        fieldStart = d + 1;
+        if (*d == '\n') endLine(d);
+    };
+
+    const char* p = begin;
+#ifdef CSV_TOKENIZER_SSE2
+    for (; end - p >= 16; p += 16)
+    {
+        for (unsigned int mask = CsvDelimiterMask(p); mask; mask &= mask - 1)
+            delimiter(p + LowestSetBit(mask));
+    }
+#endif
+    for (; p < end; ++p)
+        if (*p == ',' || *p == '\n') delimiter(p);
+
+    // Last line without a newline
+    if (lineStart < end)
+    {
+        if (column < slotCount && slot[column] >= 0) values[slot[column]] = ParseCsvNumber(fieldStart, end);
+        ++column;
+        endLine(end);
+    }
+}
+
+// 15 base columns + PACKAGE_FIELDS per extra source package
+#define MAX_CSV_FIELDS 64
+
+// Base columns in values[] order (CSV_HEADER in GexBotDataCollector.cpp)
+static const char* CSV_COLUMN_NAMES[15] = {
+    "timestamp", "spot", "zero_gamma", "major_pos_vol", "major_neg_vol", "major_pos_oi", "major_neg_oi", "sum_gex_vol",
+    "sum_gex_oi", "delta_risk_reversal", "major_long_gamma", "major_short_gamma", "major_positive", "major_negative", "net"
+};
+// Fields of one package block ("<label>.<name>")
+static const char* PACKAGE_FIELD_NAMES[PACKAGE_FIELDS] = {
+    "zero_gamma", "major_pos_vol", "major_neg_vol", "major_pos_oi", "major_neg_oi", "major_long_gamma", "major_short_gamma"
+};
+
+// One row in CSV column order (values[0] = Unix seconds) into the series.
+// packageColumns = first column of each extra package block, if any; block k
+// goes to its own series (VS_PACKAGE + k * PACKAGE_FIELDS), never over the base ones.
+// span: the file's LoadedSpan, widened by the row if it is stored.
+void StoreViewerRow(ViewerData* data, const double* values, int fieldCount, const std::vector<int>* packageColumns, int tzOffsetHours,
+    LoadedSpan& span)
+{
+    double ts = values[0];
+    if (ts <= 0) return;
+
+    SCDateTime dt((ts + tzOffsetHours * 3600.0) / 86400.0 + 25569.0);
+
+    double spot  = values[1];
+    double zero  = values[2];
+    double posv  = values[3];
+    double negv  = values[4];
+    double posoi = (fieldCount > 5) ? values[5] : 0;
+    double negoi = (fieldCount > 6) ? values[6] : 0;
+    double lng   = (fieldCount > 10) ? values[10] : 0;
+    double sht   = (fieldCount > 11) ? values[11] : 0;
+    double mjp   = (fieldCount > 12) ? values[12] : 0;
+    double mjn   = (fieldCount > 13) ? values[13] : 0;
+    double netv  = (fieldCount > 7)  ? values[7] : 0;
+    double netoi = (fieldCount > 8)  ? values[8] : 0;
+
+    // Zero = not published, same as missing
+    double row[VS_COUNT] = { zero, posv, negv, posoi, negoi, netv, netoi, lng, sht, mjp, mjn };
+    for (int s = VS_PACKAGE; s < VS_COUNT; ++s) row[s] = 0;
+    if (packageColumns)
+    {
+        for (size_t k = 0; k < packageColumns->size() && k < VIEWER_MAX_PACKAGES; ++k)
+            for (int f = 0; f < PACKAGE_FIELDS; ++f)
+                if ((*packageColumns)[k] + f < fieldCount)
+                    row[VS_PACKAGE + k * PACKAGE_FIELDS + f] = values[(*packageColumns)[k] + f];
+    }
+    float cells[VS_COUNT];
+    bool any = false;
+    for (int s = 0; s < VS_COUNT; ++s)
+    {
+        cells[s] = (!std::isnan(row[s]) && row[s] != 0) ? (float)row[s] : NAN;
+        any |= !std::isnan(cells[s]);
+    }
+    if (!any) return;
+    data->Series.Add(dt.GetAsDouble(), cells);
+    span.Widen(dt.GetAsDouble());
+}
+
+// Resolves a CSV header into the values[] slot of each file column. Base
+// columns are matched by name, so reordered or added columns are harmless;
+// "<label>.<field>" package columns go to block k at 15 + k * PACKAGE_FIELDS
+// (see GexBotDataCollector.cpp). Columns outside fieldMask (bit = base
+// column, bit 16 + f = package field f), unknown names and packages past
+// VIEWER_MAX_PACKAGES get -1: the tokenizer skips them unconverted. An empty
+// header means the positional 15-column layout. blocks receives the first
+// slot of each package block.
+void BuildViewerColumnSlots(const std::string& header, unsigned int fieldMask, std::vector<int>& slots, std::vector<int>& blocks)
+{
+    slots.clear();
+    blocks.clear();
+    if (header.empty())
+    {
+        for (int c = 0; c < 15; ++c)
+            slots.push_back(((fieldMask >> c) & 1) ? c : -1);
+        return;
+    }
+
+    std::vector<std::string> labels;
+    size_t pos = 0;
+    while (pos <= header.size())
+    {
+        size_t comma = header.find(',', pos);
+        if (comma == std::string::npos) comma = header.size();
+        size_t first = header.find_first_not_of(" \t", pos);
+        size_t last = header.find_last_not_of(" \t\r", comma - 1);
+        std::string name = (first < comma && last != std::string::npos && last >= first) ? header.substr(first, last - first + 1) : "";
+        pos = comma + 1;
+
+        int slot = -1;
+        size_t dot = name.rfind('.');
+        if (dot == std::string::npos)
+        {
+            for (int c = 0; c < 15; ++c)
+            {
+                if (name != CSV_COLUMN_NAMES[c]) continue;
+                if ((fieldMask >> c) & 1) slot = c;
+                break;
+            }
+        }
+        else
+        {
+            for (int f = 0; f < PACKAGE_FIELDS; ++f)
+            {
+                if (name.compare(dot + 1, std::string::npos, PACKAGE_FIELD_NAMES[f]) != 0) continue;
+                std::string label = name.substr(0, dot);
+                size_t k = std::find(labels.begin(), labels.end(), label) - labels.begin();
+                if (k == labels.size()) labels.push_back(label);
+                if (((fieldMask >> (16 + f)) & 1) && k < VIEWER_MAX_PACKAGES) slot = 15 + (int)k * PACKAGE_FIELDS + f;
+                break;
+            }
+        }
+        slots.push_back(slot);
+    }
+
+    for (size_t k = 0; k < labels.size() && k < VIEWER_MAX_PACKAGES; ++k)
+        blocks.push_back(15 + (int)k * PACKAGE_FIELDS);
+}
+
+// =========================
+//     PARALLEL LOADING
+// =========================
+// Work is split into chunks that each fill a private ViewerData; the chunks'
+// sorted rows are then appended to the shared one on the study thread.
+
+#define CSV_CHUNK_MIN_BYTES (4ull << 20) // Smallest piece of one CSV worth its own thread
+
+// Set while a thread runs pool jobs; a pooled day does not split its file again
+thread_local bool InWorkerPool = false;
+
+// Runs job(i) for every i in [0, count) on up to one thread per core; the study thread takes jobs too
+template <class Job>
+void RunPool(size_t count, Job job)
+{
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        bool nested = InWorkerPool;
+        InWorkerPool = true;
+        for (size_t j = next++; j < count; j = next++)
+            job(j);
+        InWorkerPool = nested;
+    };
+    size_t threads = std::min<size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < threads; ++i) pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool) t.join();
+}
+
+// Moves a chunk parsed into a private ViewerData into data. Chunks (days, or pieces
+// of one file) are merged in time order, so the rows are normally appended as a block.
+void MergeViewerChunk(ViewerData* data, ViewerData& chunk)
+{
+    data->Series.MergeFrom(chunk.Series);
+    for (const auto& kv : chunk.FileOffsets) data->FileOffsets[kv.first] = kv.second;
+    for (const auto& kv : chunk.FileIds) data->FileIds[kv.first] = kv.second;
+    for (auto& kv : chunk.PackageColumns) data->PackageColumns[kv.first].swap(kv.second);
+    for (auto& kv : chunk.ColumnSlots) data->ColumnSlots[kv.first].swap(kv.second);
+    for (const auto& kv : chunk.CsvLoadedFromMs) data->CsvLoadedFromMs[kv.first] = kv.second;
+    for (const auto& kv : chunk.ArchiveLoadedFromMs) data->ArchiveLoadedFromMs[kv.first] = kv.second;
+    for (const auto& kv : chunk.BadArchives) data->BadArchives.emplace(kv.first, false);
+    for (const auto& kv : chunk.LoadedSpans) data->LoadedSpans[kv.first].Widen(kv.second);
+}
+
+// Newline-aligned piece boundaries for [begin, end) (complete lines): one piece per
+// core at most, none smaller than CSV_CHUNK_MIN_BYTES. Two entries = one piece.
+std::vector<const char*> SplitCsvSpan(const char* begin, const char* end)
+{
+    std::vector<const char*> cuts(1, begin);
+    size_t bytes = (size_t)(end - begin);
+    size_t pieces = InWorkerPool ? 1 : std::min<size_t>(bytes / CSV_CHUNK_MIN_BYTES, std::thread::hardware_concurrency());
+    for (size_t k = 1; k < pieces; ++k)
+    {
+        const char* p = std::max(begin + bytes / pieces * k, cuts.back());
+        const char* newline = (const char*)memchr(p, '\n', (size_t)(end - p));
+        if (!newline || newline + 1 >= end) break;
+        cuts.push_back(newline + 1);
+    }
+    cuts.push_back(end);
+    return cuts;
+}
+
+// =========================
+//       LOAD BUDGET
+// =========================
+// A history load can be spread over several study calls so the chart stays
+// responsive. On the study thread, CSV rows are parsed in LOAD_SLICE_BYTES
+// slices and a read stops at the first slice boundary past the call's
+// deadline; the file's offset is the cursor the next call resumes from.
+
+#define LOAD_SLICE_BYTES   (256u << 10)
+#define LOAD_PROGRESS_LINE 7470000      // + StudyGraphInstanceID: chart text while loading
+
+typedef std::chrono::steady_clock::time_point LoadDeadline;
+
+// nullptr = no budget (pool and pager threads, budget input 0)
+inline bool PastDeadline(const LoadDeadline* deadline)
+{
+    return deadline && std::chrono::steady_clock::now() >= *deadline;
+}
+
+// End of the slice starting at from, just past a newline ([from, end) holds complete lines)
+inline const char* NextCsvSlice(const char* from, const char* end)
+{
+    if ((size_t)(end - from) <= LOAD_SLICE_BYTES) return end;
+    const char* newline = (const char*)memchr(from + LOAD_SLICE_BYTES, '\n', (size_t)(end - from) - LOAD_SLICE_BYTES);
+    return newline ? newline + 1 : end;
+}
+
+// fromMs: chart window start; a first read jumps there through the time-seek index
+// fieldMask: base columns to convert (see BuildViewerColumnSlots)
+// deadline: stop at the first slice past it and set LoadPending (see LOAD BUDGET)
+void LoadViewerCSV(const std::string& fullPath, int tzOffsetHours, long long fromMs, unsigned int fieldMask, ViewerData* data,
+    const LoadDeadline* deadline = nullptr)
+{
+    unsigned long long fileSize = 0;
+    if (!GetFileSize64(fullPath, fileSize)) return;
+    unsigned long long limit = GetCommittedLength(fullPath, fileSize);
+
+    // Resume exactly where the previous read stopped
+    unsigned long long offset = 0;
+    auto found = data->FileOffsets.find(fullPath);
+    if (found != data->FileOffsets.end())
+        offset = found->second;
+
+    // Window moved earlier than where the index let us start -> Read again from the new start
+    auto loadedFrom = data->CsvLoadedFromMs.find(fullPath);
+    if (loadedFrom != data->CsvLoadedFromMs.end() && fromMs < loadedFrom->second)
+        offset = 0;
+
+    // Replaced file (different identity) -> Start from 0
+    unsigned long long fileId = 0;
+    if (GetFileId(fullPath, fileId))
+    {
+        auto knownId = data->FileIds.find(fullPath);
+        if (knownId != data->FileIds.end() && knownId->second != fileId)
+            offset = 0;
+        data->FileIds[fullPath] = fileId;
+    }
+
+    // Committed length below our offset means the file was truncated/recreated -> Start from 0
+    if (limit < offset)
+        offset = 0;
+    if (limit == offset)
+        return;
+
+    // Rows are parsed straight from the mapped pages, no copy
+    MappedFile mf;
+    if (!mf.Open(fullPath)) return;
+    if (limit > mf.Size) limit = mf.Size;
+    if (offset >= limit) return;
+
+    // The header line (starts with a non-digit, not a minus sign) is needed complete
+    const char* headerEnd = (const char*)memchr(mf.Data, '\n', (size_t)limit);
+    if (!headerEnd) return;
+    bool hasHeader = !isdigit((unsigned char)*mf.Data) && *mf.Data != '-';
+
+    // First read: rows start at the window through the time-seek index, columns are resolved again
+    if (offset == 0)
+    {
+        unsigned long long seek = FindCsvSeekOffset(fullPath, fromMs, limit);
+        data->CsvLoadedFromMs[fullPath] = seek ? fromMs : LLONG_MIN;
+        data->ColumnSlots.erase(fullPath);
+        offset = seek;
+    }
+    if (hasHeader && offset <= (unsigned long long)(headerEnd - mf.Data))
+        offset = (unsigned long long)(headerEnd - mf.Data) + 1;
+
+    // Column plan: once per file (tail reads and warm starts rebuild it from the same header)
+    auto plan = data->ColumnSlots.find(fullPath);
+    if (plan == data->ColumnSlots.end())
+    {
+        std::string header = hasHeader ? std::string(mf.Data, headerEnd) : std::string();
+        if (!header.empty() && header.back() == '\r') header.pop_back();
+        plan = data->ColumnSlots.emplace(fullPath, std::vector<int>()).first;
+        BuildViewerColumnSlots(header, fieldMask, plan->second, data->PackageColumns[fullPath]);
+    }
+    const std::vector<int>& slots = plan->second;
+
+    // Only complete lines are parsed; a torn trailing row is left for the next read
+    const char* begin = mf.Data + offset;
+    const char* end = mf.Data + limit;
+    while (end > begin && end[-1] != '\n') --end;
+    if (end <= begin) return;
+
+    const std::vector<int>& blocks = data->PackageColumns[fullPath];
+    const std::vector<int>* packageColumns = blocks.empty() ? nullptr : &blocks;
+    int valueCount = 15 + (int)blocks.size() * PACKAGE_FIELDS;
+    auto parse = [&](const char* from, const char* to, ViewerData* target) {
+        double values[MAX_CSV_FIELDS];
+        LoadedSpan& span = target->LoadedSpans[fullPath];
+        TokenizeCsv(from, to, slots, values, valueCount,
+            [&](const double* row, int columnCount, const char*, const char*) {
+                if (columnCount >= 5)
+                    StoreViewerRow(target, row, valueCount, packageColumns, tzOffsetHours, span);
+            });
+    };
+
+    // On a budget: slice by slice on this thread, the offset following each slice
+    if (deadline)
+    {
+        for (const char* from = begin; from < end; )
+        {
+            const char* to = NextCsvSlice(from, end);
+            parse(from, to, data);
+            data->FileOffsets[fullPath] = (unsigned long long)(to - mf.Data);
+            from = to;
+            if (from < end && PastDeadline(deadline))
+            {
+                data->LoadPending = true;
+                data->LoadingPath = fullPath;
+                data->LoadingPercent = (int)((unsigned long long)(from - mf.Data) * 100 / (unsigned long long)(end - mf.Data));
+                return;
+            }
+        }
+        return;
+    }
+
+    // A large span (a whole long day on first read) is parsed in pieces on the pool
+    std::vector<const char*> cuts = SplitCsvSpan(begin, end);
+    if (cuts.size() <= 2)
+    {
+        parse(begin, end, data);
+    }
+    else
+    {
+        std::vector<ViewerData> chunks(cuts.size() - 1);
+        RunPool(chunks.size(), [&](size_t j) { parse(cuts[j], cuts[j + 1], &chunks[j]); });
+        for (ViewerData& chunk : chunks)
+            MergeViewerChunk(data, chunk);
+    }
+
+    // Save new offset: the byte just past the last complete row
+    data->FileOffsets[fullPath] = (unsigned long long)(end - mf.Data);
+}
+
+// =========================
+//   BINARY DAY FILE (.gexb)
+// =========================
+// Columnar twin of the CSV written by the Collector (see GexBotDataCollector.cpp):
+// header, field names, int64 Unix-ms timestamp column, one float column per
+// field, each Capacity rows long. Only the first RowCount rows are valid.
+
+#define GEXB_MAGIC   0x4E425847u  // "GXBN"
+#define GEXB_VERSION 1u
+
+struct GexbHeader
+{
+    unsigned int Magic;
+    unsigned int Version;
+    int FieldCount;
+    int Capacity;
+    int RowCount;
+    int NamesBytes;
+};
+
+// Maps the file and feeds rows added since the last call straight from the
+// columns (no text parsing). FileOffsets holds the row count for .gexb paths.
+void LoadViewerGexb(const std::string& fullPath, int tzOffsetHours, ViewerData* data)
+{
+    MappedFile mf;
+    if (!mf.Open(fullPath)) return;
+
+    GexbHeader hdr;
+    if (mf.Size < sizeof(hdr)) return;
+    memcpy(&hdr, mf.Data, sizeof(hdr));
+    if (hdr.Magic != GEXB_MAGIC || hdr.Version != GEXB_VERSION || hdr.FieldCount <= 0 || hdr.FieldCount >= MAX_CSV_FIELDS ||
+        hdr.RowCount > hdr.Capacity || hdr.NamesBytes <= 0)
+        return;
+
+    unsigned long long tsOffset = sizeof(GexbHeader) + (unsigned long long)hdr.NamesBytes;
+    unsigned long long fieldsOffset = tsOffset + (unsigned long long)hdr.Capacity * sizeof(long long);
+    if (mf.Size < fieldsOffset + (unsigned long long)hdr.FieldCount * hdr.Capacity * sizeof(float))
+        return;
+
+    // Rewritten file (grown or backfilled) -> Start from row 0
+    unsigned long long start = data->FileOffsets[fullPath];
+    BY_HANDLE_FILE_INFORMATION info;
+    if (GetFileInformationByHandle(mf.File, &info))
+    {
+        unsigned long long fileId = (((unsigned long long)info.nFileIndexHigh << 32) | info.nFileIndexLow) ^ ((unsigned long long)info.dwVolumeSerialNumber << 48);
+        auto knownId = data->FileIds.find(fullPath);
+        if (knownId != data->FileIds.end() && knownId->second != fileId)
+            start = 0;
+        data->FileIds[fullPath] = fileId;
+    }
+    if (start > (unsigned long long)hdr.RowCount)
+        start = 0;
+
+    // Package blocks, in CSV column numbering (field f = column f + 1)
+    std::vector<int>& blocks = data->PackageColumns[fullPath];
+    blocks.clear();
+    std::string names(mf.Data + sizeof(GexbHeader), strnlen(mf.Data + sizeof(GexbHeader), hdr.NamesBytes));
+    int col = 1;
+    size_t pos = 0;
+    while (pos <= names.size())
+    {
+        size_t comma = names.find(',', pos);
+        if (comma == std::string::npos) comma = names.size();
+        std::string name = names.substr(pos, comma - pos);
+        if (col >= 15 && name.size() > 11 && name.compare(name.size() - 11, 11, ".zero_gamma") == 0)
+            blocks.push_back(col);
+        ++col;
+        pos = comma + 1;
+    }
+
+    const long long* tsColumn = (const long long*)(mf.Data + tsOffset);
+    const float* fieldColumns = (const float*)(mf.Data + fieldsOffset);
+    double values[MAX_CSV_FIELDS];
+    LoadedSpan& span = data->LoadedSpans[fullPath];
+    for (int r = (int)start; r < hdr.RowCount; ++r)
+    {
+        values[0] = tsColumn[r] / 1000.0;
+        for (int f = 0; f < hdr.FieldCount; ++f)
+            values[f + 1] = fieldColumns[(size_t)f * hdr.Capacity + r];
+        StoreViewerRow(data, values, hdr.FieldCount + 1, blocks.empty() ? nullptr : &blocks, tzOffsetHours, span);
+    }
+
+    data->FileOffsets[fullPath] = hdr.RowCount;
+}
+
+// =========================
+//   ARCHIVED DAYS (.gexz)
+// =========================
+// Closed days compacted by GexBotArchiveTool.cpp. A frame index by time range
+// lets us read and decode only the frames inside the chart's window.
+
+#define GEXZ_MAGIC   0x5A585847u  // "GXXZ"
+#define GEXZ_VERSION 1u
+
+struct GexzHeader
+{
+    unsigned int Magic;
+    unsigned int Version;
+    unsigned int FieldCount;
+    unsigned int FrameCount;
+    unsigned long long RowCount;
+    unsigned int NamesBytes;
+    unsigned int Reserved;
+};
+
+struct GexzFrameEntry
+{
+    long long FirstTsMs;
+    long long LastTsMs;
+    unsigned long long Offset;
+    unsigned int Bytes;
+    unsigned int Rows;
+};
+
+bool GetVarint(const unsigned char*& p, const unsigned char* end, unsigned long long& v)
+{
+    v = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7)
+    {
+        unsigned char b = *p++;
+        v |= (unsigned long long)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+// Same codec as GexBotArchiveTool.cpp: delta-run timestamps, XOR/repeat float columns.
+// Output is row-major, fieldCount values per row.
+bool DecodeGexzFrame(const unsigned char* p, const unsigned char* end, int fieldCount, size_t rows,
+    std::vector<long long>& tsMs, std::vector<float>& values)
+{
+    if (rows == 0 || end - p < (long)sizeof(long long)) return false;
+    tsMs.assign(rows, 0);
+    values.assign(rows * fieldCount, 0.0f);
+
+    memcpy(&tsMs[0], p, sizeof(long long));
+    p += sizeof(long long);
+    size_t i = 1;
+    while (i < rows)
+    {
+        unsigned long long zz, run;
+        if (!GetVarint(p, end, zz) || !GetVarint(p, end, run) || run == 0 || i + run > rows) return false;
+        long long delta = (long long)(zz >> 1) ^ -(long long)(zz & 1);
+        for (unsigned long long k = 0; k < run; ++k, ++i)
+            tsMs[i] = tsMs[i - 1] + delta;
+    }
+
+    for (int f = 0; f < fieldCount; ++f)
+    {
+        unsigned int prev = 0;
+        size_t r = 0;
+        while (r < rows)
+        {
+            unsigned long long token;
+            if (!GetVarint(p, end, token)) return false;
+            int nbytes = (int)(token & 3) + 1;
+            unsigned long long repeat = token >> 2;
+            if (end - p < nbytes || r + 1 + repeat > rows) return false;
+
+            unsigned int x = 0;
+            for (int b = 0; b < nbytes; ++b) x |= (unsigned int)p[b] << (8 * b);
+            p += nbytes;
+
+            unsigned int bits = prev ^ x;
+            float v;
+            memcpy(&v, &bits, sizeof(v));
+            for (unsigned long long k = 0; k <= repeat; ++k, ++r)
+                values[r * fieldCount + f] = v;
+            prev = bits;
+        }
+    }
+    return true;
+}
+
+// Archives never change once written; a file is read again only when the
+// window reaches further back than what was already decoded. Frames are
+// decoded into a private store and kept only when all of them read back: a
+// damaged file adds no rows and goes to BadArchives instead.
+void LoadViewerArchive(const std::string& fullPath, int tzOffsetHours, long long fromMs, ViewerData* data)
+{
+    auto loaded = data->ArchiveLoadedFromMs.find(fullPath);
+    if (loaded != data->ArchiveLoadedFromMs.end() && loaded->second <= fromMs)
+        return;
+    long long toMs = (loaded != data->ArchiveLoadedFromMs.end()) ? loaded->second - 1 : LLONG_MAX;
+
+    unsigned long long fileSize = 0;
+    std::ifstream in(fullPath, std::ios::binary);
+    if (!in.is_open() || !GetFileSize64(fullPath, fileSize)) return; // Busy or gone: tried again on the next reload
+
+    auto fail = [&]() { data->BadArchives.emplace(fullPath, false); };
+
+    // Sizes are checked against the file before anything is allocated from them
+    GexzHeader hdr;
+    in.read((char*)&hdr, sizeof(hdr));
+    if (!in || hdr.Magic != GEXZ_MAGIC || hdr.Version != GEXZ_VERSION || hdr.FieldCount == 0 || hdr.FieldCount >= MAX_CSV_FIELDS ||
+        sizeof(hdr) + (unsigned long long)hdr.NamesBytes + (unsigned long long)hdr.FrameCount * sizeof(GexzFrameEntry) > fileSize)
+        return fail();
+
+    std::string names(hdr.NamesBytes, '\0');
+    if (!names.empty()) in.read(&names[0], names.size());
+    names.resize(strlen(names.c_str()));
+    std::vector<GexzFrameEntry> index(hdr.FrameCount);
+    if (hdr.FrameCount) in.read((char*)index.data(), index.size() * sizeof(GexzFrameEntry));
+    if (!in) return fail();
+
+    // Package blocks, in CSV column numbering (field f = column f + 1)
+    std::vector<int> blocks;
+    int col = 1;
+    size_t pos = 0;
+    while (pos <= names.size())
+    {
+        size_t comma = names.find(',', pos);
+        if (comma == std::string::npos) comma = names.size();
+        std::string name = names.substr(pos, comma - pos);
+        if (col >= 15 && name.size() > 11 && name.compare(name.size() - 11, 11, ".zero_gamma") == 0)
+            blocks.push_back(col);
+        ++col;
+        pos = comma + 1;
+    }
+
+    ViewerData decoded;
+    LoadedSpan span;
+    std::string buf;
+    std::vector<long long> tsMs;
+    std::vector<float> frameValues;
+    double values[MAX_CSV_FIELDS];
+    for (const GexzFrameEntry& e : index)
+    {
+        if (e.LastTsMs < fromMs || e.FirstTsMs > toMs) continue;
+        if (e.Offset > fileSize || e.Bytes > fileSize - e.Offset) return fail();
+
+        buf.resize(e.Bytes);
+        in.seekg((std::streamoff)e.Offset);
+        in.read(&buf[0], e.Bytes);
+        const unsigned char* p = (const unsigned char*)buf.data();
+        if (!in || !DecodeGexzFrame(p, p + buf.size(), (int)hdr.FieldCount, e.Rows, tsMs, frameValues))
+            return fail();
+
+        for (size_t r = 0; r < e.Rows; ++r)
+        {
+            values[0] = tsMs[r] / 1000.0;
+            for (unsigned int f = 0; f < hdr.FieldCount; ++f)
+                values[f + 1] = frameValues[r * hdr.FieldCount + f];
+            StoreViewerRow(&decoded, values, (int)hdr.FieldCount + 1, blocks.empty() ? nullptr : &blocks, tzOffsetHours, span);
+        }
+    }
+
+    data->Series.MergeFrom(decoded.Series);
+    data->LoadedSpans[fullPath].Widen(span);
+    data->ArchiveLoadedFromMs[fullPath] = fromMs;
+}
+
 // =========================
-//        UTILITIES
+//     GRID READING
 // =========================
 
-double StringToDouble(const std::string& str)
+#define GRID_MAGIC   0x44475847u  // "GXGD"
+#define GRID_VERSION 1u
+
+struct GridHeader
+{
+    unsigned int Magic;
+    unsigned int Version;
+    long long SessionOpenUnix;
+    int StrideSec;
+    int SlotCount;
+    int FieldCount;
+    int CommittedSlots;
+};
+
+// Reads slots committed since the last call. Returns the number of new slots.
+int LoadViewerGrid(const std::string& fullPath, int tzOffsetHours, ViewerData* data)
 {
-    if (str.empty()) return 0.0;
-    try {
-        return std::stod(str);
+    std::wstring wPath(fullPath.begin(), fullPath.end());
+    HANDLE h = CreateFileW(wPath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return 0;
+
+    GridHeader hdr;
+    DWORD bytes = 0;
+    if (!ReadFile(h, &hdr, sizeof(hdr), &bytes, NULL) || bytes != sizeof(hdr) ||
+        hdr.Magic != GRID_MAGIC || hdr.Version != GRID_VERSION || hdr.StrideSec <= 0 ||
+        hdr.FieldCount <= GF_NET || hdr.CommittedSlots > hdr.SlotCount)
+    {
+        CloseHandle(h);
+        return 0;
+    }
+
+    unsigned long long fileId = 0;
+    BY_HANDLE_FILE_INFORMATION info;
+    if (GetFileInformationByHandle(h, &info))
+        fileId = (((unsigned long long)info.nFileIndexHigh << 32) | info.nFileIndexLow) ^ ((unsigned long long)info.dwVolumeSerialNumber << 48);
+
+    int date = SCDateTime((hdr.SessionOpenUnix + tzOffsetHours * 3600.0) / 86400.0 + 25569.0).GetDate();
+    GridDay& grid = data->GridDays[date];
+    if (grid.SessionOpenUnix != hdr.SessionOpenUnix || grid.StrideSec != hdr.StrideSec || grid.FieldCount != hdr.FieldCount ||
+        grid.FileId != fileId)
+    {
+        grid = GridDay();
+        grid.SessionOpenUnix = hdr.SessionOpenUnix;
+        grid.StrideSec = hdr.StrideSec;
+        grid.FieldCount = hdr.FieldCount;
+        grid.FileId = fileId;
+    }
+
+    int newSlots = hdr.CommittedSlots - grid.LoadedSlots;
+    if (newSlots <= 0)
+    {
+        CloseHandle(h);
+        return 0;
+    }
+
+    // Bars from the first new slot on draw differently (before, they showed the last committed one)
+    double slotUnix = (double)(hdr.SessionOpenUnix + (long long)grid.LoadedSlots * grid.StrideSec);
+    data->GridChangedFrom = std::min(data->GridChangedFrom, (slotUnix + tzOffsetHours * 3600.0) / 86400.0 + 25569.0);
+
+    size_t first = (size_t)grid.LoadedSlots * grid.FieldCount;
+    grid.Values.resize((size_t)hdr.CommittedSlots * grid.FieldCount);
+
+    LARGE_INTEGER pos;
+    pos.QuadPart = (LONGLONG)sizeof(GridHeader) + (LONGLONG)first * (LONGLONG)sizeof(float);
+    SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+    bool ok = ReadFile(h, &grid.Values[first], (DWORD)(newSlots * grid.FieldCount * sizeof(float)), &bytes, NULL) &&
+        bytes == newSlots * grid.FieldCount * sizeof(float);
+    CloseHandle(h);
+
+    if (!ok)
+    {
+        grid.Values.resize(first);
+        return 0;
     }
-    catch (...) {
-        return 0.0;
+
+    // Forward fill skipped slots and zero values (0 = not available, same rule as the CSV path)
+    for (size_t i = first; i < grid.Values.size(); ++i)
+    {
+        float& v = grid.Values[i];
+        if (std::isnan(v) || v == 0)
+            v = (i >= (size_t)grid.FieldCount) ? grid.Values[i - grid.FieldCount] : std::numeric_limits<float>::quiet_NaN();
     }
+
+    grid.LoadedSlots = hdr.CommittedSlots;
+    return newSlots;
 }
 
-std::string FormatDateSuffix(const SCDateTime& dt)
+// =========================
+//     WARM-START CACHE
+// =========================
+// "<base>\<Ticker>.viewcache" holds the parsed series and the read state of each
+// file they came from (identity, size, offset). Written when the study goes
+// away and every VIEWER_CACHE_SAVE_SEC while rows keep arriving; on the next
+// start it replaces the full re-parse and the loaders only tail what was
+// appended since. Other inputs discard the whole snapshot; a file that was
+// replaced (new identity: backfill, a CSV compacted to .gexz), shrank or is
+// gone only loses its own rows and read state, so its day is read again from
+// whatever is on disk now and the other days are kept.
+
+#define VIEWER_CACHE_MAGIC    0x43565847u  // "GXVC"
+#define VIEWER_CACHE_VERSION  5u
+#define VIEWER_CACHE_SAVE_SEC 300
+
+struct ViewerCacheHeader
 {
-    int year = dt.GetYear();
-    int month = dt.GetMonth();
-    int day = dt.GetDay();
-    
-    char buffer[20];
-    snprintf(buffer, sizeof(buffer), "%02d.%02d.%04d", month, day, year);
-    return buffer;
-}
+    unsigned int Magic;
+    unsigned int Version;
+    int DaysCount;
+    int TzOffset;
+    unsigned int KeyBytes;      // "<base>|<ticker>" follows the header
+    unsigned int FileCount;
+    unsigned int SeriesCount;
+    unsigned int FieldMask;     // CSV columns the series were parsed with
+};
 
-SCDateTime SubtractDays(SCDateTime base, int days)
+// One per tracked file, followed by the path and PackageCount ints
+struct ViewerCacheFile
 {
-    double adjusted = base.GetAsDouble() - days;
-    return SCDateTime(adjusted);
+    unsigned long long FileId;  // 0 = the file was gone at save time
+    unsigned long long Size;    // At save time; appends only grow it
+    unsigned long long Offset;  // FileOffsets entry (bytes for .csv, rows for .gexb)
+    long long CsvLoadedFromMs;
+    long long ArchiveLoadedFromMs;
+    double LoadedFrom;          // LoadedSpans entry
+    double LoadedTo;
+    unsigned int Flags;         // VCF_* below: which of the entries above exist
+    unsigned int PathBytes;
+    unsigned int PackageCount;
+    unsigned int Reserved;
+};
+
+enum { VCF_OFFSET = 1, VCF_CSV_FROM = 2, VCF_ARCHIVE_FROM = 4, VCF_PACKAGES = 8, VCF_SPAN = 16 };
+
+std::string GetViewerCachePath(const std::string& baseFolder, const std::string& ticker)
+{
+    return baseFolder + "\\" + ticker + ".viewcache";
 }
 
-bool FileExists(const std::string& path)
+// Series section: row count, the Active mask, then the times (SCDateTime
+// doubles), the Observed masks and one column of floats per active series,
+// filled cells included
+bool SaveViewerCache(const std::string& path, ViewerData* data)
 {
+    std::string key = data->LastBasePath + "|" + data->LastTicker;
+    std::set<std::string> files;
+    for (const auto& f : data->FileOffsets) files.insert(f.first);
+    for (const auto& f : data->ArchiveLoadedFromMs) files.insert(f.first);
+
+    std::string out;
+    auto put = [&out](const void* p, size_t n) { out.append((const char*)p, n); };
+
+    ViewerCacheHeader hdr = { VIEWER_CACHE_MAGIC, VIEWER_CACHE_VERSION, data->LastDaysCount, data->LastTzOffset,
+        (unsigned int)key.size(), (unsigned int)files.size(), VS_COUNT, data->LastFieldMask };
+    put(&hdr, sizeof(hdr));
+    put(key.data(), key.size());
+
+    for (const std::string& f : files)
+    {
+        ViewerCacheFile rec = {};
+        // Identity the rows were read under; archives are not tracked by the loader, take it now.
+        // A file removed since it was read is saved as gone: the next start drops its rows.
+        auto id = data->FileIds.find(f);
+        if (id != data->FileIds.end()) rec.FileId = id->second;
+        else if (!GetFileId(f, rec.FileId)) rec.FileId = 0;
+        if (!GetFileSize64(f, rec.Size)) rec.FileId = rec.Size = 0;
+
+        auto offset = data->FileOffsets.find(f);
+        if (offset != data->FileOffsets.end()) { rec.Offset = offset->second; rec.Flags |= VCF_OFFSET; }
+        auto csvFrom = data->CsvLoadedFromMs.find(f);
+        if (csvFrom != data->CsvLoadedFromMs.end()) { rec.CsvLoadedFromMs = csvFrom->second; rec.Flags |= VCF_CSV_FROM; }
+        auto archiveFrom = data->ArchiveLoadedFromMs.find(f);
+        if (archiveFrom != data->ArchiveLoadedFromMs.end()) { rec.ArchiveLoadedFromMs = archiveFrom->second; rec.Flags |= VCF_ARCHIVE_FROM; }
+        auto span = data->LoadedSpans.find(f);
+        if (span != data->LoadedSpans.end()) { rec.LoadedFrom = span->second.From; rec.LoadedTo = span->second.To; rec.Flags |= VCF_SPAN; }
+        auto blocks = data->PackageColumns.find(f);
+        if (blocks != data->PackageColumns.end()) { rec.PackageCount = (unsigned int)blocks->second.size(); rec.Flags |= VCF_PACKAGES; }
+        rec.PathBytes = (unsigned int)f.size();
+
+        put(&rec, sizeof(rec));
+        put(f.data(), f.size());
+        if (rec.PackageCount > 0)
+            put(blocks->second.data(), rec.PackageCount * sizeof(int));
+    }
+
+    const SeriesStore& series = data->Series;
+    unsigned long long rows = series.Times.size();
+    put(&rows, sizeof(rows));
+    put(&series.Active, sizeof(series.Active));
+    put(series.Times.data(), rows * sizeof(double));
+    put(series.Observed.data(), rows * sizeof(unsigned int));
+    for (int s = 0; s < VS_COUNT; ++s)
+        if (series.IsActive(s)) put(series.Columns[s].data(), rows * sizeof(float));
+
+    std::string tmpPath = path + ".tmp";
+    std::wstring wTmp(tmpPath.begin(), tmpPath.end());
     std::wstring wPath(path.begin(), path.end());
-    DWORD dwAttrib = GetFileAttributesW(wPath.c_str());
-    return (dwAttrib != INVALID_FILE_ATTRIBUTES && !(dwAttrib & FILE_ATTRIBUTE_DIRECTORY));
+    HANDLE h = CreateFileW(wTmp.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return false;
+
+    DWORD bytes = 0;
+    BOOL ok = WriteFile(h, out.data(), (DWORD)out.size(), &bytes, NULL) && bytes == out.size();
+    CloseHandle(h);
+
+    if (!ok || !MoveFileExW(wTmp.c_str(), wPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        DeleteFileW(wTmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Restores a snapshot taken with the same inputs into an empty ViewerData
+bool LoadViewerCache(const std::string& path, const std::string& baseFolder, const std::string& ticker, int days, int tzOffset,
+    unsigned int fieldMask, ViewerData* data)
+{
+    MappedFile mf;
+    if (!mf.Open(path)) return false;
+    const char* p = mf.Data;
+    const char* end = mf.Data + mf.Size;
+    auto take = [&](void* dst, size_t n) {
+        if ((size_t)(end - p) < n) return false;
+        memcpy(dst, p, n);
+        p += n;
+        return true;
+    };
+
+    ViewerCacheHeader hdr;
+    if (!take(&hdr, sizeof(hdr)) || hdr.Magic != VIEWER_CACHE_MAGIC || hdr.Version != VIEWER_CACHE_VERSION ||
+        hdr.DaysCount != days || hdr.TzOffset != tzOffset || hdr.SeriesCount != VS_COUNT || hdr.FieldMask != fieldMask)
+        return false;
+    std::string key = baseFolder + "|" + ticker;
+    if (hdr.KeyBytes != key.size() || (size_t)(end - p) < key.size() || key.compare(0, key.size(), p, key.size()) != 0)
+        return false;
+    p += key.size();
+
+    ViewerData loaded;
+    std::vector<LoadedSpan> dropped;
+    for (unsigned int i = 0; i < hdr.FileCount; ++i)
+    {
+        ViewerCacheFile rec;
+        if (!take(&rec, sizeof(rec)) || (size_t)(end - p) < rec.PathBytes) return false;
+        std::string f(p, rec.PathBytes);
+        p += rec.PathBytes;
+
+        // Same file, only appended to since (a backfill or compaction swaps in a new one).
+        // Otherwise its rows go below and the day is read again, in whatever format it is in now.
+        unsigned long long fileId = 0, size = 0;
+        if (rec.FileId == 0 || !GetFileId(f, fileId) || fileId != rec.FileId || !GetFileSize64(f, size) || size < rec.Size)
+        {
+            LoadedSpan span;
+            if (rec.Flags & VCF_SPAN) { span.From = rec.LoadedFrom; span.To = rec.LoadedTo; }
+            dropped.push_back(span);
+            if ((rec.Flags & VCF_PACKAGES) && (size_t)(end - p) / sizeof(int) < rec.PackageCount) return false;
+            if (rec.Flags & VCF_PACKAGES) p += rec.PackageCount * sizeof(int);
+            continue;
+        }
+
+        if (rec.Flags & VCF_OFFSET) { loaded.FileOffsets[f] = rec.Offset; loaded.FileIds[f] = rec.FileId; }
+        if (rec.Flags & VCF_CSV_FROM) loaded.CsvLoadedFromMs[f] = rec.CsvLoadedFromMs;
+        if (rec.Flags & VCF_ARCHIVE_FROM) loaded.ArchiveLoadedFromMs[f] = rec.ArchiveLoadedFromMs;
+        if (rec.Flags & VCF_SPAN) { loaded.LoadedSpans[f].From = rec.LoadedFrom; loaded.LoadedSpans[f].To = rec.LoadedTo; }
+        if (rec.Flags & VCF_PACKAGES)
+        {
+            std::vector<int>& blocks = loaded.PackageColumns[f];
+            blocks.resize(rec.PackageCount);
+            if (rec.PackageCount > 0 && !take(blocks.data(), rec.PackageCount * sizeof(int))) return false;
+        }
+    }
+
+    // Saved sorted and filled: the columns are copied back as they are
+    SeriesStore& series = loaded.Series;
+    unsigned long long rows = 0;
+    unsigned int active = 0;
+    if (!take(&rows, sizeof(rows)) || !take(&active, sizeof(active)))
+        return false;
+    int columns = 0;
+    for (int s = 0; s < VS_COUNT; ++s)
+        if (active & (1u << s)) { series.Activate(s); ++columns; }
+    if ((unsigned long long)(end - p) / (sizeof(double) + sizeof(unsigned int) + columns * sizeof(float)) < rows)
+        return false;
+    series.Truncate((size_t)rows);
+    take(series.Times.data(), rows * sizeof(double));
+    take(series.Observed.data(), rows * sizeof(unsigned int));
+    for (int s = 0; s < VS_COUNT; ++s)
+        if (series.IsActive(s) && !take(series.Columns[s].data(), rows * sizeof(float))) return false;
+    series.Refill((size_t)rows); // Only finds each series' last value for the next append
+    for (const LoadedSpan& span : dropped)
+        if (span.From <= span.To)
+            series.Erase(span.From, std::nextafter(span.To, DBL_MAX));
+
+    loaded.LastBasePath = baseFolder;
+    loaded.LastTicker = ticker;
+    loaded.LastDaysCount = days;
+    loaded.LastTzOffset = tzOffset;
+    loaded.LastFieldMask = fieldMask;
+    *data = std::move(loaded);
+    return true;
 }
 
 // =========================
-//     CSV PARSING
+//     CHANGE WATCHER
 // =========================
+// A background thread blocks in ReadDirectoryChangesW on the data root (day
+// folders included) and raises Changed when a file of the watched ticker was
+// written, created or renamed into place. The study only goes to disk when
+// the flag is up, instead of re-checking every file each RefreshInterval;
+// the interval remains the fallback when the root cannot be watched (missing
+// folder, a share without change notifications) or the watch fails later.
 
-int ParseCsvLine(const std::string& line, double* values, int maxFields)
+#define WATCH_BUFFER_BYTES 65536
+
+struct DirectoryWatcher
 {
-    int count = 0;
-    size_t start = 0;
-    size_t pos = 0;
+    std::string Folder;
+    std::string Ticker;
+    std::atomic<bool> Changed{ true };  // Raised at start: the first call loads
+    std::atomic<bool> Active{ false };  // False = poll on RefreshInterval
+
+    HANDLE Dir = INVALID_HANDLE_VALUE;
+    HANDLE StopEvent = NULL;
+    std::thread Thread;
+
+    bool Start(const std::string& folder, const std::string& ticker)
+    {
+        Folder = folder;
+        Ticker = ticker;
+        std::wstring wPath(folder.begin(), folder.end());
+        Dir = CreateFileW(wPath.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+        if (Dir == INVALID_HANDLE_VALUE) return false;
+        StopEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+        if (!StopEvent) { Stop(); return false; }
+
+        Active = true;
+        Thread = std::thread([this] { Run(); });
+        return true;
+    }
+
+    void Stop()
+    {
+        if (StopEvent) SetEvent(StopEvent);
+        if (Thread.joinable()) Thread.join();
+        if (StopEvent) CloseHandle(StopEvent);
+        if (Dir != INVALID_HANDLE_VALUE) CloseHandle(Dir);
+        StopEvent = NULL;
+        Dir = INVALID_HANDLE_VALUE;
+        Active = false;
+    }
+
+    ~DirectoryWatcher() { Stop(); }
+
+    // "<ticker>.<anything>" in the root or a day folder; our own snapshots and
+    // the writers' temp files (their rename is reported separately) are not
+    bool IsRelevant(const wchar_t* name, size_t length) const
+    {
+        std::wstring path(name, length);
+        size_t slash = path.find_last_of(L'\\');
+        std::wstring file = (slash == std::wstring::npos) ? path : path.substr(slash + 1);
+        std::wstring prefix(Ticker.begin(), Ticker.end());
+        prefix += L'.';
+        if (file.compare(0, prefix.size(), prefix) != 0) return false;
+
+        static const wchar_t* IGNORED[] = { L".tmp", L".viewcache", L".apicache" };
+        for (const wchar_t* ext : IGNORED)
+        {
+            size_t n = wcslen(ext);
+            if (file.size() >= n && file.compare(file.size() - n, n, ext) == 0) return false;
+        }
+        return true;
+    }
 
-    while (pos <= line.length() && count < maxFields)
+    void Run()
     {
-        if (pos == line.length() || line[pos] == ',')
+        std::vector<DWORD> buffer(WATCH_BUFFER_BYTES / sizeof(DWORD)); // DWORD-aligned, as the API requires
+        OVERLAPPED ov = {};
+        ov.hEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+        if (!ov.hEvent) { Active = false; return; }
+
+        HANDLE waits[2] = { StopEvent, ov.hEvent };
+        for (;;)
         {
-            std::string field = line.substr(start, pos - start);
-            
-            // Trim whitespace
-            size_t first = field.find_first_not_of(" \t");
-            if (std::string::npos == first) {
-                 field = "";
-            } else {
-                 size_t last = field.find_last_not_of(" \t\r\n");
-                 field = field.substr(first, (last - first + 1));
+            ResetEvent(ov.hEvent);
+            if (!ReadDirectoryChangesW(Dir, buffer.data(), WATCH_BUFFER_BYTES, TRUE,
+                    FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE, NULL, &ov, NULL))
+                break;
+
+            DWORD bytes = 0;
+            if (WaitForMultipleObjects(2, waits, FALSE, INFINITE) != WAIT_OBJECT_0 + 1)
+            {
+                // Stop requested: the pending read must finish before the buffer goes away
+                CancelIoEx(Dir, &ov);
+                GetOverlappedResult(Dir, &ov, &bytes, TRUE);
+                CloseHandle(ov.hEvent);
+                return;
             }
+            if (!GetOverlappedResult(Dir, &ov, &bytes, FALSE))
+                break;
+
+            // Zero bytes = the change list overflowed: assume anything changed
+            if (bytes == 0) { Changed = true; continue; }
 
-            values[count] = StringToDouble(field);
-            count++;
-            start = pos + 1;
+            const char* p = (const char*)buffer.data();
+            for (;;)
+            {
+                const FILE_NOTIFY_INFORMATION* info = (const FILE_NOTIFY_INFORMATION*)p;
+                if (IsRelevant(info->FileName, info->FileNameLength / sizeof(wchar_t)))
+                {
+                    Changed = true;
+                    break;
+                }
+                if (info->NextEntryOffset == 0) break;
+                p += info->NextEntryOffset;
+            }
         }
-        pos++;
+
+        // Watch lost (folder removed, share dropped): back to interval polling
+        CloseHandle(ov.hEvent);
+        Changed = true;
+        Active = false;
     }
-    return count;
+};
+
+// =========================
+//   PARALLEL DAY LOADING
+// =========================
+// Closed days with no read state yet (cold start, a longer DaysToLoad) are
+// parsed on the pool (see PARALLEL LOADING), each into a private ViewerData,
+// and merged in day order on the study thread. Tracked files (today's tail,
+// windows moved earlier) and .grid days keep the incremental path.
+
+enum DayFormat { DAY_NONE, DAY_GRID, DAY_ARCHIVE, DAY_GEXB, DAY_CSV };
+
+// Reads one non-grid day file into data (fromMs: chart window start, fieldMask: CSV columns to convert,
+// deadline: CSV parsing budget, binary formats are read whole)
+void LoadViewerDay(DayFormat format, const std::string& path, int tzOffset, long long fromMs, unsigned int fieldMask, ViewerData* data,
+    const LoadDeadline* deadline = nullptr)
+{
+    if (format == DAY_ARCHIVE) LoadViewerArchive(path, tzOffset, fromMs, data); // Closed, compacted day: only frames inside the window
+    else if (format == DAY_GEXB) LoadViewerGexb(path, tzOffset, data);         // Binary columnar twin: mapped, no parsing
+    else if (format == DAY_CSV) LoadViewerCSV(path, tzOffset, fromMs, fieldMask, data, deadline); // Incremental: returns at once when nothing was appended
 }
 
-void LoadViewerCSV(const std::string& fullPath, int tzOffsetHours, ViewerData* data)
+// CSV columns feeding a subgraph that is drawn: bit = base column, bit 16 + f
+// = package field f (any package). Timestamp and zero gamma are always read:
+// every layout carries them.
+unsigned int GetViewerFieldMask(SCStudyInterfaceRef sc)
+{
+    static const int SUBGRAPH_COLUMN[9] = { 3, 4, 2, 5, 6, 10, 11, 7, 8 }; // SG1..SG9
+    auto drawn = [&](int i) { return sc.Subgraph[i].DrawStyle != DRAWSTYLE_HIDDEN && sc.Subgraph[i].DrawStyle != DRAWSTYLE_IGNORE; };
+    unsigned int mask = (1u << 0) | (1u << 2);
+    for (int i = 0; i < 9; ++i)
+        if (drawn(i)) mask |= 1u << SUBGRAPH_COLUMN[i];
+    for (int k = 0; k < VIEWER_MAX_PACKAGES; ++k)
+        for (int f = 0; f < PACKAGE_FIELDS; ++f)
+            if (drawn(PACKAGE_SUBGRAPH + k * PACKAGE_FIELDS + f)) mask |= 1u << (16 + f);
+    return mask;
+}
+
+// =========================
+//     HISTORY PAGING
+// =========================
+// Only the days from today back to the first visible bar are read when the
+// study starts. Older days are paged in on a background thread, a batch at a
+// time, once the chart is scrolled to within PAGE_AHEAD_DAYS of them, and
+// merged on the study thread when the batch is done. Until the visible range
+// and its read-ahead are covered (a scroll while a batch ran, the next batch),
+// the study keeps itself called without ticks. Over the memory budget, the
+// days furthest left of the visible range are evicted again; their files are
+// simply re-read when the chart gets back to them. Grid days are indexed in
+// place and always read.
+
+#define PAGE_AHEAD_DAYS    2   // Days left of the first visible one read ahead of scrolling
+
+struct HistoryPager
 {
-    // Use std::ifstream for flexible seeking
-    std::ifstream file(fullPath);
-    if (!file.is_open()) return;
+    std::string Key;                // Inputs the batch was started for; anything else drops it
+    std::vector<DayFormat> Formats;
+    std::vector<std::string> Paths;
+    std::vector<ViewerData> Chunks;
+    std::atomic<bool> Done{ false };
+    std::atomic<bool> Cancel{ false };
+    std::thread Thread;
+
+    bool Busy() const { return Thread.joinable(); }
 
-    // Check if we have a previous offset for this file
-    std::streampos offset = 0;
-    if (data->FileOffsets.count(fullPath))
+    bool Has(const std::string& path) const
     {
-        offset = data->FileOffsets[fullPath];
+        return Busy() && std::find(Paths.begin(), Paths.end(), path) != Paths.end();
     }
-    
-    // Get current file size
-    file.seekg(0, std::ios::end);
-    std::streampos fileSize = file.tellg();
-    
-    // Logic: 
-    // 1. If fileSize < offset, file was likely truncated/recreated -> Start from 0
-    // 2. If offset == 0, read from start
-    // 3. Otherwise seek to offset
-    if (fileSize < offset) {
-        offset = 0;
+
+    void Start(const std::string& key, const std::vector<DayFormat>& formats, const std::vector<std::string>& paths,
+        int tzOffset, long long fromMs, unsigned int fieldMask)
+    {
+        Key = key;
+        Formats = formats;
+        Paths = paths;
+        Chunks.clear();
+        Chunks.resize(paths.size());
+        Done = false;
+        Thread = std::thread([this, tzOffset, fromMs, fieldMask] {
+            RunPool(Paths.size(), [&](size_t j) {
+                if (!Cancel) LoadViewerDay(Formats[j], Paths[j], tzOffset, fromMs, fieldMask, &Chunks[j]);
+            });
+            Done = true;
+        });
     }
-    
-    file.seekg(offset);
 
-    std::string line;
-    bool isFirstLine = (offset == 0);
+    // True once a batch has finished; its Chunks are then the study thread's
+    bool Collect()
+    {
+        if (!Busy() || !Done) return false;
+        Thread.join();
+        Done = false;
+        return true;
+    }
 
-    while (std::getline(file, line))
+    ~HistoryPager()
     {
-        // Skip empty lines or header if we are starting from 0
-        if (line.empty()) continue;
-        
-        // Remove potential carriage return
-        if (!line.empty() && line.back() == '\r') line.pop_back();
-
-        if (isFirstLine)
-        {
-            isFirstLine = false; 
-            // Simple check for header: if it contains "timestamp" or starts with non-digit (and not a minus sign)
-            if (line.find("timestamp") != std::string::npos || (!line.empty() && !isdigit(line[0]) && line[0] != '-'))
-                continue;
-        }
-
-        double values[15] = {0};
-        int fieldCount = ParseCsvLine(line, values, 15);
-        if (fieldCount < 5) continue;
-
-        double ts = values[0];
-        if (ts <= 0) continue;
-
-        SCDateTime dt((ts + tzOffsetHours * 3600.0) / 86400.0 + 25569.0);
-
-        double spot  = values[1];
-        double zero  = values[2];
-        double posv  = values[3];
-        double negv  = values[4];
-        double posoi = (fieldCount > 5) ? values[5] : 0;
-        double negoi = (fieldCount > 6) ? values[6] : 0;
-        double lng   = (fieldCount > 10) ? values[10] : 0;
-        double sht   = (fieldCount > 11) ? values[11] : 0;
-        double mjp   = (fieldCount > 12) ? values[12] : 0;
-        double mjn   = (fieldCount > 13) ? values[13] : 0;
-        double netv  = (fieldCount > 7)  ? values[7] : 0;
-        double netoi = (fieldCount > 8)  ? values[8] : 0;
-        
-        if (!std::isnan(zero) && zero != 0) { data->zeroMap[dt] = (float)zero; }
-        if (!std::isnan(posv) && posv != 0) { data->posVolMap[dt] = (float)posv; }
-        if (!std::isnan(negv) && negv != 0) { data->negVolMap[dt] = (float)negv; }
-        if (!std::isnan(posoi) && posoi != 0) { data->posOiMap[dt] = (float)posoi; }
-        if (!std::isnan(negoi) && negoi != 0) { data->negOiMap[dt] = (float)negoi; }
-        if (!std::isnan(lng) && lng != 0) { data->longMap[dt] = (float)lng; }
-        if (!std::isnan(sht) && sht != 0) { data->shortMap[dt] = (float)sht; }
-        if (!std::isnan(mjp) && mjp != 0) { data->majPosMap[dt] = (float)mjp; }
-        if (!std::isnan(mjn) && mjn != 0) { data->majNegMap[dt] = (float)mjn; }
-        if (!std::isnan(netv) && netv != 0) { data->netVolMap[dt] = (float)netv; }
-        if (!std::isnan(netoi) && netoi != 0) { data->netOiMap[dt] = (float)netoi; }
-        
+        Cancel = true;
+        if (Thread.joinable()) Thread.join();
     }
-    
-    // Save new offset
-    if (!file.eof() && !file.fail()) {
-        data->FileOffsets[fullPath] = file.tellg();
-    } else {
-        // If we hit EOF (which getline does), clear flags and get position
-        file.clear();
-        data->FileOffsets[fullPath] = file.tellg();
-    }
-}
-
-void ReloadFiles(SCStudyInterfaceRef sc, ViewerData* data, const std::string& baseFolder, const std::string& ticker, int days, int tzOffset)
-{
-    // If config changed, clear everything
-    if (baseFolder != data->LastBasePath || ticker != data->LastTicker || days != data->LastDaysCount)
-    {
-        data->zeroMap.clear();
-        data->posVolMap.clear();
-        data->negVolMap.clear();
-        data->posOiMap.clear();
-        data->negOiMap.clear();
-        data->longMap.clear();
-        data->shortMap.clear();
-        data->majPosMap.clear();
-        data->majNegMap.clear();
-        data->netVolMap.clear();
-        data->netOiMap.clear();
+};
+
+// Drops the rows read from a closed day's file (its LoadedSpan, which need not
+// match the calendar day in the chart's time zone) and the read state of the
+// file, so paging it back in reads the file again
+void EvictViewerDay(ViewerData* data, const std::string& path)
+{
+    auto span = data->LoadedSpans.find(path);
+    if (span != data->LoadedSpans.end() && span->second.From <= span->second.To)
+        data->Series.Erase(span->second.From, std::nextafter(span->second.To, DBL_MAX));
+    data->LoadedSpans.erase(path);
+
+    data->FileOffsets.erase(path);
+    data->FileIds.erase(path);
+    data->PackageColumns.erase(path);
+    data->ColumnSlots.erase(path);
+    data->CsvLoadedFromMs.erase(path);
+    data->ArchiveLoadedFromMs.erase(path);
+}
+
+// What moved is recorded in Series.ChangedFrom and GridChangedFrom
+// visibleDay: day of the first visible bar (0 = today), budgetBytes: series memory kept (0 = no limit)
+// deadline: this call's load budget; with one, closed days all come from the pager (see LOAD BUDGET)
+void ReloadFiles(SCStudyInterfaceRef sc, ViewerData* data, HistoryPager* pager, const std::string& baseFolder, const std::string& ticker,
+    int days, int tzOffset, long long windowStartMs, unsigned int fieldMask, int visibleDay, size_t budgetBytes,
+    const LoadDeadline* deadline)
+{
+    data->LoadPending = false;
+    data->LoadingPath.clear();
+
+    // If config changed (a subgraph shown that was not parsed included), clear everything
+    if (baseFolder != data->LastBasePath || ticker != data->LastTicker || days != data->LastDaysCount || tzOffset != data->LastTzOffset ||
+        fieldMask != data->LastFieldMask)
+    {
+        data->Series.Clear();
         
         data->FileOffsets.clear(); // Reset offsets so we re-read revised files from scratch
+        data->FileIds.clear();
+        data->PackageColumns.clear();
+        data->ColumnSlots.clear();
+        data->ArchiveLoadedFromMs.clear();
+        data->CsvLoadedFromMs.clear();
+        data->LoadedSpans.clear();
+        data->EmptyPages.clear();
+        data->GridDays.clear();
+        data->VisibleDay = -1;
         
         data->LastBasePath = baseFolder;
         data->LastTicker = ticker;
         data->LastDaysCount = days;
+        data->LastTzOffset = tzOffset;
+        data->LastFieldMask = fieldMask;
+    }
+
+    // A finished paging batch is merged first, unless the inputs changed while it ran
+    std::string key = baseFolder + "|" + ticker + "|" + std::to_string(days) + "|" + std::to_string(tzOffset) + "|" +
+                      std::to_string(fieldMask) + "|" + std::to_string(windowStartMs);
+    if (pager->Collect())
+    {
+        if (pager->Key == key)
+        {
+            for (ViewerData& chunk : pager->Chunks)
+                MergeViewerChunk(data, chunk);
+            for (const std::string& path : pager->Paths)
+                if (data->FileOffsets.count(path) == 0 && data->ArchiveLoadedFromMs.count(path) == 0)
+                    data->EmptyPages.insert(path);
+        }
+        pager->Chunks.clear();
+        pager->Paths.clear();
     }
 
     SCDateTime reference = sc.GetCurrentDateTime();
+
+    // The catalog replaces the per-day probes for the days it covers (see DayCatalog::Covers)
+    RefreshDayCatalog(data->Catalog, GetCatalogPath(baseFolder, ticker));
     
-    // Iterate from oldest to newest day
+    // Resolve each day to the file it is read from, oldest to newest
+    std::vector<DayFormat> dayFormats(days, DAY_NONE);
+    std::vector<std::string> dayPaths(days);
     for (int i = days - 1; i >= 0; --i)
     {
         SCDateTime date = SubtractDays(reference, i);
+        int ymd = date.GetYear() * 10000 + date.GetMonth() * 100 + date.GetDay();
+
         std::string suffix = FormatDateSuffix(date);
-        std::string path = baseFolder + "\\Tickers " + suffix + "\\" + ticker + ".csv";
-        
-        if (FileExists(path))
+        std::string dayFolder = baseFolder + "\\Tickers " + suffix + "\\";
+        std::string path = dayFolder + ticker + ".csv";
+        std::string gridPath = dayFolder + ticker + ".grid";
+        std::string gexbPath = dayFolder + ticker + ".gexb";
+        std::string archivePath = dayFolder + ticker + ".gexz";
+
+        // A covered day is taken as listed, the other formats are not probed. A listed
+        // file not read yet is looked for once: if it is gone the catalog missed a
+        // change and the day is probed like an uncovered one (older than the catalog,
+        // or today, which writers list at most once a minute).
+        static const char* formats[] = { "grid", "gexz", "gexb", "csv" };
+        const std::string* formatPaths[] = { &gridPath, &archivePath, &gexbPath, &path };
+        bool trusted = i > 0 && data->Catalog.Covers(ymd);
+        for (int k = 0; k < 4 && trusted; ++k)
+        {
+            const std::string& listedPath = *formatPaths[k];
+            if (data->Catalog.Lists(ymd, formats[k]) && data->FileOffsets.count(listedPath) == 0 &&
+                data->ArchiveLoadedFromMs.count(listedPath) == 0 && !FileExists(listedPath))
+                trusted = false;
+        }
+        auto has = [&](int k) { return trusted ? data->Catalog.Lists(ymd, formats[k]) : FileExists(*formatPaths[k]); };
+
+        // A wall-clock grid holds the same samples as the CSV and is indexed directly
+        if (has(0)) { dayFormats[i] = DAY_GRID; dayPaths[i] = gridPath; }
+        else if (has(1) && data->BadArchives.count(archivePath) == 0) { dayFormats[i] = DAY_ARCHIVE; dayPaths[i] = archivePath; }
+        else if (has(2)) { dayFormats[i] = DAY_GEXB; dayPaths[i] = gexbPath; }
+        else if (has(3)) { dayFormats[i] = DAY_CSV; dayPaths[i] = path; }
+    }
+
+    // Closed days nothing was read from yet: the visible ones go to the pool on the
+    // first load, the rest (and anything scrolled to later) to the pager
+    auto unread = [&](int i) {
+        return dayFormats[i] != DAY_NONE && dayFormats[i] != DAY_GRID && data->EmptyPages.count(dayPaths[i]) == 0 &&
+               data->FileOffsets.count(dayPaths[i]) == 0 && data->ArchiveLoadedFromMs.count(dayPaths[i]) == 0;
+    };
+    int pooledTo = (data->VisibleDay < 0 && !deadline) ? visibleDay : 0;
+    int pagedTo = std::min(days - 1, visibleDay + PAGE_AHEAD_DAYS);
+    std::vector<int> pooledAt(days, -1);
+    std::vector<int> pooledDays;
+    std::vector<DayFormat> pageFormats;
+    std::vector<std::string> pagePaths;
+    for (int i = days - 1; i >= 1; --i)
+    {
+        if (!unread(i) || pager->Has(dayPaths[i]))
+            continue;
+        if (i <= pooledTo)
+        {
+            pooledAt[i] = (int)pooledDays.size();
+            pooledDays.push_back(i);
+        }
+        else if (i <= pagedTo)
+        {
+            pageFormats.push_back(dayFormats[i]);
+            pagePaths.push_back(dayPaths[i]);
+        }
+    }
+    std::vector<ViewerData> chunks;
+    if (pooledDays.size() > 1 && std::thread::hardware_concurrency() > 1)
+    {
+        chunks.resize(pooledDays.size());
+        RunPool(pooledDays.size(), [&](size_t j) {
+            int i = pooledDays[j];
+            LoadViewerDay(dayFormats[i], dayPaths[i], tzOffset, windowStartMs, fieldMask, &chunks[j]);
+        });
+    }
+
+    for (int i = days - 1; i >= 0; --i)
+    {
+        if (dayFormats[i] == DAY_GRID)
+            LoadViewerGrid(dayPaths[i], tzOffset, data);
+        else if (pooledAt[i] >= 0 && !chunks.empty())
+            MergeViewerChunk(data, chunks[pooledAt[i]]);
+        else if (dayFormats[i] != DAY_NONE && (i == 0 || pooledAt[i] >= 0 || !unread(i)))
         {
-            // For older files (i > 0), simple optimization:
-            // If we have already read this file to the end (offset > 0), we assume it doesn't change 
-            // (historical days are closed). 
-            // However, to be safe, we just let the incremental reader check. 
-            // It will see size == offset and return immediately.
-            LoadViewerCSV(path, tzOffset, data);
+            // Out of time: the remaining files wait for the next call
+            if (PastDeadline(deadline)) { data->LoadPending = true; continue; }
+            LoadViewerDay(dayFormats[i], dayPaths[i], tzOffset, windowStartMs, fieldMask, data, deadline);
         }
     }
+
+    // Rows that arrived out of order (an overlapping day) are merged before the chart reads them
+    data->Series.Flush();
+
+    // Damaged archives are reported once; their days are read from the .gexb or .csv from the next reload on
+    for (auto& bad : data->BadArchives)
+    {
+        if (bad.second) continue;
+        bad.second = true;
+        data->LoadPending = true;
+        SCString msg;
+        msg.Format("GexViewer: %s could not be read, using the day's .gexb/.csv instead", bad.first.c_str());
+        sc.AddMessageToLog(msg, 1);
+    }
+
+    // Days left of the visible range: one batch in flight at a time, the rest follow on later calls
+    if (!pageFormats.empty() && !pager->Busy())
+        pager->Start(key, pageFormats, pagePaths, tzOffset, windowStartMs, fieldMask);
+
+    // Over budget: evict from the oldest day on, never the visible range or its read-ahead
+    for (int i = days - 1; i > pagedTo && budgetBytes > 0 && data->Series.Bytes() > budgetBytes; --i)
+    {
+        if (dayFormats[i] != DAY_NONE && dayFormats[i] != DAY_GRID && !unread(i))
+            EvictViewerDay(data, dayPaths[i]);
+    }
+
+    data->FirstUnreadDay = -1;
+    for (int i = 1; i < days && data->FirstUnreadDay < 0; ++i)
+        if (unread(i) && !pager->Has(dayPaths[i])) data->FirstUnreadDay = i;
+    data->VisibleDay = visibleDay;
 }
 
-float GetValue(const std::map<SCDateTime, float>& map, SCDateTime targetTime, int chartTzOffsetHours)
+bool IsWithinMarketHours(SCDateTime targetTime, int chartTzOffsetHours)
 {
     // Time Filter: Don't draw outside US market hours (09:30 - 16:00 EST)
     // Adjust the filter window based on the chart's timezone offset from EST (-5)
@@ -263,23 +2111,69 @@ float GetValue(const std::map<SCDateTime, float>& map, SCDateTime targetTime, in
     int marketClose = HMS_TIME(16 + shiftHours, 0, 0);
     
     int time = targetTime.GetTime();
-    if (time < marketOpen || time > marketClose)
+    return time >= marketOpen && time <= marketClose;
+}
+
+// row = series.Seek(targetTime, ...), looked up once per bar for every series
+float GetValue(const SeriesStore& series, size_t row, int s, SCDateTime targetTime, int chartTzOffsetHours)
+{
+    if (!IsWithinMarketHours(targetTime, chartTzOffsetHours))
         return -FLT_MAX;
 
-    if (map.empty()) return -FLT_MAX;
-    auto it = map.upper_bound(targetTime);
-    if (it == map.begin()) return -FLT_MAX;
-    --it;
-    
+    if (row == SeriesStore::NONE) return -FLT_MAX;
+
     // Check if the data point is from a previous day (don't connect yesterday's close to today's open)
-    if (it->first.GetDate() != targetTime.GetDate())
+    if (SCDateTime(series.Times[row]).GetDate() != targetTime.GetDate())
+        return -FLT_MAX;
+
+    // Forward fill indefinitely within the same day (done on insert)
+    float v = series.Value(row, s);
+    return std::isnan(v) ? -FLT_MAX : v;
+}
+
+// O(1) grid lookup: the slot index is computed from the bar time, no search
+float GetGridValue(const GridDay& grid, int field, SCDateTime targetTime, int chartTzOffsetHours)
+{
+    if (!IsWithinMarketHours(targetTime, chartTzOffsetHours) || grid.LoadedSlots == 0 || field >= grid.FieldCount)
         return -FLT_MAX;
 
-    // Forward fill indefinitely within the same day
-    return it->second;
+    double unixTs = (targetTime.GetAsDouble() - 25569.0) * 86400.0 - chartTzOffsetHours * 3600.0;
+    long long slot = (long long)floor((unixTs - grid.SessionOpenUnix) / grid.StrideSec + 1e-6);
+    if (slot < 0) return -FLT_MAX;
+    if (slot >= grid.LoadedSlots) slot = grid.LoadedSlots - 1; // Forward fill past the last committed slot
+
+    float v = grid.Values[(size_t)slot * grid.FieldCount + field];
+    return std::isnan(v) ? -FLT_MAX : v;
 }
 
 
+// Chart text at the top left while history is still loading; empty text removes it
+void ShowLoadProgress(SCStudyInterfaceRef sc, ViewerData* data, const std::string& text)
+{
+    if (text == data->ShownProgress) return;
+    data->ShownProgress = text;
+    if (text.empty())
+    {
+        sc.DeleteACSChartDrawing(sc.ChartNumber, TOOL_DELETE_CHARTDRAWING, LOAD_PROGRESS_LINE + sc.StudyGraphInstanceID);
+        return;
+    }
+
+    s_UseTool tool;
+    tool.Clear();
+    tool.ChartNumber = sc.ChartNumber;
+    tool.DrawingType = DRAWING_TEXT;
+    tool.LineNumber = LOAD_PROGRESS_LINE + sc.StudyGraphInstanceID;
+    tool.AddMethod = UTAM_ADD_OR_ADJUST;
+    tool.Region = sc.GraphRegion;
+    tool.UseRelativeVerticalValues = 1;
+    tool.BeginDateTime = 2;     // % from the left
+    tool.BeginValue = 97;       // % from the bottom
+    tool.Color = RGB(252, 177, 3);
+    tool.FontSize = 9;
+    tool.Text = text.c_str();
+    sc.UseTool(tool);
+}
+
 // =========================
 //      MAIN STUDY
 // =========================
@@ -296,12 +2190,20 @@ SCSFExport scsf_GexBotCSVViewer(SCStudyInterfaceRef sc)
     SCSubgraphRef SG7_Short = sc.Subgraph[6];
     SCSubgraphRef SG8_NetVol = sc.Subgraph[7];
     SCSubgraphRef SG9_NetOI = sc.Subgraph[8];
+    // Daily Summary Mode only
+    SCSubgraphRef SG10_ZeroHigh = sc.Subgraph[9];
+    SCSubgraphRef SG11_ZeroLow = sc.Subgraph[10];
+    SCSubgraphRef SG12_AboveZeroPct = sc.Subgraph[11];
+    SCSubgraphRef SG13_WallMoves = sc.Subgraph[12];
 
     SCInputRef TickerInput = sc.Input[0];
     SCInputRef CsvPathInput = sc.Input[1];
     SCInputRef RefreshInterval = sc.Input[2];
     SCInputRef DaysToLoad = sc.Input[3];
     SCInputRef TZOffset = sc.Input[4];
+    SCInputRef SummaryModeInput = sc.Input[5];
+    SCInputRef HistoryBudgetMB = sc.Input[6];
+    SCInputRef LoadBudgetMs = sc.Input[7];
 
     if (sc.SetDefaults)
     {
@@ -324,12 +2226,42 @@ SCSFExport scsf_GexBotCSVViewer(SCStudyInterfaceRef sc)
         // Hidden by default - different scale than price levels
         SG8_NetVol.Name = "Net GEX (Vol)"; SG8_NetVol.DrawStyle = DRAWSTYLE_HIDDEN; SG8_NetVol.PrimaryColor = RGB(200, 200, 200);
         SG9_NetOI.Name = "Net GEX (OI)"; SG9_NetOI.DrawStyle = DRAWSTYLE_HIDDEN; SG9_NetOI.PrimaryColor = RGB(150, 150, 150);
+
+        // Daily Summary Mode: zero gamma range per bar; percent above zero and wall moves use their own scale
+        SG10_ZeroHigh.Name = "Zero Gamma High (Summary)"; SG10_ZeroHigh.DrawStyle = DRAWSTYLE_DASH; SG10_ZeroHigh.PrimaryColor = RGB(252, 220, 120); SG10_ZeroHigh.LineWidth = 1;
+        SG11_ZeroLow.Name = "Zero Gamma Low (Summary)"; SG11_ZeroLow.DrawStyle = DRAWSTYLE_DASH; SG11_ZeroLow.PrimaryColor = RGB(180, 120, 0); SG11_ZeroLow.LineWidth = 1;
+        SG12_AboveZeroPct.Name = "% Time Above Zero Gamma (Summary)"; SG12_AboveZeroPct.DrawStyle = DRAWSTYLE_HIDDEN; SG12_AboveZeroPct.PrimaryColor = RGB(200, 200, 200);
+        SG13_WallMoves.Name = "Vol Wall Moves (Summary)"; SG13_WallMoves.DrawStyle = DRAWSTYLE_HIDDEN; SG13_WallMoves.PrimaryColor = RGB(150, 150, 150);
+
+        // Extra packages (dual package setup): each one on its own lines, hidden until picked
+        static const char* PACKAGE_SUBGRAPH_NAMES[PACKAGE_FIELDS] = {
+            "Zero Gamma", "Major Call Gamma (Vol)", "Major Put Gamma (Vol)", "Major Call Gamma (OI)", "Major Put Gamma (OI)",
+            "Major Long Gamma", "Major Short Gamma"
+        };
+        static const COLORREF PACKAGE_SUBGRAPH_COLORS[PACKAGE_FIELDS] = {
+            RGB(252, 177, 3), RGB(0, 159, 0), RGB(174, 0, 0), RGB(0, 255, 255), RGB(255, 165, 0), RGB(0, 255, 255), RGB(174, 74, 213)
+        };
+        for (int k = 0; k < VIEWER_MAX_PACKAGES; ++k)
+        {
+            for (int f = 0; f < PACKAGE_FIELDS; ++f)
+            {
+                SCSubgraphRef sg = sc.Subgraph[PACKAGE_SUBGRAPH + k * PACKAGE_FIELDS + f];
+                sg.Name.Format("Extra Package %d %s", k + 1, PACKAGE_SUBGRAPH_NAMES[f]);
+                sg.DrawStyle = DRAWSTYLE_HIDDEN;
+                sg.PrimaryColor = PACKAGE_SUBGRAPH_COLORS[f];
+                sg.LineWidth = 1;
+                sg.DrawZeros = 0;
+            }
+        }
         
         TickerInput.Name = "Ticker"; TickerInput.SetString("ES_SPX");
         CsvPathInput.Name = "Local CSV Path"; CsvPathInput.SetString("C:\\GexBot\\Data");
-        RefreshInterval.Name = "Refresh Interval (sec)"; RefreshInterval.SetInt(10);
+        RefreshInterval.Name = "Refresh Interval (sec, unwatched folders)"; RefreshInterval.SetInt(10);
         DaysToLoad.Name = "Days to Load"; DaysToLoad.SetInt(2);
         TZOffset.Name = "Chart TZ Override (99=Auto)"; TZOffset.SetInt(99); // 99=auto-detect, 0=UTC, -5=EST
+        SummaryModeInput.Name = "Daily Summary Mode (Daily/Weekly Charts)"; SummaryModeInput.SetYesNo(0);
+        HistoryBudgetMB.Name = "History Memory Budget (MB, 0=No Limit)"; HistoryBudgetMB.SetInt(512);
+        LoadBudgetMs.Name = "Load Time per Update (ms, 0=All at Once)"; LoadBudgetMs.SetInt(20);
 
         return;
     }
@@ -343,7 +2275,26 @@ SCSFExport scsf_GexBotCSVViewer(SCStudyInterfaceRef sc)
     }
     if (sc.LastCallToFunction)
     {
-        if (data) { delete data; sc.SetPersistentPointer(1, nullptr); }
+        DirectoryWatcher* watcher = (DirectoryWatcher*)sc.GetPersistentPointer(2);
+        if (watcher)
+        {
+            delete watcher;
+            sc.SetPersistentPointer(2, nullptr);
+        }
+        HistoryPager* pager = (HistoryPager*)sc.GetPersistentPointer(3);
+        if (pager)
+        {
+            delete pager; // Cancels the batch and waits for the day being read
+            sc.SetPersistentPointer(3, nullptr);
+        }
+        if (data)
+        {
+            // Next start restores this instead of re-parsing every day
+            if (data->Series.Size() != data->CacheSavedRows)
+                SaveViewerCache(GetViewerCachePath(data->LastBasePath, data->LastTicker), data);
+            delete data;
+            sc.SetPersistentPointer(1, nullptr);
+        }
         return;
     }
 
@@ -354,46 +2305,200 @@ SCSFExport scsf_GexBotCSVViewer(SCStudyInterfaceRef sc)
     // This ensures all bars processed in this cycle have access to data.
     if (sc.Index == sc.UpdateStartIndex)
     {
+        // One watcher per data root and ticker (see CHANGE WATCHER)
+        DirectoryWatcher* watcher = (DirectoryWatcher*)sc.GetPersistentPointer(2);
+        if (!watcher || watcher->Folder != CsvPathInput.GetString() || watcher->Ticker != TickerInput.GetString())
+        {
+            delete watcher;
+            watcher = new DirectoryWatcher();
+            watcher->Start(CsvPathInput.GetString(), TickerInput.GetString());
+            sc.SetPersistentPointer(2, watcher);
+        }
+
+        // Watched: files are only touched after a change (or when the chart reloaded, the window may have moved).
+        // The flag is lowered before the load so a write during it is picked up next time.
         double timeSinceLast = (sc.CurrentSystemDateTime - data->LastUpdate).GetAsDouble() * 86400.0;
-        bool needsLoad = (data->LastUpdate.GetAsDouble() == 0.0 || timeSinceLast >= RefreshInterval.GetInt());
+        bool needsLoad;
+        if (watcher->Active)
+            needsLoad = watcher->Changed.exchange(false) || data->LastUpdate.GetAsDouble() == 0.0 || sc.IsFullRecalculation;
+        else
+            needsLoad = (data->LastUpdate.GetAsDouble() == 0.0 || timeSinceLast >= RefreshInterval.GetInt());
+
+        HistoryPager* pager = (HistoryPager*)sc.GetPersistentPointer(3);
+        if (!pager)
+        {
+            pager = new HistoryPager();
+            sc.SetPersistentPointer(3, pager);
+        }
+
+        // Day of the first visible bar (0 = today); scrolling further left, or a finished
+        // paging batch, loads too (see HISTORY PAGING)
+        int visibleDay = 0;
+        if (sc.IndexOfFirstVisibleBar > 0 && sc.IndexOfFirstVisibleBar < sc.ArraySize)
+            visibleDay = sc.GetCurrentDateTime().GetDate() - sc.BaseDateTimeIn[sc.IndexOfFirstVisibleBar].GetDate();
+        visibleDay = std::max(0, std::min(visibleDay, DaysToLoad.GetInt() - 1));
+
+        // Days of the visible range or its read-ahead still unread (scrolled to while a batch ran,
+        // or evicted): queued as soon as the pager is free
+        bool uncovered = data->FirstUnreadDay >= 0 && data->FirstUnreadDay <= visibleDay + PAGE_AHEAD_DAYS;
+        bool pageNeeded = pager->Done || visibleDay > data->VisibleDay || data->LoadPending || (uncovered && !pager->Busy());
         
-        if (needsLoad)
+        if (needsLoad && SummaryModeInput.GetYesNo())
+        {
+            // One small file instead of every intraday row
+            size_t prevCount = data->Summaries.size();
+            data->Summaries.clear();
+            ReadSummaries(GetSummaryPath(CsvPathInput.GetString(), TickerInput.GetString()), data->Summaries);
+            std::sort(data->Summaries.begin(), data->Summaries.end(),
+                [](const DaySummary& a, const DaySummary& b) { return a.Date < b.Date; });
+            data->LastUpdate = sc.CurrentSystemDateTime;
+
+            if (data->Summaries.size() != prevCount && sc.UpdateStartIndex > 0)
+                sc.UpdateStartIndex = 0;
+        }
+        else if (!SummaryModeInput.GetYesNo() && (needsLoad || pageNeeded))
         {
-            size_t prevSize = data->zeroMap.size();
             // Auto-detect chart timezone or use manual override
             int tzOff = TZOffset.GetInt();
             if (tzOff == 99)
                 tzOff = (int)(sc.TimeScaleAdjustment.GetAsDouble() * 24.0); // auto-detect from chart settings
             
-            ReloadFiles(sc, data, CsvPathInput.GetString(), TickerInput.GetString(), DaysToLoad.GetInt(), tzOff);
+            // Earliest bar on the chart, as Unix ms (archived days are decoded from there on)
+            long long windowStartMs = (long long)(((sc.BaseDateTimeIn[0].GetAsDouble() - 25569.0) * 86400.0 - tzOff * 3600.0) * 1000.0);
+
+            // Only the CSV columns behind drawn subgraphs are converted
+            unsigned int fieldMask = GetViewerFieldMask(sc);
+
+            // Cold start: restore the last snapshot, ReloadFiles then only tails what was appended since
+            std::string cachePath = GetViewerCachePath(CsvPathInput.GetString(), TickerInput.GetString());
+            if (data->LastUpdate.GetAsDouble() == 0.0 && data->Series.Empty() &&
+                LoadViewerCache(cachePath, CsvPathInput.GetString(), TickerInput.GetString(), DaysToLoad.GetInt(), tzOff, fieldMask, data))
+                data->CacheSavedRows = data->Series.Size();
+
+            size_t budgetBytes = (size_t)std::max(0, HistoryBudgetMB.GetInt()) << 20;
+            LoadDeadline deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(LoadBudgetMs.GetInt());
+            ReloadFiles(sc, data, pager, CsvPathInput.GetString(), TickerInput.GetString(), DaysToLoad.GetInt(), tzOff,
+                windowStartMs, fieldMask, visibleDay, budgetBytes, LoadBudgetMs.GetInt() > 0 ? &deadline : nullptr);
             data->LastUpdate = sc.CurrentSystemDateTime;
+
+            if ((sc.CurrentSystemDateTime - data->LastCacheSave).GetAsDouble() * 86400.0 >= VIEWER_CACHE_SAVE_SEC)
+            {
+                size_t rows = data->Series.Size();
+                if (rows != data->CacheSavedRows && SaveViewerCache(cachePath, data))
+                    data->CacheSavedRows = rows;
+                data->LastCacheSave = sc.CurrentSystemDateTime;
+            }
             
-            // If data was loaded/changed and we're not starting from bar 0,
-            // force a full recalculation so ALL bars get drawn, not just new ones.
-            if (data->zeroMap.size() != prevSize && sc.UpdateStartIndex > 0)
+            // If data was loaded/changed, redraw from the first bar it can affect: a row
+            // appended at the tail only touches the last bar or two, not the whole chart.
+            double changedFrom = std::min(data->Series.ChangedFrom, data->GridChangedFrom);
+            data->Series.ChangedFrom = DBL_MAX;
+            data->GridChangedFrom = DBL_MAX;
+            if (changedFrom < DBL_MAX && sc.UpdateStartIndex > 0)
             {
-                sc.UpdateStartIndex = 0;
+                int firstBar = (changedFrom == -DBL_MAX) ? 0 : sc.GetContainingIndexForSCDateTime(sc.ChartNumber, SCDateTime(changedFrom));
+                sc.UpdateStartIndex = std::max(0, std::min(sc.UpdateStartIndex, firstBar));
+            }
+        }
+
+        // Progress while history is still coming in: the read this call stopped in, the pager's batch
+        std::string progress;
+        if (!SummaryModeInput.GetYesNo() && (data->LoadPending || pager->Busy()))
+        {
+            char buffer[128];
+            progress = "GexBot: loading history";
+            size_t folder = data->LoadingPath.find("Tickers ");
+            if (folder != std::string::npos)
+            {
+                std::string day = data->LoadingPath.substr(folder + 8, data->LoadingPath.find('\\', folder) - folder - 8);
+                snprintf(buffer, sizeof(buffer), " - %s %d%%", day.c_str(), data->LoadingPercent);
+                progress += buffer;
+            }
+            if (pager->Busy())
+            {
+                snprintf(buffer, sizeof(buffer), " - %d day(s) in background", (int)pager->Paths.size());
+                progress += buffer;
             }
         }
+        ShowLoadProgress(sc, data, progress);
+
+        // Calls without ticks only while history is still coming in or the visible range is not
+        // covered yet, so a finished batch, the next one or the rest of a budgeted read goes on
+        // without waiting for a trade; off again once the pager has caught up
+        uncovered = data->FirstUnreadDay >= 0 && data->FirstUnreadDay <= visibleDay + PAGE_AHEAD_DAYS;
+        bool pending = !progress.empty() || (!SummaryModeInput.GetYesNo() && uncovered);
+        sc.UpdateAlways = pending ? 1 : 0;
     }
     
     // ================================================================
     // RENDER LOGIC (Every Bar)
     // ================================================================
     SCDateTime now = sc.BaseDateTimeIn[sc.Index];
+
+    if (SummaryModeInput.GetYesNo())
+    {
+        // Sessions from this bar's date up to (not including) the next bar's: one day on a daily chart, a week on a weekly one
+        int fromYmd = now.GetYear() * 10000 + now.GetMonth() * 100 + now.GetDay();
+        int toYmd = INT_MAX;
+        if (sc.Index + 1 < sc.ArraySize)
+        {
+            SCDateTime next = sc.BaseDateTimeIn[sc.Index + 1];
+            toYmd = next.GetYear() * 10000 + next.GetMonth() * 100 + next.GetDay();
+        }
+
+        auto it = std::lower_bound(data->Summaries.begin(), data->Summaries.end(), fromYmd,
+            [](const DaySummary& d, int ymd) { return d.Date < ymd; });
+        const DaySummary* last = nullptr;
+        float zeroHigh = -FLT_MAX, zeroLow = FLT_MAX;
+        long long above = 0, below = 0;
+        int moves = 0;
+        for (; it != data->Summaries.end() && it->Date < toYmd; ++it)
+        {
+            if (it->ZeroClose == 0) continue;
+            last = &*it;
+            zeroHigh = std::max(zeroHigh, (float)it->ZeroHigh);
+            zeroLow = std::min(zeroLow, (float)it->ZeroLow);
+            above += it->SecAboveZero;
+            below += it->SecBelowZero;
+            moves += it->PosVolMoves + it->NegVolMoves;
+        }
+        if (!last) return;
+
+        // Levels as of the last session in the bar
+        SG3_Zero[sc.Index] = (float)last->ZeroClose;
+        if (last->PosVolClose != 0) SG1_CallVol[sc.Index] = (float)last->PosVolClose;
+        if (last->NegVolClose != 0) SG2_PutVol[sc.Index] = (float)last->NegVolClose;
+        if (last->PosOiClose != 0) SG4_CallOI[sc.Index] = (float)last->PosOiClose;
+        if (last->NegOiClose != 0) SG5_PutOI[sc.Index] = (float)last->NegOiClose;
+        SG10_ZeroHigh[sc.Index] = zeroHigh;
+        SG11_ZeroLow[sc.Index] = zeroLow;
+        if (above + below > 0) SG12_AboveZeroPct[sc.Index] = (float)(100.0 * above / (above + below));
+        SG13_WallMoves[sc.Index] = (float)moves;
+        return;
+    }
+
     int tzOff = TZOffset.GetInt();
     if (tzOff == 99)
         tzOff = (int)(sc.TimeScaleAdjustment.GetAsDouble() * 24.0); // auto-detect from chart settings
 
-    float vZero = GetValue(data->zeroMap, now, tzOff);
-    float vPosVol = GetValue(data->posVolMap, now, tzOff);
-    float vNegVol = GetValue(data->negVolMap, now, tzOff);
-    float vPosOi = GetValue(data->posOiMap, now, tzOff);
-    float vNegOi = GetValue(data->negOiMap, now, tzOff);
-    float vLong = GetValue(data->longMap, now, tzOff);
-    float vShort = GetValue(data->shortMap, now, tzOff);
-    float vNetVol = GetValue(data->netVolMap, now, tzOff); 
-    float vNetOi = GetValue(data->netOiMap, now, tzOff);
+    // Days recorded on a wall-clock grid are indexed directly, others share one row,
+    // found by stepping on from the previous bar's
+    auto gridIt = data->GridDays.find(now.GetDate());
+    const GridDay* grid = (gridIt != data->GridDays.end()) ? &gridIt->second : nullptr;
+    size_t row = grid ? SeriesStore::NONE : data->Series.Seek(now.GetAsDouble(), data->BarCursor);
+    auto getVal = [&](int series, int field) -> float {
+        return grid ? GetGridValue(*grid, field, now, tzOff) : GetValue(data->Series, row, series, now, tzOff);
+    };
+
+    float vZero = getVal(VS_ZERO, GF_ZERO);
+    float vPosVol = getVal(VS_POS_VOL, GF_POS_VOL);
+    float vNegVol = getVal(VS_NEG_VOL, GF_NEG_VOL);
+    float vPosOi = getVal(VS_POS_OI, GF_POS_OI);
+    float vNegOi = getVal(VS_NEG_OI, GF_NEG_OI);
+    float vLong = getVal(VS_LONG, GF_LONG);
+    float vShort = getVal(VS_SHORT, GF_SHORT);
+    float vNetVol = getVal(VS_NET_VOL, GF_NET_VOL); 
+    float vNetOi = getVal(VS_NET_OI, GF_NET_OI);
     
     if (vPosVol != -FLT_MAX) SG1_CallVol[sc.Index] = vPosVol;
     if (vNegVol != -FLT_MAX) SG2_PutVol[sc.Index] = vNegVol;
@@ -404,5 +2509,14 @@ SCSFExport scsf_GexBotCSVViewer(SCStudyInterfaceRef sc)
     if (vShort != -FLT_MAX) SG7_Short[sc.Index] = vShort;
     if (vNetVol != -FLT_MAX) SG8_NetVol[sc.Index] = vNetVol;
     if (vNetOi != -FLT_MAX) SG9_NetOI[sc.Index] = vNetOi;
+
+    for (int k = 0; k < VIEWER_MAX_PACKAGES; ++k)
+    {
+        for (int f = 0; f < PACKAGE_FIELDS; ++f)
+        {
+            float v = getVal(VS_PACKAGE + k * PACKAGE_FIELDS + f, GF_PACKAGE + k * PACKAGE_FIELDS + f);
+            if (v != -FLT_MAX) sc.Subgraph[PACKAGE_SUBGRAPH + k * PACKAGE_FIELDS + f][sc.Index] = v;
+        }
+    }
     
 }
@@ -1,13 +1,19 @@
 #include "sierrachart.h"
 #include <string>
 #include <sstream>
+#include <fstream>
 #include <vector>
+#include <map>
+#include <algorithm>
 #include <iomanip>
+#include <cmath>
+#include <cfloat>
+#include <limits>
 #include <windows.h>
 
 SCDLLName("GEX_DATA_COLLECTOR")
 
-#define COLLECTOR_VERSION "2.1.0"  // 2026-02-12: Fixed subgraph mapping, debug toggle
+#define COLLECTOR_VERSION "2.8.6"  // 2026-10-18: Summary updates hold <summary>.lock and use their own temp file
 
 // =========================
 //     FILE I/O HELPERS
@@ -43,6 +49,1198 @@ bool FileExists(const std::string& path)
     return (dwAttrib != INVALID_FILE_ATTRIBUTES && !(dwAttrib & FILE_ATTRIBUTE_DIRECTORY));
 }
 
+bool GetFileSize64(const std::string& path, unsigned long long& size)
+{
+    std::wstring wPath(path.begin(), path.end());
+    WIN32_FILE_ATTRIBUTE_DATA info;
+    if (!GetFileAttributesExW(wPath.c_str(), GetFileExInfoStandard, &info)) return false;
+    size = ((unsigned long long)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+    return true;
+}
+
+// =========================
+//     COMMIT PROTOCOL
+// =========================
+// After every flush the writer publishes the byte length of fully written rows
+// in "<file>.commit". Readers never parse past it, so a half-flushed row is
+// never seen and the next read resumes exactly at the committed offset.
+
+#define COMMIT_MAGIC   0x4D435847u  // "GXCM"
+#define COMMIT_VERSION 1u
+
+struct CommitRecord
+{
+    unsigned int Magic;
+    unsigned int Version;
+    unsigned long long CommittedBytes;
+    unsigned long long RowCount;
+    unsigned long long Checksum;    // Detects a torn record (never expected, 32 bytes in one sector)
+};
+
+unsigned long long CommitChecksum(const CommitRecord& rec)
+{
+    return (rec.CommittedBytes * 0x9E3779B97F4A7C15ull) ^ (rec.RowCount + 0x632BE59BD9B4E019ull) ^ rec.Magic;
+}
+
+bool ReadCommitRecord(const std::string& dataPath, CommitRecord& rec)
+{
+    std::string commitPath = dataPath + ".commit";
+    std::wstring wPath(commitPath.begin(), commitPath.end());
+    HANDLE h = CreateFileW(wPath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return false;
+
+    DWORD bytesRead = 0;
+    BOOL ok = ReadFile(h, &rec, sizeof(rec), &bytesRead, NULL);
+    CloseHandle(h);
+
+    return ok && bytesRead == sizeof(rec) && rec.Magic == COMMIT_MAGIC &&
+        rec.Version == COMMIT_VERSION && rec.Checksum == CommitChecksum(rec);
+}
+
+// Writes committedBytes / rowCount as dataPath's commit record
+void WriteCommitRecord(const std::string& dataPath, unsigned long long committedBytes, unsigned long long rowCount)
+{
+    CommitRecord rec;
+    rec.Magic = COMMIT_MAGIC;
+    rec.Version = COMMIT_VERSION;
+    rec.CommittedBytes = committedBytes;
+    rec.RowCount = rowCount;
+    rec.Checksum = CommitChecksum(rec);
+
+    // Single in-place write of one small record: readers see either the old or the new one
+    std::string commitPath = dataPath + ".commit";
+    std::wstring wPath(commitPath.begin(), commitPath.end());
+    HANDLE h = CreateFileW(wPath.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return;
+
+    DWORD bytesWritten = 0;
+    WriteFile(h, &rec, sizeof(rec), &bytesWritten, NULL);
+    CloseHandle(h);
+}
+
+// Publish the current length of dataPath as committed. Called after the rows
+// have been written and the data file closed. freshFile ignores a stale record
+// left over from a previous file at the same path.
+void PublishCommit(const std::string& dataPath, unsigned long long rowsAppended, bool freshFile)
+{
+    unsigned long long fileSize = 0;
+    if (!GetFileSize64(dataPath, fileSize)) return;
+
+    CommitRecord prev;
+    unsigned long long prevRows = 0;
+    if (!freshFile && ReadCommitRecord(dataPath, prev) && prev.CommittedBytes <= fileSize)
+        prevRows = prev.RowCount;
+
+    WriteCommitRecord(dataPath, fileSize, prevRows + rowsAppended);
+}
+
+// =========================
+//     TIME-SEEK INDEX
+// =========================
+// "<file>.idx" holds a small header and then one (Unix ms, byte offset) entry
+// for the first row of every minute. Readers binary-search it for the start of
+// their time window and begin parsing there, not at byte 0. An entry is only
+// appended after its row has been committed.
+
+#define CSV_INDEX_MAGIC   0x58495847u  // "GXIX"
+#define CSV_INDEX_VERSION 1u
+#define CSV_INDEX_STEP_MS 60000
+
+struct CsvIndexHeader
+{
+    unsigned int Magic;
+    unsigned int Version;
+};
+
+struct CsvIndexEntry
+{
+    long long TsMs;             // Timestamp of the row starting at Offset
+    unsigned long long Offset;  // Byte offset of that row in the CSV
+};
+
+// Adds an entry for the row at rowOffset if it opens a new minute. freshFile
+// starts a new index (the CSV was just created).
+void AppendCsvIndex(const std::string& csvPath, long long tsMs, unsigned long long rowOffset, bool freshFile)
+{
+    std::string idxPath = csvPath + ".idx";
+    std::wstring wPath(idxPath.begin(), idxPath.end());
+    HANDLE h = CreateFileW(wPath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, freshFile ? CREATE_ALWAYS : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(h, &size)) { CloseHandle(h); return; }
+
+    DWORD bytes = 0;
+    CsvIndexHeader hdr = { CSV_INDEX_MAGIC, CSV_INDEX_VERSION };
+    unsigned long long end = sizeof(hdr);
+    if ((unsigned long long)size.QuadPart < sizeof(hdr))
+    {
+        WriteFile(h, &hdr, sizeof(hdr), &bytes, NULL);
+    }
+    else
+    {
+        CsvIndexHeader existing;
+        if (!ReadFile(h, &existing, sizeof(existing), &bytes, NULL) || bytes != sizeof(existing) ||
+            existing.Magic != CSV_INDEX_MAGIC || existing.Version != CSV_INDEX_VERSION)
+        {
+            CloseHandle(h);
+            return;
+        }
+
+        // Whole entries only: a torn tail is overwritten
+        unsigned long long count = ((unsigned long long)size.QuadPart - sizeof(hdr)) / sizeof(CsvIndexEntry);
+        end = sizeof(hdr) + count * sizeof(CsvIndexEntry);
+        if (count > 0)
+        {
+            CsvIndexEntry last;
+            LARGE_INTEGER pos;
+            pos.QuadPart = (LONGLONG)(end - sizeof(CsvIndexEntry));
+            SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+            if (ReadFile(h, &last, sizeof(last), &bytes, NULL) && bytes == sizeof(last) &&
+                (tsMs / CSV_INDEX_STEP_MS <= last.TsMs / CSV_INDEX_STEP_MS || rowOffset <= last.Offset))
+            {
+                CloseHandle(h);
+                return;
+            }
+        }
+    }
+
+    CsvIndexEntry entry = { tsMs, rowOffset };
+    LARGE_INTEGER pos;
+    pos.QuadPart = (LONGLONG)end;
+    SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+    WriteFile(h, &entry, sizeof(entry), &bytes, NULL);
+    CloseHandle(h);
+}
+
+// Whole index for a rewritten CSV (backfill merge), swapped in atomically
+bool WriteCsvIndex(const std::string& csvPath, const std::vector<CsvIndexEntry>& entries)
+{
+    CsvIndexHeader hdr = { CSV_INDEX_MAGIC, CSV_INDEX_VERSION };
+    std::string out((const char*)&hdr, sizeof(hdr));
+    if (!entries.empty())
+        out.append((const char*)entries.data(), entries.size() * sizeof(CsvIndexEntry));
+
+    std::string idxPath = csvPath + ".idx";
+    std::string tmpPath = idxPath + ".tmp";
+    std::wstring wTmp(tmpPath.begin(), tmpPath.end());
+    std::wstring wPath(idxPath.begin(), idxPath.end());
+    HANDLE h = CreateFileW(wTmp.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return false;
+
+    DWORD bytes = 0;
+    BOOL ok = WriteFile(h, out.data(), (DWORD)out.size(), &bytes, NULL) && bytes == out.size();
+    CloseHandle(h);
+
+    if (!ok || !MoveFileExW(wTmp.c_str(), wPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        DeleteFileW(wTmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+// =========================
+//    FIXED-STRIDE GRID
+// =========================
+// In wall-clock grid mode every sample lands in slot k = (t - open) / stride of
+// "<Ticker>.grid". The file is preallocated NaN-filled for the whole session,
+// so it has a fixed size per day, stores no timestamps, and readers index a
+// slot directly instead of searching. A slot is GRID_FIELDS floats followed by
+// PACKAGE_FIELDS per extra source package (header FieldCount).
+
+#define GRID_MAGIC   0x44475847u  // "GXGD"
+#define GRID_VERSION 1u
+#define GRID_FIELDS  14           // Base CSV columns after timestamp: spot ... net
+
+struct GridHeader
+{
+    unsigned int Magic;
+    unsigned int Version;
+    long long SessionOpenUnix;    // Unix seconds of slot 0
+    int StrideSec;
+    int SlotCount;
+    int FieldCount;
+    int CommittedSlots;           // High-water mark, bumped only after the slot itself is written
+};
+
+struct GridSlotWrite
+{
+    int Slot;
+    std::vector<float> Fields;  // fieldCount values
+};
+
+// Writes a batch of slots with one open/close. The header high-water mark is
+// updated last, after all slot payloads are on disk.
+bool WriteGridSlots(const std::string& gridPath, long long sessionOpenUnix, int strideSec, int slotCount, int fieldCount,
+    const std::vector<GridSlotWrite>& writes)
+{
+    std::wstring wPath(gridPath.begin(), gridPath.end());
+    HANDLE h = CreateFileW(wPath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return false;
+
+    GridHeader hdr;
+    DWORD bytes = 0;
+    bool haveHeader = ReadFile(h, &hdr, sizeof(hdr), &bytes, NULL) && bytes == sizeof(hdr) && hdr.Magic == GRID_MAGIC;
+
+    if (!haveHeader)
+    {
+        // New day: preallocate the full session with NaN (= no sample)
+        hdr.Magic = GRID_MAGIC;
+        hdr.Version = GRID_VERSION;
+        hdr.SessionOpenUnix = sessionOpenUnix;
+        hdr.StrideSec = strideSec;
+        hdr.SlotCount = slotCount;
+        hdr.FieldCount = fieldCount;
+        hdr.CommittedSlots = 0;
+
+        std::vector<float> body((size_t)slotCount * fieldCount, std::numeric_limits<float>::quiet_NaN());
+        LARGE_INTEGER zero; zero.QuadPart = 0;
+        SetFilePointerEx(h, zero, NULL, FILE_BEGIN);
+        WriteFile(h, &hdr, sizeof(hdr), &bytes, NULL);
+        WriteFile(h, body.data(), (DWORD)(body.size() * sizeof(float)), &bytes, NULL);
+    }
+    else if (hdr.Version != GRID_VERSION || hdr.SessionOpenUnix != sessionOpenUnix ||
+             hdr.StrideSec != strideSec || hdr.FieldCount != fieldCount)
+    {
+        // Session layout changed mid-day (interval, start time or sources edited); keep the existing grid intact
+        CloseHandle(h);
+        return false;
+    }
+
+    int highWater = hdr.CommittedSlots;
+    for (const GridSlotWrite& w : writes)
+    {
+        if (w.Slot < 0 || w.Slot >= hdr.SlotCount || (int)w.Fields.size() != fieldCount) continue;
+
+        LARGE_INTEGER pos;
+        pos.QuadPart = (LONGLONG)sizeof(GridHeader) + (LONGLONG)w.Slot * fieldCount * (LONGLONG)sizeof(float);
+        SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+        WriteFile(h, w.Fields.data(), fieldCount * sizeof(float), &bytes, NULL);
+        if (w.Slot + 1 > highWater) highWater = w.Slot + 1;
+    }
+
+    if (highWater > hdr.CommittedSlots)
+    {
+        hdr.CommittedSlots = highWater;
+        LARGE_INTEGER pos; pos.QuadPart = 0;
+        SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+        WriteFile(h, &hdr, sizeof(hdr), &bytes, NULL);
+    }
+
+    CloseHandle(h);
+    return true;
+}
+
+// =========================
+//      ROW FORMAT
+// =========================
+
+static const char* CSV_HEADER = "timestamp,spot,zero_gamma,major_pos_vol,major_neg_vol,major_pos_oi,major_neg_oi,sum_gex_vol,sum_gex_oi,delta_risk_reversal,major_long_gamma,major_short_gamma,major_positive,major_negative,net\r\n";
+
+// =========================
+//    EXTRA SOURCE PACKAGES
+// =========================
+// Additional source studies (e.g. the State package next to Classic) are
+// sampled in the same pass and appended to the same row as a fixed block of
+// columns named "<label>.<field>", so one file holds every package aligned on
+// one timestamp.
+
+#define MAX_EXTRA_SOURCES 3
+#define PACKAGE_FIELDS    7
+
+struct SourcePackage
+{
+    int ChartID;
+    int StudyID;
+    std::string Label;
+};
+
+// Column names of one package block, in write order
+static const char* PACKAGE_FIELD_NAMES[PACKAGE_FIELDS] = {
+    "zero_gamma", "major_pos_vol", "major_neg_vol", "major_pos_oi", "major_neg_oi", "major_long_gamma", "major_short_gamma"
+};
+// Matching source subgraph indices in scsf_GexBotAPI
+static const int PACKAGE_SOURCE_SG[PACKAGE_FIELDS] = { 4, 5, 6, 7, 8, 0, 1 };
+
+std::string BuildCsvHeader(const std::vector<SourcePackage>& extras)
+{
+    std::string header = CSV_HEADER;
+    if (extras.empty()) return header;
+
+    header.resize(header.size() - 2); // Strip \r\n
+    for (const SourcePackage& pkg : extras)
+        for (int f = 0; f < PACKAGE_FIELDS; ++f)
+            header += "," + pkg.Label + "." + PACKAGE_FIELD_NAMES[f];
+    return header + "\r\n";
+}
+
+// index < 0 = latest value of the source study
+void ReadPackageValues(SCStudyInterfaceRef sc, const SourcePackage& pkg, int index, double* out)
+{
+    for (int f = 0; f < PACKAGE_FIELDS; ++f)
+    {
+        SCFloatArray arr;
+        sc.GetStudyArrayFromChartUsingID(pkg.ChartID, pkg.StudyID, PACKAGE_SOURCE_SG[f], arr);
+        int i = index < 0 ? arr.GetArraySize() - 1 : index;
+        out[f] = (i >= 0 && i < arr.GetArraySize()) ? arr[i] : 0.0;
+        if (std::isnan(out[f]) || out[f] == -FLT_MAX) out[f] = 0.0;
+    }
+}
+
+// Grid slot in CSV column order: the base fields, then each package block as is
+std::vector<float> BuildGridRow(const double* fields, const std::vector<double>& extras)
+{
+    std::vector<float> out(fields, fields + GRID_FIELDS);
+    out.insert(out.end(), extras.begin(), extras.end());
+    return out;
+}
+
+// First line of an existing day file must match the configured layout before we append to it
+bool CsvHeaderMatches(const std::string& filePath, const std::string& expected)
+{
+    std::ifstream in(filePath, std::ios::binary);
+    if (!in.is_open()) return false;
+    std::string first;
+    std::getline(in, first);
+    return first + "\n" == expected;
+}
+
+// Committed data rows of a day file as (timestamp, line incl. \r\n); header and torn tail skipped
+void ReadCommittedCsvRows(const std::string& filePath, std::vector<std::pair<double, std::string>>& lines)
+{
+    unsigned long long fileSize = 0;
+    if (!GetFileSize64(filePath, fileSize)) return;
+
+    CommitRecord rec;
+    unsigned long long limit = (ReadCommitRecord(filePath, rec) && rec.CommittedBytes <= fileSize) ? rec.CommittedBytes : fileSize;
+
+    std::ifstream in(filePath, std::ios::binary);
+    std::string content((size_t)limit, '\0');
+    in.read(&content[0], (std::streamsize)content.size());
+    content.resize((size_t)in.gcount());
+
+    size_t lineStart = 0;
+    while (lineStart < content.size())
+    {
+        size_t lineEnd = content.find('\n', lineStart);
+        if (lineEnd == std::string::npos) break; // Torn tail
+        std::string line = content.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || (!isdigit((unsigned char)line[0]) && line[0] != '-')) continue; // Header
+
+        double ts = strtod(line.c_str(), nullptr);
+        if (ts > 0) lines.push_back(std::make_pair(ts, line + "\r\n"));
+    }
+}
+
+// fields = the GRID_FIELDS CSV columns after the timestamp, extras = PACKAGE_FIELDS per extra source
+std::string FormatCsvRow(double unixTs, const double* f, const std::vector<double>& extras)
+{
+    char line[512];
+    snprintf(line, sizeof(line), "%.1f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f",
+        unixTs, f[0], f[1], f[2], f[3], f[4], f[5], f[6], f[7], f[8], f[9], f[10], f[11], f[12], f[13]);
+
+    std::string row = line;
+    for (double v : extras)
+    {
+        snprintf(line, sizeof(line), ",%.4f", v);
+        row += line;
+    }
+    return row + "\r\n";
+}
+
+// Day folder: <dir>\Tickers MM.DD.YYYY
+std::string GetDayFolder(const std::string& dir, const SCDateTime& date)
+{
+    char dateBuf[64];
+    snprintf(dateBuf, sizeof(dateBuf), "Tickers %02d.%02d.%04d", date.GetMonth(), date.GetDay(), date.GetYear());
+    return dir + "\\" + dateBuf;
+}
+
+long long GetSessionOpenUnix(int date, int startTime)
+{
+    return (long long)floor((date - 25569.0) * 86400.0 + startTime + 0.5);
+}
+
+// =========================
+//   BINARY DAY FILE (.gexb)
+// =========================
+// Columnar twin of the CSV, written next to it. Layout: GexbHeader, the
+// comma-separated field names (padded to 8 bytes), an int64 Unix-ms timestamp
+// column, then one float column per field. Every column is Capacity rows
+// long so a row append is a fixed-offset write per column. RowCount is
+// bumped after the values are on disk; readers map the file and use the
+// first RowCount entries of each column directly. A full file is rewritten
+// at twice the capacity (temp file + atomic replace).
+
+#define GEXB_MAGIC            0x4E425847u  // "GXBN"
+#define GEXB_VERSION          1u
+#define GEXB_INITIAL_CAPACITY 4096
+
+struct GexbHeader
+{
+    unsigned int Magic;
+    unsigned int Version;
+    int FieldCount;
+    int Capacity;
+    int RowCount;
+    int NamesBytes;
+};
+
+unsigned long long GexbTsOffset(const GexbHeader& h, int row)
+{
+    return sizeof(GexbHeader) + (unsigned long long)h.NamesBytes + (unsigned long long)row * sizeof(long long);
+}
+
+unsigned long long GexbFieldOffset(const GexbHeader& h, int field, int row)
+{
+    return GexbTsOffset(h, h.Capacity) + ((unsigned long long)field * h.Capacity + row) * sizeof(float);
+}
+
+std::string GexbPathFor(const std::string& csvPath)
+{
+    return csvPath.substr(0, csvPath.find_last_of('.')) + ".gexb";
+}
+
+// Field names = CSV header without "timestamp," and the line ending
+std::string GexbNamesFromHeader(const std::string& header)
+{
+    size_t first = header.find(',') + 1;
+    size_t end = header.find_last_not_of("\r\n") + 1;
+    return header.substr(first, end - first);
+}
+
+// Writes a complete file (values row-major, fieldCount per row) and swaps it in
+bool WriteGexbFile(const std::string& path, const std::string& names, int fieldCount, int capacity,
+    const std::vector<long long>& ts, const std::vector<float>& values)
+{
+    GexbHeader hdr;
+    hdr.Magic = GEXB_MAGIC;
+    hdr.Version = GEXB_VERSION;
+    hdr.FieldCount = fieldCount;
+    hdr.Capacity = capacity < (int)ts.size() ? (int)ts.size() : capacity;
+    hdr.RowCount = (int)ts.size();
+    hdr.NamesBytes = (int)((names.size() + 1 + 7) & ~(size_t)7);
+
+    std::vector<char> out((size_t)GexbFieldOffset(hdr, fieldCount, 0), 0);
+    memcpy(&out[0], &hdr, sizeof(hdr));
+    memcpy(&out[sizeof(hdr)], names.data(), names.size());
+    for (int r = 0; r < hdr.RowCount; ++r)
+    {
+        memcpy(&out[(size_t)GexbTsOffset(hdr, r)], &ts[r], sizeof(long long));
+        for (int f = 0; f < fieldCount; ++f)
+            memcpy(&out[(size_t)GexbFieldOffset(hdr, f, r)], &values[(size_t)r * fieldCount + f], sizeof(float));
+    }
+
+    std::string tmpPath = path + ".tmp";
+    std::wstring wTmp(tmpPath.begin(), tmpPath.end());
+    std::wstring wPath(path.begin(), path.end());
+    HANDLE h = CreateFileW(wTmp.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return false;
+
+    DWORD bytes = 0;
+    BOOL ok = WriteFile(h, out.data(), (DWORD)out.size(), &bytes, NULL) && bytes == out.size();
+    CloseHandle(h);
+
+    if (!ok || !MoveFileExW(wTmp.c_str(), wPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        DeleteFileW(wTmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Appends one row. Returns false if the existing file has a different schema.
+bool AppendGexbRow(const std::string& path, const std::string& names, long long tsMs, const std::vector<float>& row)
+{
+    int fieldCount = (int)row.size();
+    if (!FileExists(path))
+        return WriteGexbFile(path, names, fieldCount, GEXB_INITIAL_CAPACITY, std::vector<long long>(1, tsMs), row);
+
+    std::wstring wPath(path.begin(), path.end());
+    HANDLE h = CreateFileW(wPath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return false;
+
+    GexbHeader hdr;
+    DWORD bytes = 0;
+    std::string fileNames;
+    bool ok = ReadFile(h, &hdr, sizeof(hdr), &bytes, NULL) && bytes == sizeof(hdr) &&
+        hdr.Magic == GEXB_MAGIC && hdr.Version == GEXB_VERSION && hdr.FieldCount == fieldCount && hdr.NamesBytes > 0;
+    if (ok)
+    {
+        fileNames.resize(hdr.NamesBytes);
+        ok = ReadFile(h, &fileNames[0], hdr.NamesBytes, &bytes, NULL) && bytes == (DWORD)hdr.NamesBytes;
+        fileNames.resize(strlen(fileNames.c_str()));
+        ok = ok && fileNames == names;
+    }
+    if (!ok)
+    {
+        CloseHandle(h);
+        return false;
+    }
+
+    if (hdr.RowCount >= hdr.Capacity)
+    {
+        // Full: read the columns back and rewrite at double capacity
+        std::vector<long long> ts(hdr.RowCount + 1);
+        std::vector<float> values((size_t)(hdr.RowCount + 1) * fieldCount);
+        LARGE_INTEGER pos;
+        pos.QuadPart = (LONGLONG)GexbTsOffset(hdr, 0);
+        SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+        ReadFile(h, ts.data(), (DWORD)(hdr.RowCount * sizeof(long long)), &bytes, NULL);
+
+        std::vector<float> column(hdr.Capacity);
+        for (int f = 0; f < fieldCount; ++f)
+        {
+            pos.QuadPart = (LONGLONG)GexbFieldOffset(hdr, f, 0);
+            SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+            ReadFile(h, column.data(), (DWORD)(hdr.RowCount * sizeof(float)), &bytes, NULL);
+            for (int r = 0; r < hdr.RowCount; ++r) values[(size_t)r * fieldCount + f] = column[r];
+        }
+        CloseHandle(h);
+
+        ts[hdr.RowCount] = tsMs;
+        for (int f = 0; f < fieldCount; ++f) values[(size_t)hdr.RowCount * fieldCount + f] = row[f];
+        return WriteGexbFile(path, names, fieldCount, hdr.Capacity * 2, ts, values);
+    }
+
+    LARGE_INTEGER pos;
+    pos.QuadPart = (LONGLONG)GexbTsOffset(hdr, hdr.RowCount);
+    SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+    WriteFile(h, &tsMs, sizeof(tsMs), &bytes, NULL);
+    for (int f = 0; f < fieldCount; ++f)
+    {
+        pos.QuadPart = (LONGLONG)GexbFieldOffset(hdr, f, hdr.RowCount);
+        SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+        WriteFile(h, &row[f], sizeof(float), &bytes, NULL);
+    }
+
+    // Publish the row
+    hdr.RowCount++;
+    pos.QuadPart = 0;
+    SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+    WriteFile(h, &hdr, sizeof(hdr), &bytes, NULL);
+    CloseHandle(h);
+    return true;
+}
+
+// One CSV line as the twin stores it (values appended to the vector). Both the live
+// append and the rebuild go through here, so the twin holds exactly what the CSV says.
+long long ParseGexbRow(const std::string& line, int fieldCount, std::vector<float>& values)
+{
+    char* p = nullptr;
+    long long tsMs = (long long)floor(strtod(line.c_str(), &p) * 1000.0 + 0.5);
+    for (int f = 0; f < fieldCount; ++f)
+        values.push_back((p && *p == ',') ? (float)strtod(p + 1, &p) : 0.0f);
+    return tsMs;
+}
+
+// Rebuilds the binary twin from CSV rows (backfill, or first .gexb write on a day that already has a CSV)
+bool RebuildGexb(const std::string& gexbPath, const std::string& header, const std::vector<std::pair<double, std::string>>& lines)
+{
+    int fieldCount = (int)std::count(header.begin(), header.end(), ',');
+    std::vector<long long> ts;
+    std::vector<float> values;
+    ts.reserve(lines.size());
+    values.reserve(lines.size() * fieldCount);
+    for (const auto& l : lines)
+        ts.push_back(ParseGexbRow(l.second, fieldCount, values));
+    return WriteGexbFile(gexbPath, GexbNamesFromHeader(header), fieldCount,
+        (int)lines.size() > GEXB_INITIAL_CAPACITY ? (int)lines.size() : GEXB_INITIAL_CAPACITY, ts, values);
+}
+
+// =========================
+//       DAY CATALOG
+// =========================
+// "<base>\<Ticker>.catalog" lists the day files that exist for a ticker, one
+// line per day and format: date,format,rows,min_ts,max_ts,bytes (Unix
+// seconds, rows -1 = unknown). Writers rewrite it atomically; loaders read it
+// once instead of probing every calendar day.
+
+#define CATALOG_HEADER "# GexBot day catalog v1: date,format,rows,min_ts,max_ts,bytes\r\n"
+
+struct CatalogEntry
+{
+    int Date;                   // YYYYMMDD of the "Tickers MM.DD.YYYY" folder
+    std::string Format;         // csv, gexb, grid, gexz, db
+    long long Rows;
+    double MinTs;
+    double MaxTs;
+    unsigned long long Bytes;
+};
+
+std::string GetCatalogPath(const std::string& baseFolder, const std::string& ticker)
+{
+    return baseFolder + "\\" + ticker + ".catalog";
+}
+
+bool ReadCatalog(const std::string& path, std::vector<CatalogEntry>& entries)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#') continue;
+        CatalogEntry e;
+        char format[16] = {0};
+        if (sscanf(line.c_str(), "%d,%15[^,],%lld,%lf,%lf,%llu", &e.Date, format, &e.Rows, &e.MinTs, &e.MaxTs, &e.Bytes) != 6)
+            continue;
+        e.Format = format;
+        entries.push_back(e);
+    }
+    return true;
+}
+
+// Writers (Collector, API study, GexBotTerminal.cpp, archive tool) serialize the
+// read-modify-write on "<catalog>.lock"; each writes its own temp file.
+#define CATALOG_LOCK_TRIES   20
+#define CATALOG_LOCK_WAIT_MS 5
+
+// Exclusive handle on "<path>.lock", INVALID_HANDLE_VALUE if another writer
+// still holds it after the wait. Deleted on close, so a writer that dies
+// never leaves it behind.
+HANDLE LockCatalog(const std::string& path)
+{
+    std::string lockPath = path + ".lock";
+    std::wstring wLock(lockPath.begin(), lockPath.end());
+    for (int attempt = 0; attempt < CATALOG_LOCK_TRIES; ++attempt)
+    {
+        HANDLE h = CreateFileW(wLock.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_ALWAYS,
+            FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+        if (h != INVALID_HANDLE_VALUE) return h;
+        Sleep(CATALOG_LOCK_WAIT_MS);
+    }
+    return INVALID_HANDLE_VALUE;
+}
+
+// Inserts or replaces the (Date, Format) entries and swaps the catalog in.
+// keepMinTs: an existing entry keeps its earlier MinTs (appending writers only know the newest row).
+// A catalog left locked is skipped: readers probe the files it does not list yet.
+bool UpdateCatalog(const std::string& path, const std::vector<CatalogEntry>& updates, bool keepMinTs)
+{
+    HANDLE lock = LockCatalog(path);
+    if (lock == INVALID_HANDLE_VALUE) return false;
+
+    std::vector<CatalogEntry> entries;
+    ReadCatalog(path, entries);
+
+    for (const CatalogEntry& u : updates)
+    {
+        bool found = false;
+        for (CatalogEntry& e : entries)
+        {
+            if (e.Date != u.Date || e.Format != u.Format) continue;
+            double minTs = (keepMinTs && e.MinTs > 0 && e.MinTs < u.MinTs) ? e.MinTs : u.MinTs;
+            e = u;
+            e.MinTs = minTs;
+            found = true;
+        }
+        if (!found) entries.push_back(u);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const CatalogEntry& a, const CatalogEntry& b) {
+        return a.Date != b.Date ? a.Date < b.Date : a.Format < b.Format;
+    });
+
+    std::string out = CATALOG_HEADER;
+    char line[160];
+    for (const CatalogEntry& e : entries)
+    {
+        snprintf(line, sizeof(line), "%d,%s,%lld,%.1f,%.1f,%llu\r\n", e.Date, e.Format.c_str(), e.Rows, e.MinTs, e.MaxTs, e.Bytes);
+        out += line;
+    }
+
+    std::string tmpPath = path + "." + std::to_string(GetCurrentProcessId()) + "." + std::to_string(GetCurrentThreadId()) + ".tmp";
+    std::wstring wTmp(tmpPath.begin(), tmpPath.end());
+    std::wstring wPath(path.begin(), path.end());
+    HANDLE h = CreateFileW(wTmp.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(lock);
+        return false;
+    }
+
+    DWORD bytes = 0;
+    BOOL ok = WriteFile(h, out.data(), (DWORD)out.size(), &bytes, NULL) && bytes == out.size();
+    CloseHandle(h);
+
+    if (!ok || !MoveFileExW(wTmp.c_str(), wPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        DeleteFileW(wTmp.c_str());
+        ok = FALSE;
+    }
+    CloseHandle(lock);
+    return ok != FALSE;
+}
+
+#define CATALOG_UPDATE_SEC 60
+#define GEXB_RETRY_SEC     60   // A .gexb rebuild that failed is tried again after this long, not on every row
+
+int GetDateYmd(const SCDateTime& date)
+{
+    return date.GetYear() * 10000 + date.GetMonth() * 100 + date.GetDay();
+}
+
+// Catalog entries for one day folder: the CSV and whichever twins (.gexb, .grid) exist
+void CatalogDayFolder(const std::string& dir, const std::string& ticker, const std::string& dayFolder, int ymd,
+    long long rows, double minTs, double maxTs, bool keepMinTs)
+{
+    static const char* formats[] = { "csv", "gexb", "grid" };
+    std::vector<CatalogEntry> updates;
+    for (const char* format : formats)
+    {
+        unsigned long long bytes = 0;
+        if (!GetFileSize64(dayFolder + "\\" + ticker + "." + format, bytes)) continue;
+        CatalogEntry e = { ymd, format, rows, minTs, maxTs, bytes };
+        updates.push_back(e);
+    }
+    if (!updates.empty())
+        UpdateCatalog(GetCatalogPath(dir, ticker), updates, keepMinTs);
+}
+
+// =========================
+//      DAILY SUMMARY
+// =========================
+// "<base>\<Ticker>.summary": one line per closed session with the day's
+// zero gamma / spot open-high-low-close, closing walls, how often the vol
+// walls moved and how long spot traded above / below zero gamma. Lets the
+// Viewer draw months of context on daily/weekly charts without intraday rows.
+
+#define SUMMARY_HEADER "# GexBot daily summary v1: date,rows,zero_open,zero_high,zero_low,zero_close," \
+    "spot_open,spot_high,spot_low,spot_close,pos_vol_close,neg_vol_close,pos_oi_close,neg_oi_close," \
+    "pos_vol_moves,neg_vol_moves,sec_above_zero,sec_below_zero\r\n"
+
+struct DaySummary
+{
+    int Date;                   // YYYYMMDD of the "Tickers MM.DD.YYYY" folder
+    long long Rows;
+    double ZeroOpen, ZeroHigh, ZeroLow, ZeroClose;
+    double SpotOpen, SpotHigh, SpotLow, SpotClose;
+    double PosVolClose, NegVolClose, PosOiClose, NegOiClose;
+    int PosVolMoves, NegVolMoves;
+    int SecAboveZero, SecBelowZero;
+};
+
+std::string GetSummaryPath(const std::string& baseFolder, const std::string& ticker)
+{
+    return baseFolder + "\\" + ticker + ".summary";
+}
+
+bool ReadSummaries(const std::string& path, std::vector<DaySummary>& days)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#') continue;
+        DaySummary d;
+        if (sscanf(line.c_str(), "%d,%lld,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%d,%d,%d,%d",
+                &d.Date, &d.Rows, &d.ZeroOpen, &d.ZeroHigh, &d.ZeroLow, &d.ZeroClose,
+                &d.SpotOpen, &d.SpotHigh, &d.SpotLow, &d.SpotClose,
+                &d.PosVolClose, &d.NegVolClose, &d.PosOiClose, &d.NegOiClose,
+                &d.PosVolMoves, &d.NegVolMoves, &d.SecAboveZero, &d.SecBelowZero) != 18)
+            continue;
+        days.push_back(d);
+    }
+    return true;
+}
+
+#define SUMMARY_MAX_GAP_SEC 60   // A longer gap between rows is not counted as time above/below zero
+
+// Summary of one day. values: row-major, fieldCount per row, CSV column order after
+// the timestamp. Only the base columns (primary source) are summarized; extra
+// package blocks from field 14 on are skipped.
+DaySummary SummarizeDay(int date, const std::vector<double>& ts, const std::vector<float>& values, int fieldCount)
+{
+    DaySummary d = { date, (long long)ts.size(), 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    double prevPosVol = 0, prevNegVol = 0, prevZero = 0, prevSpot = 0, prevTs = 0;
+
+    for (size_t r = 0; r < ts.size(); ++r)
+    {
+        const float* row = &values[r * fieldCount];
+        auto field = [&](int f) -> double {
+            double v = (f < fieldCount) ? row[f] : 0.0;
+            return (v != v) ? 0.0 : v;
+        };
+        double spot = field(0), zero = field(1), posVol = field(2), negVol = field(3);
+        double posOi = field(4), negOi = field(5);
+
+        // Time since the previous row goes to the side spot was on at that row
+        if (r > 0 && prevZero != 0 && prevSpot != 0)
+        {
+            double dt = std::min(ts[r] - prevTs, (double)SUMMARY_MAX_GAP_SEC);
+            if (dt > 0) (prevSpot > prevZero ? d.SecAboveZero : d.SecBelowZero) += (int)(dt + 0.5);
+        }
+        prevTs = ts[r];
+        if (zero != 0) prevZero = zero;
+        if (spot != 0) prevSpot = spot;
+
+        if (zero != 0)
+        {
+            if (d.ZeroOpen == 0) d.ZeroOpen = d.ZeroHigh = d.ZeroLow = zero;
+            d.ZeroHigh = std::max(d.ZeroHigh, zero);
+            d.ZeroLow = std::min(d.ZeroLow, zero);
+            d.ZeroClose = zero;
+        }
+        if (spot != 0)
+        {
+            if (d.SpotOpen == 0) d.SpotOpen = d.SpotHigh = d.SpotLow = spot;
+            d.SpotHigh = std::max(d.SpotHigh, spot);
+            d.SpotLow = std::min(d.SpotLow, spot);
+            d.SpotClose = spot;
+        }
+        if (posVol != 0)
+        {
+            if (prevPosVol != 0 && posVol != prevPosVol) ++d.PosVolMoves;
+            prevPosVol = d.PosVolClose = posVol;
+        }
+        if (negVol != 0)
+        {
+            if (prevNegVol != 0 && negVol != prevNegVol) ++d.NegVolMoves;
+            prevNegVol = d.NegVolClose = negVol;
+        }
+        if (posOi != 0) d.PosOiClose = posOi;
+        if (negOi != 0) d.NegOiClose = negOi;
+    }
+    return d;
+}
+
+std::string FormatSummaries(std::vector<DaySummary> days)
+{
+    std::sort(days.begin(), days.end(), [](const DaySummary& a, const DaySummary& b) { return a.Date < b.Date; });
+
+    std::string out = SUMMARY_HEADER;
+    char line[512];
+    for (const DaySummary& d : days)
+    {
+        snprintf(line, sizeof(line), "%d,%lld,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%d,%d,%d,%d\r\n",
+            d.Date, d.Rows, d.ZeroOpen, d.ZeroHigh, d.ZeroLow, d.ZeroClose,
+            d.SpotOpen, d.SpotHigh, d.SpotLow, d.SpotClose,
+            d.PosVolClose, d.NegVolClose, d.PosOiClose, d.NegOiClose,
+            d.PosVolMoves, d.NegVolMoves, d.SecAboveZero, d.SecBelowZero);
+        out += line;
+    }
+    return out;
+}
+
+// Replaces (or adds) the entries for the given dates
+void MergeSummaries(std::vector<DaySummary>& days, const std::vector<DaySummary>& updates)
+{
+    for (const DaySummary& u : updates)
+    {
+        days.erase(std::remove_if(days.begin(), days.end(), [&](const DaySummary& d) { return d.Date == u.Date; }), days.end());
+        days.push_back(u);
+    }
+}
+
+// The archive tool writes the same file: the read-modify-write holds "<summary>.lock"
+// (same protocol as the catalog, see LockCatalog) and uses its own temp file
+bool UpdateSummaryFile(const std::string& path, const std::vector<DaySummary>& updates)
+{
+    HANDLE lock = LockCatalog(path);
+    if (lock == INVALID_HANDLE_VALUE) return false;
+
+    std::vector<DaySummary> days;
+    ReadSummaries(path, days);
+    MergeSummaries(days, updates);
+    std::string out = FormatSummaries(days);
+
+    std::string tmpPath = path + "." + std::to_string(GetCurrentProcessId()) + "." + std::to_string(GetCurrentThreadId()) + ".tmp";
+    std::wstring wTmp(tmpPath.begin(), tmpPath.end());
+    std::wstring wPath(path.begin(), path.end());
+    HANDLE h = CreateFileW(wTmp.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(lock);
+        return false;
+    }
+
+    DWORD bytes = 0;
+    BOOL ok = WriteFile(h, out.data(), (DWORD)out.size(), &bytes, NULL) && bytes == out.size();
+    CloseHandle(h);
+
+    if (!ok || !MoveFileExW(wTmp.c_str(), wPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        DeleteFileW(wTmp.c_str());
+        ok = FALSE;
+    }
+    CloseHandle(lock);
+    return ok != FALSE;
+}
+
+// Summarizes the committed rows of one closed day CSV into the ticker's summary file
+bool SummarizeDayFile(const std::string& dir, const std::string& ticker, const std::string& csvPath, int ymd)
+{
+    std::vector<std::pair<double, std::string>> lines;
+    ReadCommittedCsvRows(csvPath, lines);
+    if (lines.empty()) return false;
+    std::stable_sort(lines.begin(), lines.end(),
+        [](const std::pair<double, std::string>& a, const std::pair<double, std::string>& b) { return a.first < b.first; });
+
+    int fieldCount = (int)std::count(lines[0].second.begin(), lines[0].second.end(), ',');
+    std::vector<double> ts;
+    std::vector<float> values;
+    ts.reserve(lines.size());
+    values.reserve(lines.size() * fieldCount);
+    for (const auto& l : lines)
+    {
+        ts.push_back(l.first);
+        const char* p = strchr(l.second.c_str(), ',');
+        for (int f = 0; f < fieldCount; ++f)
+        {
+            char* end = nullptr;
+            values.push_back((p && *p == ',') ? (float)strtod(p + 1, &end) : 0.0f);
+            p = end;
+        }
+    }
+
+    return UpdateSummaryFile(GetSummaryPath(dir, ticker),
+        std::vector<DaySummary>(1, SummarizeDay(ymd, ts, values, fieldCount)));
+}
+
+// =========================
+//   HISTORICAL BACKFILL
+// =========================
+// One-shot bulk capture of everything the source study still holds in its
+// arrays. Rows are grouped per day and merged with what is already on disk
+// (a bar that already contains a recorded row is skipped), then each day file
+// is rewritten once, sorted, and swapped in atomically.
+
+struct BackfillRow
+{
+    double UnixTs;
+    double BarEndUnixTs;
+    double Fields[GRID_FIELDS];
+    std::vector<double> Extras;
+};
+
+// Returns the number of rows added to filePath, -1 if the file has a different column layout.
+// totalRows/minTs/maxTs describe the merged file (for the catalog).
+int MergeBackfillIntoDay(const std::string& filePath, const std::string& header, const std::vector<BackfillRow>& rows,
+    long long& totalRows, double& minTs, double& maxTs)
+{
+    if (FileExists(filePath) && !CsvHeaderMatches(filePath, header))
+        return -1;
+
+    // Existing committed rows, kept verbatim
+    std::vector<std::pair<double, std::string>> lines;
+    ReadCommittedCsvRows(filePath, lines);
+
+    std::vector<double> existingTs;
+    existingTs.reserve(lines.size());
+    for (const auto& l : lines) existingTs.push_back(l.first);
+    std::sort(existingTs.begin(), existingTs.end());
+
+    int added = 0;
+    for (const BackfillRow& row : rows)
+    {
+        // Dedupe: any row already on disk inside this bar means the bar was recorded
+        auto it = std::lower_bound(existingTs.begin(), existingTs.end(), row.UnixTs);
+        if (it != existingTs.end() && *it < row.BarEndUnixTs) continue;
+
+        lines.push_back(std::make_pair(row.UnixTs, FormatCsvRow(row.UnixTs, row.Fields, row.Extras)));
+        ++added;
+    }
+    if (added == 0) return 0;
+
+    std::stable_sort(lines.begin(), lines.end(),
+        [](const std::pair<double, std::string>& a, const std::pair<double, std::string>& b) { return a.first < b.first; });
+
+    std::string out = header;
+    out.reserve(out.size() + lines.size() * 128);
+    std::vector<CsvIndexEntry> index;
+    for (const auto& l : lines)
+    {
+        long long tsMs = (long long)floor(l.first * 1000.0 + 0.5);
+        if (index.empty() || tsMs / CSV_INDEX_STEP_MS > index.back().TsMs / CSV_INDEX_STEP_MS)
+        {
+            CsvIndexEntry e = { tsMs, (unsigned long long)out.size() };
+            index.push_back(e);
+        }
+        out += l.second;
+    }
+
+    // Single bulk write to a temp file, then atomic replace
+    std::string tmpPath = filePath + ".tmp";
+    std::wstring wTmp(tmpPath.begin(), tmpPath.end());
+    std::wstring wPath(filePath.begin(), filePath.end());
+    HANDLE h = CreateFileW(wTmp.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return 0;
+
+    DWORD bytes = 0;
+    BOOL ok = WriteFile(h, out.data(), (DWORD)out.size(), &bytes, NULL) && bytes == out.size();
+    CloseHandle(h);
+
+    // The commit record describes the new file before it is swapped in. Until the rename,
+    // readers of the old one stop at the smaller of the record and its size: whole rows
+    // either way (it only holds committed rows and the new file starts with them).
+    CommitRecord oldCommit;
+    bool hadCommit = ReadCommitRecord(filePath, oldCommit);
+    if (ok)
+        WriteCommitRecord(filePath, out.size(), lines.size());
+
+    if (!ok || !MoveFileExW(wTmp.c_str(), wPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        DeleteFileW(wTmp.c_str());
+        if (hadCommit)
+            WriteCommitRecord(filePath, oldCommit.CommittedBytes, oldCommit.RowCount);
+        else if (ok)
+        {
+            std::string commitPath = filePath + ".commit";
+            DeleteFileW(std::wstring(commitPath.begin(), commitPath.end()).c_str());
+        }
+        return 0;
+    }
+
+    WriteCsvIndex(filePath, index);
+    totalRows = (long long)lines.size();
+    minTs = lines.front().first;
+    maxTs = lines.back().first;
+
+    RebuildGexb(GexbPathFor(filePath), header, lines);
+
+    return added;
+}
+
+void RunBackfill(SCStudyInterfaceRef sc, int chartID, int studyID, const std::vector<SourcePackage>& extras,
+    const std::string& ticker, const std::string& dir, int startTime, int endTime, bool gridMode, int strideSec)
+{
+    SCFloatArray SG_LongGamma, SG_ShortGamma, SG_Zero, SG_CallVol, SG_PutVol, SG_CallOI, SG_PutOI;
+    sc.GetStudyArrayFromChartUsingID(chartID, studyID, 0, SG_LongGamma);
+    sc.GetStudyArrayFromChartUsingID(chartID, studyID, 1, SG_ShortGamma);
+    sc.GetStudyArrayFromChartUsingID(chartID, studyID, 4, SG_Zero);
+    sc.GetStudyArrayFromChartUsingID(chartID, studyID, 5, SG_CallVol);
+    sc.GetStudyArrayFromChartUsingID(chartID, studyID, 6, SG_PutVol);
+    sc.GetStudyArrayFromChartUsingID(chartID, studyID, 7, SG_CallOI);
+    sc.GetStudyArrayFromChartUsingID(chartID, studyID, 8, SG_PutOI);
+
+    SCDateTimeArray barTimes;
+    SCFloatArray lastArray, openArray, highArray;
+    sc.GetChartDateTimeArray(chartID, barTimes);
+    sc.GetChartArray(chartID, SC_LAST, lastArray);
+    sc.GetChartArray(chartID, SC_OPEN, openArray);
+    sc.GetChartArray(chartID, SC_HIGH, highArray);
+
+    // The last bar is still forming: the live recorder writes its rows, the backfill stops before it
+    int barCount = SG_CallVol.GetArraySize();
+    if (barTimes.GetArraySize() - 1 < barCount) barCount = barTimes.GetArraySize() - 1;
+    if (lastArray.GetArraySize() < barCount) barCount = lastArray.GetArraySize();
+
+    // Group by day folder; bars are already in time order
+    std::map<std::string, std::vector<BackfillRow>> byDay;
+    std::map<std::string, int> dayDates;
+    for (int i = 0; i < barCount; ++i)
+    {
+        SCDateTime barTime = barTimes[i];
+        int time = barTime.GetTime();
+        int dow = barTime.GetDayOfWeek();
+        if (time < startTime || time > endTime || dow == SATURDAY || dow == SUNDAY)
+            continue;
+
+        double zero = SG_Zero[i], callVol = SG_CallVol[i], putVol = SG_PutVol[i];
+        if ((zero == 0 && callVol == 0 && putVol == 0) || std::isnan(zero) || zero == -FLT_MAX)
+            continue; // Source study had no data for this bar
+
+        double spot = lastArray[i];
+        if (spot < 500.0 && openArray[i] > 500.0) spot = openArray[i];
+        if (spot < 500.0 && highArray[i] > 500.0) spot = highArray[i];
+
+        BackfillRow row;
+        row.UnixTs = (barTime.GetAsDouble() - 25569.0) * 86400.0;
+        row.BarEndUnixTs = (barTimes[i + 1].GetAsDouble() - 25569.0) * 86400.0;
+        double fields[GRID_FIELDS] = { spot, zero, callVol, putVol, SG_CallOI[i], SG_PutOI[i],
+            0.0, 0.0, 0.0, SG_LongGamma[i], SG_ShortGamma[i], 0.0, 0.0, 0.0 };
+        memcpy(row.Fields, fields, sizeof(fields));
+
+        // Extra packages on another chart are aligned by bar time
+        row.Extras.resize(extras.size() * PACKAGE_FIELDS);
+        for (size_t p = 0; p < extras.size(); ++p)
+        {
+            int srcIndex = (extras[p].ChartID == chartID) ? i : sc.GetNearestMatchForSCDateTime(extras[p].ChartID, barTime);
+            ReadPackageValues(sc, extras[p], srcIndex, &row.Extras[p * PACKAGE_FIELDS]);
+        }
+
+        std::string folder = GetDayFolder(dir, barTime);
+        byDay[folder].push_back(row);
+        dayDates[folder] = barTime.GetDate();
+    }
+
+    std::string header = BuildCsvHeader(extras);
+    int totalAdded = 0, dayFiles = 0;
+    for (const auto& day : byDay)
+    {
+        std::string filePath = day.first + "\\" + ticker + ".csv";
+        EnsureDirectoryExists(filePath);
+        long long totalRows = 0;
+        double minTs = 0, maxTs = 0;
+        int added = MergeBackfillIntoDay(filePath, header, day.second, totalRows, minTs, maxTs);
+        if (added < 0)
+        {
+            SCString msg;
+            msg.Format("GexCollector: Backfill skipped %s (column layout differs from the configured sources)", filePath.c_str());
+            sc.AddMessageToLog(msg, 1);
+            continue;
+        }
+        if (added == 0) continue;
+
+        totalAdded += added;
+        ++dayFiles;
+
+        if (gridMode)
+        {
+            // Same slots the live sampler would have used: first bar inside each slot
+            long long open = GetSessionOpenUnix(dayDates[day.first], startTime);
+            std::vector<GridSlotWrite> writes;
+            int lastSlot = -1;
+            for (const BackfillRow& row : day.second)
+            {
+                int slot = (int)floor((row.UnixTs - open) / strideSec);
+                if (slot < 0 || slot == lastSlot) continue;
+                lastSlot = slot;
+
+                GridSlotWrite w;
+                w.Slot = slot;
+                w.Fields = BuildGridRow(row.Fields, row.Extras);
+                writes.push_back(w);
+            }
+
+            // Patch a copy and swap it in, so a reader never sees earlier slots change under its high-water mark
+            std::string gridPath = day.first + "\\" + ticker + ".grid";
+            std::string tmpPath = gridPath + ".tmp";
+            std::wstring wGrid(gridPath.begin(), gridPath.end());
+            std::wstring wTmp(tmpPath.begin(), tmpPath.end());
+            bool copied = !FileExists(gridPath) || CopyFileW(wGrid.c_str(), wTmp.c_str(), FALSE);
+            if (copied && WriteGridSlots(tmpPath, open, strideSec, (endTime - startTime) / strideSec + 1,
+                    GRID_FIELDS + (int)extras.size() * PACKAGE_FIELDS, writes))
+                MoveFileExW(wTmp.c_str(), wGrid.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+            else
+                DeleteFileW(wTmp.c_str());
+        }
+
+        int ymd = GetDateYmd(SCDateTime(dayDates[day.first]));
+        CatalogDayFolder(dir, ticker, day.first, ymd, totalRows, minTs, maxTs, false);
+
+        // Closed sessions get their summary line (today's is written at the close)
+        if (ymd < GetDateYmd(sc.CurrentSystemDateTime))
+            SummarizeDayFile(dir, ticker, filePath, ymd);
+    }
+
+    SCString msg;
+    msg.Format("GexCollector: Backfill scanned %d bars, added %d rows to %d day files", barCount, totalAdded, dayFiles);
+    sc.AddMessageToLog(msg, 0);
+}
+
 // =========================
 //      MAIN STUDY
 // =========================
@@ -58,6 +1256,9 @@ SCSFExport scsf_GexBotDataCollector(SCStudyInterfaceRef sc)
     SCInputRef EndTimeInput = sc.Input[5];
     SCInputRef WriteIntervalSecInput = sc.Input[6];
     SCInputRef DebugLoggingInput = sc.Input[7];
+    SCInputRef SamplingModeInput = sc.Input[8];
+    SCInputRef BackfillInput = sc.Input[9];
+    // Extra sources: [10 + 3*n] Chart ID, [11 + 3*n] Study ID (0 = off), [12 + 3*n] Label
     
     // Internal Persistence
     SCString& LastLogTime = sc.GetPersistentSCString(1);
@@ -92,6 +1293,32 @@ SCSFExport scsf_GexBotDataCollector(SCStudyInterfaceRef sc)
         DebugLoggingInput.Name = "Enable Debug Logging";
         DebugLoggingInput.SetYesNo(0);
 
+        // Wall-Clock Grid: one sample per interval, snapped to Start Time + k * interval
+        SamplingModeInput.Name = "Sampling Mode";
+        SamplingModeInput.SetCustomInputStrings("Write Interval;Wall-Clock Grid");
+        SamplingModeInput.SetCustomInputIndex(0);
+
+        // One-shot: resets itself to No after the backfill has run
+        BackfillInput.Name = "Backfill Source History Now";
+        BackfillInput.SetYesNo(0);
+
+        static const char* defaultLabels[MAX_EXTRA_SOURCES] = { "STATE", "EXTRA2", "EXTRA3" };
+        for (int n = 0; n < MAX_EXTRA_SOURCES; ++n)
+        {
+            SCString name;
+            name.Format("Extra Source %d Chart ID (0 for this chart)", n + 1);
+            sc.Input[10 + 3 * n].Name = name;
+            sc.Input[10 + 3 * n].SetInt(0);
+
+            name.Format("Extra Source %d Study ID (0 = Off)", n + 1);
+            sc.Input[11 + 3 * n].Name = name;
+            sc.Input[11 + 3 * n].SetInt(0);
+
+            name.Format("Extra Source %d Column Label", n + 1);
+            sc.Input[12 + 3 * n].Name = name;
+            sc.Input[12 + 3 * n].SetString(defaultLabels[n]);
+        }
+
         return;
     }
 
@@ -101,6 +1328,32 @@ SCSFExport scsf_GexBotDataCollector(SCStudyInterfaceRef sc)
     if (sc.Index < sc.ArraySize - 1) 
         return;
 
+    std::vector<SourcePackage> extras;
+    for (int n = 0; n < MAX_EXTRA_SOURCES; ++n)
+    {
+        SourcePackage pkg;
+        pkg.StudyID = sc.Input[11 + 3 * n].GetInt();
+        if (pkg.StudyID == 0) continue;
+        pkg.ChartID = sc.Input[10 + 3 * n].GetInt() == 0 ? sc.ChartNumber : sc.Input[10 + 3 * n].GetInt();
+        pkg.Label = sc.Input[12 + 3 * n].GetString();
+        if (pkg.Label.empty()) continue;
+        extras.push_back(pkg);
+    }
+
+    // Historical backfill runs once, regardless of the time filter below
+    if (BackfillInput.GetYesNo())
+    {
+        BackfillInput.SetYesNo(0);
+
+        int chartID = ChartIDInput.GetInt() == 0 ? sc.ChartNumber : ChartIDInput.GetInt();
+        int strideSec = WriteIntervalSecInput.GetInt() > 0 ? WriteIntervalSecInput.GetInt() : 1;
+        std::string ticker = TickerInput.GetString();
+        std::string dir = OutputPathInput.GetString();
+        if (!ticker.empty() && !dir.empty())
+            RunBackfill(sc, chartID, StudyIDInput.GetInt(), extras, ticker, dir, StartTimeInput.GetTime(), EndTimeInput.GetTime(),
+                SamplingModeInput.GetIndex() == 1, strideSec);
+    }
+
     // Time Filter - Use REAL TIME for filtering and timestamps
     SCDateTime CurrentDateTime = sc.CurrentSystemDateTime;
     int CurrentTime = CurrentDateTime.GetTime();    
@@ -109,6 +1362,20 @@ SCSFExport scsf_GexBotDataCollector(SCStudyInterfaceRef sc)
 
     if (CurrentTime < StartTime || CurrentTime > EndTime)
     {
+        // Session close: summarize today's file once
+        int& LastSummaryDate = sc.GetPersistentInt(7);
+        int dow = CurrentDateTime.GetDayOfWeek();
+        if (CurrentTime > EndTime && LastSummaryDate != CurrentDateTime.GetDate() && dow != SATURDAY && dow != SUNDAY)
+        {
+            LastSummaryDate = CurrentDateTime.GetDate();
+            std::string ticker = TickerInput.GetString();
+            std::string dir = OutputPathInput.GetString();
+            std::string filePath = GetDayFolder(dir, CurrentDateTime) + "\\" + ticker + ".csv";
+            if (!ticker.empty() && !dir.empty() && FileExists(filePath) &&
+                SummarizeDayFile(dir, ticker, filePath, GetDateYmd(CurrentDateTime)) && DebugLoggingInput.GetYesNo())
+                sc.AddMessageToLog("GexCollector: Daily summary written", 0);
+        }
+
         // Debug: Log why we are skipping (only once per minute to avoid spam)
         if (CurrentDateTime.GetSecond() == 0) 
         {
@@ -137,9 +1404,21 @@ SCSFExport scsf_GexBotDataCollector(SCStudyInterfaceRef sc)
     SCDateTime LastWrite = SCDateTime(0.0);
     // We'll use a persistent int for "Last Write Time" to avoid string parsing overhead
     int& LastWriteTimeSec = sc.GetPersistentInt(2);
+    int& LastGridSlot = sc.GetPersistentInt(3);
+    int& LastGridDate = sc.GetPersistentInt(4);
     int NowSec = CurrentDateTime.GetTimeInSeconds();
-    
-    if (NowSec - LastWriteTimeSec < WriteIntervalSecInput.GetInt())
+
+    bool gridMode = SamplingModeInput.GetIndex() == 1;
+    int strideSec = WriteIntervalSecInput.GetInt() > 0 ? WriteIntervalSecInput.GetInt() : 1;
+    int gridSlot = (NowSec - StartTime) / strideSec;
+
+    if (gridMode)
+    {
+        // At most one sample per grid slot; the first update inside a new slot takes it
+        if (CurrentDateTime.GetDate() == LastGridDate && gridSlot <= LastGridSlot)
+            return;
+    }
+    else if (NowSec - LastWriteTimeSec < WriteIntervalSecInput.GetInt())
         return;
 
     // Access Source Arrays
@@ -227,19 +1506,26 @@ SCSFExport scsf_GexBotDataCollector(SCStudyInterfaceRef sc)
     if (ticker.empty() || dir.empty()) return;
 
     // Filename: Tickers MM.DD.YYYY/Ticker.csv
-    SCDateTime Today = sc.CurrentSystemDateTime;
-    int year = Today.GetYear();
-    int month = Today.GetMonth();
-    int day = Today.GetDay();
-    char dateBuf[64];
-    snprintf(dateBuf, sizeof(dateBuf), "Tickers %02d.%02d.%04d", month, day, year);
-    
-    std::string fullDir = dir + "\\" + dateBuf;
+    std::string fullDir = GetDayFolder(dir, sc.CurrentSystemDateTime);
     std::string filePath = fullDir + "\\" + ticker + ".csv";
 
     EnsureDirectoryExists(filePath);
     
     bool needsHeader = !FileExists(filePath);
+    std::string header = BuildCsvHeader(extras);
+
+    // Never mix column layouts in one day file (sources edited mid-day)
+    if (!needsHeader && !CsvHeaderMatches(filePath, header))
+    {
+        if (debugLog || LastWriteTimeSec == 0 || NowSec - LastWriteTimeSec >= 60)
+        {
+            SCString msg;
+            msg.Format("GexCollector: %s has a different column layout than the configured sources, not writing", filePath.c_str());
+            sc.AddMessageToLog(msg, 1);
+        }
+        LastWriteTimeSec = NowSec;
+        return;
+    }
     int fileHandle = 0;
     SCString scPath(filePath.c_str());
     
@@ -252,25 +1538,97 @@ SCSFExport scsf_GexBotDataCollector(SCStudyInterfaceRef sc)
 
     unsigned int bytesWritten = 0;
     if (needsHeader)
-    {
-        const char* header = "timestamp,spot,zero_gamma,major_pos_vol,major_neg_vol,major_pos_oi,major_neg_oi,sum_gex_vol,sum_gex_oi,delta_risk_reversal,major_long_gamma,major_short_gamma,major_positive,major_negative,net\r\n";
-        sc.WriteFile(fileHandle, header, (int)strlen(header), &bytesWritten);
-    }
+        sc.WriteFile(fileHandle, header.c_str(), (int)header.size(), &bytesWritten);
 
     // Format Line
-    // Unix Timestamp
-    double unixTs = (CurrentDateTime.GetAsDouble() - 25569.0) * 86400.0;
+    // Unix Timestamp (grid mode: snapped to the slot boundary)
+    SCDateTime SampleDateTime = CurrentDateTime;
+    if (gridMode)
+        SampleDateTime = SCDateTime(CurrentDateTime.GetDate() + (StartTime + gridSlot * strideSec) / 86400.0);
+    double unixTs = (SampleDateTime.GetAsDouble() - 25569.0) * 86400.0;
     
     // Write match for GexBotTerminalAPI/Viewer format:
     // timestamp, spot, zero, pos_vol, neg_vol, pos_oi, neg_oi, net_vol, net_oi, delta_rr, long, short, maj_pos, maj_neg, net
     // We only have SGs for the first set. We will fill others with 0.
-    
-    char line[512];
-    snprintf(line, sizeof(line), "%.1f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\r\n",
-        unixTs, Spot, Zero, CallVol, PutVol, CallOI, PutOI, NetVol, NetOI, 0.0, Long, Short, 0.0, 0.0, 0.0);
+    double row[GRID_FIELDS] = { Spot, Zero, CallVol, PutVol, CallOI, PutOI, NetVol, NetOI, 0.0, Long, Short, 0.0, 0.0, 0.0 };
 
-    sc.WriteFile(fileHandle, line, (int)strlen(line), &bytesWritten);
+    // Extra packages: latest value of each source, same sample instant
+    std::vector<double> extraValues(extras.size() * PACKAGE_FIELDS);
+    for (size_t p = 0; p < extras.size(); ++p)
+        ReadPackageValues(sc, extras[p], -1, &extraValues[p * PACKAGE_FIELDS]);
+
+    std::string line = FormatCsvRow(unixTs, row, extraValues);
+
+    sc.WriteFile(fileHandle, line.c_str(), (int)line.size(), &bytesWritten);
     sc.CloseFile(fileHandle);
 
+    PublishCommit(filePath, 1, needsHeader);
+
+    // Time-seek index: first row of each minute
+    int& LastIndexMinute = sc.GetPersistentInt(6);
+    int minute = (int)floor(unixTs / 60.0);
+    unsigned long long csvSize = 0;
+    if ((needsHeader || minute != LastIndexMinute) && GetFileSize64(filePath, csvSize) && csvSize >= line.size())
+    {
+        AppendCsvIndex(filePath, (long long)floor(unixTs * 1000.0 + 0.5), csvSize - line.size(), needsHeader);
+        LastIndexMinute = minute;
+    }
+
+    // Binary twin (.gexb), same row as written (4 decimals, 0.1 s). A day that started before the twin existed is converted whole,
+    // and so is one the row could not be appended to: readers prefer the twin, it must not fall behind.
+    // A rebuild reads the whole day, so one that keeps failing (disk full, file held open) is only
+    // retried every GEXB_RETRY_SEC; the twin is removed meanwhile and readers use the CSV.
+    int& GexbRetrySec = sc.GetPersistentInt(8);
+    std::string gexbPath = GexbPathFor(filePath);
+    std::vector<float> binRow;
+    long long binTsMs = ParseGexbRow(line, (int)(GRID_FIELDS + extraValues.size()), binRow);
+    bool appended = (needsHeader || FileExists(gexbPath)) &&
+        AppendGexbRow(gexbPath, GexbNamesFromHeader(header), binTsMs, binRow);
+    if (!appended)
+    {
+        bool retryDue = GexbRetrySec == 0 || NowSec >= GexbRetrySec || NowSec + GEXB_RETRY_SEC < GexbRetrySec;
+        std::vector<std::pair<double, std::string>> lines;
+        if (retryDue)
+            ReadCommittedCsvRows(filePath, lines);
+        if (retryDue && RebuildGexb(gexbPath, header, lines))
+            GexbRetrySec = 0;
+        else
+        {
+            std::wstring wGexb(gexbPath.begin(), gexbPath.end());
+            DeleteFileW(wGexb.c_str());
+            if (retryDue)
+            {
+                GexbRetrySec = NowSec + GEXB_RETRY_SEC;
+                if (debugLog)
+                    sc.AddMessageToLog("GexCollector: .gexb rebuild failed (file busy?), removed and retried in a minute", 0);
+            }
+        }
+    }
+
+    if (gridMode)
+    {
+        std::vector<GridSlotWrite> writes(1);
+        writes[0].Slot = gridSlot;
+        writes[0].Fields = BuildGridRow(row, extraValues);
+
+        std::string gridPath = fullDir + "\\" + ticker + ".grid";
+        if (!WriteGridSlots(gridPath, GetSessionOpenUnix(CurrentDateTime.GetDate(), StartTime), strideSec,
+                (EndTime - StartTime) / strideSec + 1, (int)writes[0].Fields.size(), writes) && debugLog)
+            sc.AddMessageToLog("GexCollector: Grid layout changed for today, slot not written (CSV only)", 0);
+
+        LastGridSlot = gridSlot;
+        LastGridDate = CurrentDateTime.GetDate();
+    }
+
+    // Day catalog: right away for a new day file, then at most once per CATALOG_UPDATE_SEC
+    int& LastCatalogSec = sc.GetPersistentInt(5);
+    if (needsHeader || NowSec - LastCatalogSec >= CATALOG_UPDATE_SEC || NowSec < LastCatalogSec)
+    {
+        CommitRecord rec;
+        long long rows = ReadCommitRecord(filePath, rec) ? (long long)rec.RowCount : -1;
+        CatalogDayFolder(dir, ticker, fullDir, GetDateYmd(sc.CurrentSystemDateTime), rows, unixTs, unixTs, !needsHeader);
+        LastCatalogSec = NowSec;
+    }
+
     LastWriteTimeSec = NowSec;
 }
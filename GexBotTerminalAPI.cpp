@@ -1,8 +1,10 @@
 #include "sierrachart.h"
 #include <set>
+#include <climits>
 #include <cfloat>
 #include <cmath>
 #include <algorithm>
+#include <charconv>
 #include <cstdio>
 #include <limits>
 
@@ -10,7 +12,11 @@
 #include <map>
 #include <vector>
 #include <sstream>
+#include <fstream>
 #include <iomanip>
+#include <atomic>
+#include <thread>
+#include <chrono>
 #define NOMINMAX
 #include <windows.h>
 
@@ -62,6 +68,250 @@ struct ProfileMetaData
     double delta_risk_reversal = 0;
 };
 
+// Series kept per timestamp, in snapshot order (see WARM-START CACHE)
+enum GammaSeries
+{
+    GS_ZERO = 0, GS_POS_VOL, GS_NEG_VOL, GS_POS_OI, GS_NEG_OI, GS_NET,
+    GS_LONG, GS_SHORT, GS_MAJ_POS, GS_MAJ_NEG, GS_SPOT, GS_COUNT
+};
+
+#define GAMMA_FILL_SEC 300.0   // A value is drawn up to this long after it was recorded
+
+// History as one sorted timestamp vector and a float column per series. A
+// series missing from a row is forward-filled on insert from its last value
+// when that is at most GAMMA_FILL_SEC older (NaN = none), so a single binary
+// search serves every series at a bar. Each cell also keeps how many rows back
+// its value was recorded, for the age check at draw time. Rows older than the
+// last one (overlapping day files) wait in Pending until Flush merges them in.
+struct SeriesStore
+{
+    static const size_t NONE = (size_t)-1;
+
+    std::vector<double> Times;                  // SCDateTime values, ascending, unique
+    std::vector<float> Columns[GS_COUNT];
+    std::vector<unsigned short> Observed;       // Bit s: series s came with the row (not filled)
+    std::vector<unsigned short> Back[GS_COUNT]; // Rows back to the one a cell's value was recorded in (0 = this one)
+
+    struct Row { double Time; float Values[GS_COUNT]; };
+    std::vector<Row> Pending;                   // Out-of-order rows, in arrival order
+    size_t Last[GS_COUNT];                      // Row of each series' latest value, NONE = none
+    double ChangedFrom;                         // Earliest time whose rows moved since the study last drew, DBL_MAX = none
+
+    SeriesStore() { Clear(); }
+
+    size_t Size() const { return Times.size() + Pending.size(); }
+    bool Empty() const { return Size() == 0; }
+
+    void Clear()
+    {
+        Times.clear();
+        Observed.clear();
+        Pending.clear();
+        for (int s = 0; s < GS_COUNT; ++s) { Columns[s].clear(); Back[s].clear(); Last[s] = NONE; }
+        ChangedFrom = -DBL_MAX;                 // Everything
+    }
+
+    // Row r takes its value from row source: recorded at most GAMMA_FILL_SEC before,
+    // and few enough rows back for Back (over 218 rows a second would not be)
+    bool Fills(size_t source, size_t r) const
+    {
+        return r - source <= USHRT_MAX && (Times[r] - Times[source]) * 86400.0 <= GAMMA_FILL_SEC;
+    }
+
+    // values: one per series, NaN = not in this row. A row at an existing time
+    // overwrites the series it carries and keeps the others.
+    void Add(double t, const float* values)
+    {
+        ChangedFrom = std::min(ChangedFrom, t);
+        if (!Pending.empty() || (!Times.empty() && t < Times.back()))
+        {
+            Row row;
+            row.Time = t;
+            memcpy(row.Values, values, sizeof(row.Values));
+            Pending.push_back(row);
+            return;
+        }
+        if (Times.empty() || t > Times.back())
+        {
+            Times.push_back(t);
+            Observed.push_back(0);
+            for (int s = 0; s < GS_COUNT; ++s) { Columns[s].push_back(NAN); Back[s].push_back(0); }
+        }
+        size_t r = Times.size() - 1;
+        for (int s = 0; s < GS_COUNT; ++s)
+        {
+            if (!std::isnan(values[s])) { Columns[s][r] = values[s]; Back[s][r] = 0; Observed[r] |= 1u << s; Last[s] = r; }
+            else if (!(Observed[r] & (1u << s))) Fill(s, r);
+        }
+    }
+
+    // Filled cell of series s at row r, from Last[s]
+    void Fill(int s, size_t r)
+    {
+        bool fills = Last[s] != NONE && Fills(Last[s], r);
+        Columns[s][r] = fills ? Columns[s][Last[s]] : NAN;
+        Back[s][r] = fills ? (unsigned short)(r - Last[s]) : 0;
+    }
+
+    // Merges Pending into the sorted rows; only the rows from the oldest pending one on are rebuilt
+    void Flush()
+    {
+        if (Pending.empty()) return;
+        std::stable_sort(Pending.begin(), Pending.end(), [](const Row& a, const Row& b) { return a.Time < b.Time; });
+        size_t from = std::lower_bound(Times.begin(), Times.end(), Pending.front().Time) - Times.begin();
+
+        std::vector<Row> pending;
+        pending.swap(Pending);
+        SeriesStore tail;
+        float values[GS_COUNT];
+        size_t i = from, j = 0;
+        while (i < Times.size() || j < pending.size())
+        {
+            // Equal times: the stored row first, so the pending one overwrites it
+            if (j == pending.size() || (i < Times.size() && Times[i] <= pending[j].Time))
+            {
+                for (int s = 0; s < GS_COUNT; ++s) values[s] = (Observed[i] & (1u << s)) ? Columns[s][i] : NAN;
+                tail.Add(Times[i++], values);
+            }
+            else
+            {
+                tail.Add(pending[j].Time, pending[j].Values);
+                ++j;
+            }
+        }
+        Truncate(from);
+        Append(tail);
+        Refill(from);
+    }
+
+    // Moves other's rows in (other is left empty)
+    void MergeFrom(SeriesStore& other)
+    {
+        other.Flush();
+        Flush();
+        if (other.Times.empty()) return;
+        double changedFrom = std::min(ChangedFrom, other.Times.front());
+        if (Times.empty())
+        {
+            *this = std::move(other);
+        }
+        else if (other.Times.front() > Times.back())
+        {
+            // Chunks merged in time order: a plain append
+            size_t from = Times.size();
+            Append(other);
+            Refill(from);
+        }
+        else
+        {
+            float values[GS_COUNT];
+            for (size_t k = 0; k < other.Times.size(); ++k)
+            {
+                for (int s = 0; s < GS_COUNT; ++s) values[s] = (other.Observed[k] & (1u << s)) ? other.Columns[s][k] : NAN;
+                Add(other.Times[k], values);
+            }
+            Flush();
+        }
+        ChangedFrom = changedFrom;
+        other.Clear();
+    }
+
+    // Row of the last time <= t, NONE before the first one. Bars are visited in
+    // increasing time: cursor (rows <= the previous t, 0 to start) walks forward
+    // from there, so a full recalculation costs O(bars + rows) instead of a
+    // search per bar; a t before the previous one searches again.
+    size_t Seek(double t, size_t& cursor) const
+    {
+        if (cursor > Times.size() || (cursor > 0 && Times[cursor - 1] > t))
+            cursor = std::upper_bound(Times.begin(), Times.end(), t) - Times.begin();
+        while (cursor < Times.size() && Times[cursor] <= t) ++cursor;
+        return cursor == 0 ? NONE : cursor - 1;
+    }
+
+    // Time series s was last recorded at, as of row
+    double SourceTime(size_t row, int s) const { return Times[row - Back[s][row]]; }
+
+    // Drops the rows in [from, to); the cells after them that filled from them are filled again
+    void Erase(double from, double to)
+    {
+        Flush();
+        size_t a = std::lower_bound(Times.begin(), Times.end(), from) - Times.begin();
+        size_t b = std::lower_bound(Times.begin(), Times.end(), to) - Times.begin();
+        if (a == b) return;
+        ChangedFrom = std::min(ChangedFrom, from);
+        Times.erase(Times.begin() + a, Times.begin() + b);
+        Observed.erase(Observed.begin() + a, Observed.begin() + b);
+        for (int s = 0; s < GS_COUNT; ++s)
+        {
+            Columns[s].erase(Columns[s].begin() + a, Columns[s].begin() + b);
+            Back[s].erase(Back[s].begin() + a, Back[s].begin() + b);
+        }
+        Refill(a);
+    }
+
+    void Truncate(size_t rows)
+    {
+        Times.resize(rows);
+        Observed.resize(rows);
+        for (int s = 0; s < GS_COUNT; ++s) { Columns[s].resize(rows); Back[s].resize(rows); }
+    }
+
+    void Append(const SeriesStore& other)
+    {
+        Times.insert(Times.end(), other.Times.begin(), other.Times.end());
+        Observed.insert(Observed.end(), other.Observed.begin(), other.Observed.end());
+        for (int s = 0; s < GS_COUNT; ++s)
+        {
+            Columns[s].insert(Columns[s].end(), other.Columns[s].begin(), other.Columns[s].end());
+            Back[s].insert(Back[s].end(), other.Back[s].begin(), other.Back[s].end());
+        }
+    }
+
+    // Recomputes the filled cells from row `from` on, and Last
+    void Refill(size_t from)
+    {
+        for (int s = 0; s < GS_COUNT; ++s)
+        {
+            // Source of row from - 1 (a NaN = none)
+            Last[s] = (from > 0 && !std::isnan(Columns[s][from - 1])) ? from - 1 - Back[s][from - 1] : NONE;
+
+            for (size_t r = from; r < Times.size(); ++r)
+            {
+                if (Observed[r] & (1u << s)) { Last[s] = r; Back[s][r] = 0; }
+                else Fill(s, r);
+            }
+        }
+    }
+};
+
+// Chart times of the first and last row read from one file (From > To = none yet)
+struct LoadedSpan
+{
+    double From = DBL_MAX;
+    double To = -DBL_MAX;
+
+    void Widen(double t) { From = std::min(From, t); To = std::max(To, t); }
+    void Widen(const LoadedSpan& other) { From = std::min(From, other.From); To = std::max(To, other.To); }
+};
+
+// Formats of each day in the ticker's catalog (see DAY CATALOG), kept between refreshes
+struct DayCatalog
+{
+    std::string Path;
+    unsigned long long Size = 0;        // Of the file when read, with WriteTime: read again when either changes
+    unsigned long long WriteTime = 0;
+    std::map<int, std::set<std::string>> Days;
+
+    // Between the first and the last day listed, the catalog speaks for every day
+    bool Covers(int ymd) const { return !Days.empty() && ymd >= Days.begin()->first && ymd <= Days.rbegin()->first; }
+
+    bool Lists(int ymd, const char* format) const
+    {
+        auto day = Days.find(ymd);
+        return day != Days.end() && day->second.count(format) > 0;
+    }
+};
+
 struct GammaData
 {
     // Majors endpoint
@@ -87,28 +337,40 @@ struct GammaData
     bool StateEndpointAvailable = false;
     bool FetchCycleDataDirty = false;
 
-    // Historical maps for forward fill - using SCDateTime directly
-    std::map<SCDateTime, float> zeroMap;
-    std::map<SCDateTime, float> posVolMap;
-    std::map<SCDateTime, float> negVolMap;
-    std::map<SCDateTime, float> posOiMap;
-    std::map<SCDateTime, float> negOiMap;
-    std::map<SCDateTime, float> netMap;
-    std::map<SCDateTime, float> longMap;
-    std::map<SCDateTime, float> shortMap;
-    std::map<SCDateTime, float> majPosMap;
-    std::map<SCDateTime, float> majNegMap;
-    std::map<SCDateTime, float> spotMap;
+    // History of every series, forward-filled on insert (see SeriesStore)
+    SeriesStore Series;
+    size_t BarCursor = 0;               // Series.Seek position of the last bar drawn
     
     std::set<std::string> CachedFilePaths;
+    // Read cursor per day file: byte offset just past the last parsed row (.csv) or row count (.gexb)
+    std::map<std::string, unsigned long long> FileOffsets;
+    // File identity at the time of that cursor; a change means the file was replaced (e.g. Collector backfill)
+    std::map<std::string, unsigned long long> FileIds;
+    // values[] slot of each CSV column (-1 = not read), from its header and the field mask
+    std::map<std::string, std::vector<int>> ColumnSlots;
+    // Rows read from each day file; a warm start drops exactly this span of a file that changed
+    std::map<std::string, LoadedSpan> LoadedSpans;
+    DayCatalog Catalog;                 // Day catalog of the ticker (see DAY CATALOG)
     SCDateTime LastRefreshTime;
+    SCDateTime LastCatalogUpdate;
+    long long LastIndexMinute = -1;     // Minute of the last time-seek index entry written
+    long long CsvLoadedFromMs = LLONG_MAX; // Window start the cached days were read from (LLONG_MAX = none yet)
+    SCDateTime LastCacheSave;           // Warm-start snapshot (see WARM-START CACHE)
+    size_t CacheSavedRows = 0;
     
     std::string LastBasePath;
     std::string LastTickerForFile;
     int LastDaysCount = -1;
     int LastTZOffset = -999;
+    unsigned int LastFieldMask = 0;     // CSV columns the series were parsed with (GAMMA_BASE_FIELDS + shown OI walls)
     
     bool HistoricalDataLoaded = false;
+
+    // Time-budgeted loading (see LOAD BUDGET): a read stopped at the deadline, in which file and how far
+    bool LoadPending = false;
+    std::string LoadingPath;
+    int LoadingPercent = 0;
+    std::string ShownProgress;          // Text of the progress drawing on the chart ("" = none)
 };
 
 // =========================
@@ -321,354 +583,1766 @@ bool FileExists(const std::string& path)
     return (dwAttrib != INVALID_FILE_ATTRIBUTES && !(dwAttrib & FILE_ATTRIBUTE_DIRECTORY));
 }
 
-// CSV header line
-static const char* CSV_HEADER = "timestamp,spot,zero_gamma,major_pos_vol,major_neg_vol,"
-    "major_pos_oi,major_neg_oi,sum_gex_vol,sum_gex_oi,delta_risk_reversal,"
-    "major_long_gamma,major_short_gamma,major_positive,major_negative,net\r\n";
+bool GetFileSize64(const std::string& path, unsigned long long& size)
+{
+    std::wstring wPath(path.begin(), path.end());
+    WIN32_FILE_ATTRIBUTE_DATA info;
+    if (!GetFileAttributesExW(wPath.c_str(), GetFileExInfoStandard, &info)) return false;
+    size = ((unsigned long long)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+    return true;
+}
 
-// Write a single data row to a CSV file (append mode)
-bool WriteToCsvFile(SCStudyInterfaceRef sc, GammaData* data, const std::string& csvPath)
+// Volume serial + NTFS file index. Survives appends, changes when the file is
+// swapped in by rename (creation time does not, because of tunneling).
+bool GetFileId(const std::string& path, unsigned long long& id)
 {
-    if (csvPath.empty()) return false;
+    std::wstring wPath(path.begin(), path.end());
+    HANDLE h = CreateFileW(wPath.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return false;
 
-    EnsureDirectoryExists(csvPath);
+    BY_HANDLE_FILE_INFORMATION info;
+    BOOL ok = GetFileInformationByHandle(h, &info);
+    CloseHandle(h);
+    if (!ok) return false;
 
-    // Check if file exists to decide whether to write header
-    bool needsHeader = !FileExists(csvPath);
+    id = (((unsigned long long)info.nFileIndexHigh << 32) | info.nFileIndexLow) ^ ((unsigned long long)info.dwVolumeSerialNumber << 48);
+    return true;
+}
 
-    // Open file for append
-    int fileHandle = 0;
-    SCString scPath(csvPath.c_str());
-    if (!sc.OpenFile(scPath, n_ACSIL::FILE_MODE_OPEN_TO_APPEND, fileHandle))
+// Read-only view of a whole file; unmapped on Close/destruction so writers can still replace it
+struct MappedFile
+{
+    HANDLE File = INVALID_HANDLE_VALUE;
+    HANDLE Mapping = NULL;
+    const char* Data = nullptr;
+    unsigned long long Size = 0;
+
+    bool Open(const std::string& path)
     {
-        // File doesn't exist yet - create it
-        if (!sc.OpenFile(scPath, n_ACSIL::FILE_MODE_CREATE_AND_OPEN_FOR_READ_WRITE, fileHandle))
-        {
-            data->LastError = "Failed to open CSV file for writing";
-            return false;
-        }
-        needsHeader = true;
+        std::wstring wPath(path.begin(), path.end());
+        File = CreateFileW(wPath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (File == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(File, &size) || size.QuadPart == 0) { Close(); return false; }
+        Size = (unsigned long long)size.QuadPart;
+
+        Mapping = CreateFileMappingW(File, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!Mapping) { Close(); return false; }
+        Data = (const char*)MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!Data) { Close(); return false; }
+        return true;
     }
 
-    unsigned int bytesWritten = 0;
-
-    // Write header if new file
-    if (needsHeader)
+    void Close()
     {
-        int headerLen = (int)strlen(CSV_HEADER);
-        sc.WriteFile(fileHandle, CSV_HEADER, headerLen, &bytesWritten);
+        if (Data) UnmapViewOfFile(Data);
+        if (Mapping) CloseHandle(Mapping);
+        if (File != INVALID_HANDLE_VALUE) CloseHandle(File);
+        Data = nullptr;
+        Mapping = NULL;
+        File = INVALID_HANDLE_VALUE;
+        Size = 0;
     }
 
-    // Build data line
-    double scDateTime = sc.CurrentSystemDateTime.GetAsDouble();
-    double unixTimestamp = (scDateTime - 25569.0) * 86400.0;
-
-    double spot = 0.0;
-    if (sc.BaseData[SC_CLOSE].GetArraySize() > 0 && sc.Index >= 0)
-        spot = sc.BaseData[SC_CLOSE][sc.Index];
+    ~MappedFile() { Close(); }
+};
 
-    double netGex = data->Majors.mpos_vol - fabs(data->Majors.mneg_vol);
-    double zeroGamma = data->ProfileMeta.zero_gamma != 0 ? data->ProfileMeta.zero_gamma : data->Majors.zero_gamma;
-    double net = spot + netGex / 100.0;
+// =========================
+//     COMMIT PROTOCOL
+// =========================
+// After every flush the writer publishes the byte length of fully written rows
+// in "<file>.commit". Readers never parse past it, so a half-flushed row is
+// never seen. Same record layout as GexBotDataCollector.cpp.
 
-    char line[1024];
-    int lineLen = snprintf(line, sizeof(line),
-        "%.1f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f\r\n",
-        unixTimestamp,
-        spot,
-        zeroGamma,
-        data->Majors.mpos_vol,
-        data->Majors.mneg_vol,
-        data->Majors.mpos_oi,
-        data->Majors.mneg_oi,
-        data->ProfileMeta.sum_gex_vol,
-        data->ProfileMeta.sum_gex_oi,
-        data->ProfileMeta.delta_risk_reversal,
-        data->Greeks.major_long_gamma,
-        data->Greeks.major_short_gamma,
-        data->Greeks.major_positive,
-        data->Greeks.major_negative,
-        net);
+#define COMMIT_MAGIC   0x4D435847u  // "GXCM"
+#define COMMIT_VERSION 1u
 
-    sc.WriteFile(fileHandle, line, lineLen, &bytesWritten);
-    sc.CloseFile(fileHandle);
+struct CommitRecord
+{
+    unsigned int Magic;
+    unsigned int Version;
+    unsigned long long CommittedBytes;
+    unsigned long long RowCount;
+    unsigned long long Checksum;
+};
 
-    return true;
+unsigned long long CommitChecksum(const CommitRecord& rec)
+{
+    return (rec.CommittedBytes * 0x9E3779B97F4A7C15ull) ^ (rec.RowCount + 0x632BE59BD9B4E019ull) ^ rec.Magic;
 }
 
-// Parse a single CSV line into an array of doubles
-// Returns number of fields parsed
-int ParseCsvLine(const std::string& line, double* values, int maxFields)
+bool ReadCommitRecord(const std::string& dataPath, CommitRecord& rec)
 {
-    int count = 0;
-    size_t start = 0;
-    size_t pos = 0;
-
-    while (pos <= line.length() && count < maxFields)
-    {
-        if (pos == line.length() || line[pos] == ',')
-        {
-            std::string field = line.substr(start, pos - start);
-            // Trim whitespace
-            while (!field.empty() && (field.front() == ' ' || field.front() == '\t'))
-                field.erase(0, 1);
-            while (!field.empty() && (field.back() == ' ' || field.back() == '\t' || field.back() == '\r' || field.back() == '\n'))
-                field.pop_back();
-
-            values[count] = StringToDouble(field);
-            count++;
-            start = pos + 1;
-        }
-        pos++;
-    }
-
-    return count;
+    std::string commitPath = dataPath + ".commit";
+    std::wstring wPath(commitPath.begin(), commitPath.end());
+    HANDLE h = CreateFileW(wPath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return false;
+
+    DWORD bytesRead = 0;
+    BOOL ok = ReadFile(h, &rec, sizeof(rec), &bytesRead, NULL);
+    CloseHandle(h);
+
+    return ok && bytesRead == sizeof(rec) && rec.Magic == COMMIT_MAGIC &&
+        rec.Version == COMMIT_VERSION && rec.Checksum == CommitChecksum(rec);
 }
 
-// Load historical data from a single CSV file
-int LoadSingleCSV(SCStudyInterfaceRef sc, const std::string& fullPath, int tzOffsetHours, GammaData* data)
+// Publish the current length of dataPath as committed (after the file is closed)
+void PublishCommit(const std::string& dataPath, unsigned long long rowsAppended, bool freshFile)
 {
-    int rowCount = 0;
+    unsigned long long fileSize = 0;
+    if (!GetFileSize64(dataPath, fileSize)) return;
+
+    CommitRecord prev;
+    unsigned long long prevRows = 0;
+    if (!freshFile && ReadCommitRecord(dataPath, prev) && prev.CommittedBytes <= fileSize)
+        prevRows = prev.RowCount;
+
+    CommitRecord rec;
+    rec.Magic = COMMIT_MAGIC;
+    rec.Version = COMMIT_VERSION;
+    rec.CommittedBytes = fileSize;
+    rec.RowCount = prevRows + rowsAppended;
+    rec.Checksum = CommitChecksum(rec);
+
+    std::string commitPath = dataPath + ".commit";
+    std::wstring wPath(commitPath.begin(), commitPath.end());
+    HANDLE h = CreateFileW(wPath.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return;
+
+    DWORD bytesWritten = 0;
+    WriteFile(h, &rec, sizeof(rec), &bytesWritten, NULL);
+    CloseHandle(h);
+}
 
-    int fileHandle = 0;
-    SCString scPath(fullPath.c_str());
-    if (!sc.OpenFile(scPath, n_ACSIL::FILE_MODE_OPEN_EXISTING_FOR_SEQUENTIAL_READING, fileHandle))
-    {
-        SCString msg;
-        msg.Format("GEX_TERMINAL: Cannot open %s", fullPath.c_str());
-        sc.AddMessageToLog(msg, 0);
-        return 0;
-    }
+// Readable end of a data file: the committed length when the writer published
+// one, otherwise the physical size (the caller still stops at the last newline).
+unsigned long long GetCommittedLength(const std::string& dataPath, unsigned long long fileSize)
+{
+    CommitRecord rec;
+    if (ReadCommitRecord(dataPath, rec) && rec.CommittedBytes <= fileSize)
+        return rec.CommittedBytes;
+    return fileSize;
+}
 
-    // Read entire file into a buffer
-    // CSV files for daily data are small (< 100KB typically)
-    const int BUFFER_SIZE = 256 * 1024; // 256KB max
-    char* buffer = new char[BUFFER_SIZE];
-    unsigned int bytesRead = 0;
-    int totalRead = 0;
+// CSV header line
+static const char* CSV_HEADER = "timestamp,spot,zero_gamma,major_pos_vol,major_neg_vol,"
+    "major_pos_oi,major_neg_oi,sum_gex_vol,sum_gex_oi,delta_risk_reversal,"
+    "major_long_gamma,major_short_gamma,major_positive,major_negative,net\r\n";
 
-    while (sc.ReadFile(fileHandle, buffer + totalRead, BUFFER_SIZE - totalRead - 1, &bytesRead) && bytesRead > 0)
-    {
-        totalRead += bytesRead;
-        if (totalRead >= BUFFER_SIZE - 1) break;
-        bytesRead = 0;
-    }
-    buffer[totalRead] = '\0';
-    sc.CloseFile(fileHandle);
+// =========================
+//     TIME-SEEK INDEX
+// =========================
+// "<file>.idx" next to a day CSV, same format as GexBotDataCollector.cpp: a
+// header, then one (Unix ms, byte offset) entry for the first row of every
+// minute, appended after the row is committed.
 
-    if (totalRead == 0)
-    {
-        delete[] buffer;
-        return 0;
-    }
+#define CSV_INDEX_MAGIC   0x58495847u  // "GXIX"
+#define CSV_INDEX_VERSION 1u
+#define CSV_INDEX_STEP_MS 60000
 
-    // Parse line by line
-    std::string content(buffer, totalRead);
-    delete[] buffer;
+struct CsvIndexHeader
+{
+    unsigned int Magic;
+    unsigned int Version;
+};
 
-    size_t lineStart = 0;
-    bool isFirstLine = true;
+struct CsvIndexEntry
+{
+    long long TsMs;             // Timestamp of the row starting at Offset
+    unsigned long long Offset;  // Byte offset of that row in the CSV
+};
 
-    while (lineStart < content.length())
+// Adds an entry for the row at rowOffset if it opens a new minute. freshFile
+// starts a new index (the CSV was just created).
+void AppendCsvIndex(const std::string& csvPath, long long tsMs, unsigned long long rowOffset, bool freshFile)
+{
+    std::string idxPath = csvPath + ".idx";
+    std::wstring wPath(idxPath.begin(), idxPath.end());
+    HANDLE h = CreateFileW(wPath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, freshFile ? CREATE_ALWAYS : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(h, &size)) { CloseHandle(h); return; }
+
+    DWORD bytes = 0;
+    CsvIndexHeader hdr = { CSV_INDEX_MAGIC, CSV_INDEX_VERSION };
+    unsigned long long end = sizeof(hdr);
+    if ((unsigned long long)size.QuadPart < sizeof(hdr))
     {
-        size_t lineEnd = content.find('\n', lineStart);
-        if (lineEnd == std::string::npos)
-            lineEnd = content.length();
-
-        std::string line = content.substr(lineStart, lineEnd - lineStart);
-        lineStart = lineEnd + 1;
-
-        // Trim trailing \r
-        while (!line.empty() && (line.back() == '\r' || line.back() == '\n'))
-            line.pop_back();
-
-        if (line.empty()) continue;
-
-        // Skip header line
-        if (isFirstLine)
+        WriteFile(h, &hdr, sizeof(hdr), &bytes, NULL);
+    }
+    else
+    {
+        CsvIndexHeader existing;
+        if (!ReadFile(h, &existing, sizeof(existing), &bytes, NULL) || bytes != sizeof(existing) ||
+            existing.Magic != CSV_INDEX_MAGIC || existing.Version != CSV_INDEX_VERSION)
         {
-            isFirstLine = false;
-            // Check if this is actually a header (starts with "timestamp" or non-numeric)
-            if (line.find("timestamp") != std::string::npos || (!line.empty() && !isdigit(line[0]) && line[0] != '-'))
-                continue;
+            CloseHandle(h);
+            return;
         }
 
-        // Parse CSV fields:
-        // 0:timestamp, 1:spot, 2:zero_gamma, 3:major_pos_vol, 4:major_neg_vol,
-        // 5:major_pos_oi, 6:major_neg_oi, 7:sum_gex_vol, 8:sum_gex_oi,
-        // 9:delta_risk_reversal, 10:major_long_gamma, 11:major_short_gamma,
-        // 12:major_positive, 13:major_negative, 14:net
-        double values[15] = {0};
-        int fieldCount = ParseCsvLine(line, values, 15);
-        if (fieldCount < 5) continue; // Need at least timestamp + a few fields
-
-        double ts = values[0];
-        if (ts <= 0) continue;
-
-        // Convert Unix timestamp to SCDateTime with timezone offset
-        SCDateTime dt((ts + tzOffsetHours * 3600.0) / 86400.0 + 25569.0);
-
-        double spot  = values[1];
-        double zero  = values[2];
-        double posv  = values[3];
-        double negv  = values[4];
-        double posoi = (fieldCount > 5) ? values[5] : 0;
-        double negoi = (fieldCount > 6) ? values[6] : 0;
-        // 7:sum_gex_vol, 8:sum_gex_oi, 9:delta_risk_reversal (skipped for maps)
-        double lng   = (fieldCount > 10) ? values[10] : 0;
-        double sht   = (fieldCount > 11) ? values[11] : 0;
-        double mjp   = (fieldCount > 12) ? values[12] : 0;
-        double mjn   = (fieldCount > 13) ? values[13] : 0;
-
-        // Store in maps (map overwrites duplicates naturally)
-        if (!std::isnan(spot) && spot != 0) data->spotMap[dt] = static_cast<float>(spot);
-        if (!std::isnan(zero) && zero != 0) data->zeroMap[dt] = static_cast<float>(zero);
-        if (!std::isnan(posv) && posv != 0) data->posVolMap[dt] = static_cast<float>(posv);
-        if (!std::isnan(negv) && negv != 0) data->negVolMap[dt] = static_cast<float>(negv);
-        if (!std::isnan(posoi) && posoi != 0) data->posOiMap[dt] = static_cast<float>(posoi);
-        if (!std::isnan(negoi) && negoi != 0) data->negOiMap[dt] = static_cast<float>(negoi);
-        if (!std::isnan(lng) && lng != 0) data->longMap[dt] = static_cast<float>(lng);
-        if (!std::isnan(sht) && sht != 0) data->shortMap[dt] = static_cast<float>(sht);
-        if (!std::isnan(mjp) && mjp != 0) data->majPosMap[dt] = static_cast<float>(mjp);
-        if (!std::isnan(mjn) && mjn != 0) data->majNegMap[dt] = static_cast<float>(mjn);
-
-        // Calculate net (spot + netGex / 100.0)
-        if (!std::isnan(spot) && !std::isnan(posv) && !std::isnan(negv))
+        // Whole entries only: a torn tail is overwritten
+        unsigned long long count = ((unsigned long long)size.QuadPart - sizeof(hdr)) / sizeof(CsvIndexEntry);
+        end = sizeof(hdr) + count * sizeof(CsvIndexEntry);
+        if (count > 0)
         {
-            double netGex = posv - fabs(negv);
-            data->netMap[dt] = static_cast<float>(spot + netGex / 100.0);
+            CsvIndexEntry last;
+            LARGE_INTEGER pos;
+            pos.QuadPart = (LONGLONG)(end - sizeof(CsvIndexEntry));
+            SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+            if (ReadFile(h, &last, sizeof(last), &bytes, NULL) && bytes == sizeof(last) &&
+                (tsMs / CSV_INDEX_STEP_MS <= last.TsMs / CSV_INDEX_STEP_MS || rowOffset <= last.Offset))
+            {
+                CloseHandle(h);
+                return;
+            }
         }
-
-        ++rowCount;
     }
 
-    if (rowCount > 0)
-    {
-        SCString msg;
-        msg.Format("GEX_TERMINAL: Loaded %d rows from %s", rowCount, fullPath.c_str());
-        sc.AddMessageToLog(msg, 0);
-    }
+    CsvIndexEntry entry = { tsMs, rowOffset };
+    LARGE_INTEGER pos;
+    pos.QuadPart = (LONGLONG)end;
+    SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+    WriteFile(h, &entry, sizeof(entry), &bytes, NULL);
+    CloseHandle(h);
+}
 
-    return rowCount;
+// Where to start parsing csvPath for rows at or after fromMs: the last indexed
+// row at or before fromMs. 0 (read from the top) when there is no usable index.
+// The row at the offset is checked against the entry, so an index left over
+// from a replaced CSV is never trusted.
+unsigned long long FindCsvSeekOffset(const std::string& csvPath, long long fromMs, unsigned long long limit)
+{
+    std::ifstream idx(csvPath + ".idx", std::ios::binary);
+    if (!idx.is_open()) return 0;
+
+    CsvIndexHeader hdr;
+    if (!idx.read((char*)&hdr, sizeof(hdr)) || hdr.Magic != CSV_INDEX_MAGIC || hdr.Version != CSV_INDEX_VERSION)
+        return 0;
+
+    std::vector<CsvIndexEntry> entries;
+    CsvIndexEntry e;
+    while (idx.read((char*)&e, sizeof(e)))
+        entries.push_back(e);
+
+    auto it = std::upper_bound(entries.begin(), entries.end(), fromMs,
+        [](long long ts, const CsvIndexEntry& entry) { return ts < entry.TsMs; });
+    if (it == entries.begin()) return 0;
+    --it;
+    if (it->Offset == 0 || it->Offset >= limit) return 0;
+
+    std::ifstream csv(csvPath, std::ios::binary);
+    char probe[40] = {0};
+    csv.seekg((std::streamoff)(it->Offset - 1));
+    csv.read(probe, sizeof(probe) - 1);
+    if (csv.gcount() < 2 || probe[0] != '\n') return 0;
+    double ts = strtod(probe + 1, nullptr);
+    if ((long long)floor(ts * 1000.0 + 0.5) != it->TsMs) return 0;
+
+    return it->Offset;
 }
 
 // =========================
-//     DATE/TIME HELPERS
+//   BINARY DAY FILE (.gexb)
 // =========================
+// Columnar twin of the CSV, same layout as GexBotDataCollector.cpp: header,
+// field names, int64 Unix-ms timestamp column, one float column per field,
+// each Capacity rows long. RowCount is bumped after the row is on disk.
 
-// Helper to format date as MM.dd.yyyy
-std::string FormatDateSuffix(const SCDateTime& dt)
+#define GEXB_MAGIC            0x4E425847u  // "GXBN"
+#define GEXB_VERSION          1u
+#define GEXB_INITIAL_CAPACITY 4096
+
+struct GexbHeader
 {
-    int year = dt.GetYear();
-    int month = dt.GetMonth();
-    int day = dt.GetDay();
-    
-    char buffer[20];
-    snprintf(buffer, sizeof(buffer), "%02d.%02d.%04d", month, day, year);
-    return buffer;
-}
+    unsigned int Magic;
+    unsigned int Version;
+    int FieldCount;
+    int Capacity;
+    int RowCount;
+    int NamesBytes;
+};
 
-SCDateTime SubtractDays(SCDateTime base, int days)
+unsigned long long GexbTsOffset(const GexbHeader& h, int row)
 {
-    double adjusted = base.GetAsDouble() - days;
-    return SCDateTime(adjusted);
+    return sizeof(GexbHeader) + (unsigned long long)h.NamesBytes + (unsigned long long)row * sizeof(long long);
 }
 
-// Forward fill: find the most recent value <= targetTime with 5 minute tolerance
-float GetValueAtTime(const std::map<SCDateTime, float>& map, SCDateTime targetTime)
+unsigned long long GexbFieldOffset(const GexbHeader& h, int field, int row)
 {
-    if (map.empty()) return -FLT_MAX;
-
-    auto it = map.upper_bound(targetTime);
-    if (it == map.begin()) return -FLT_MAX;
-
-    --it;
-    
-    double delta = fabs((targetTime - it->first).GetAsDouble() * 86400.0);
-    if (delta <= 300.0)
-        return it->second;
-    
-    return -FLT_MAX;
+    return GexbTsOffset(h, h.Capacity) + ((unsigned long long)field * h.Capacity + row) * sizeof(float);
 }
 
-// =========================
-//  HISTORICAL DATA LOADING
-// =========================
+std::string GexbPathFor(const std::string& csvPath)
+{
+    return csvPath.substr(0, csvPath.find_last_of('.')) + ".gexb";
+}
 
-void LoadRecentGammaFiles(SCStudyInterfaceRef sc, GammaData* data, const std::string& baseFolder, const std::string& ticker, int days, int tzOffset, int refreshSeconds)
+// Writes a complete file (values row-major, fieldCount per row) and swaps it in
+bool WriteGexbFile(const std::string& path, const std::string& names, int fieldCount, int capacity,
+    const std::vector<long long>& ts, const std::vector<float>& values)
 {
-    // Clear if parameters changed
-    if (baseFolder != data->LastBasePath || ticker != data->LastTickerForFile || days != data->LastDaysCount || tzOffset != data->LastTZOffset)
+    GexbHeader hdr;
+    hdr.Magic = GEXB_MAGIC;
+    hdr.Version = GEXB_VERSION;
+    hdr.FieldCount = fieldCount;
+    hdr.Capacity = capacity < (int)ts.size() ? (int)ts.size() : capacity;
+    hdr.RowCount = (int)ts.size();
+    hdr.NamesBytes = (int)((names.size() + 1 + 7) & ~(size_t)7);
+
+    std::vector<char> out((size_t)GexbFieldOffset(hdr, fieldCount, 0), 0);
+    memcpy(&out[0], &hdr, sizeof(hdr));
+    memcpy(&out[sizeof(hdr)], names.data(), names.size());
+    for (int r = 0; r < hdr.RowCount; ++r)
     {
-        data->CachedFilePaths.clear();
-        data->zeroMap.clear();
-        data->posVolMap.clear();
-        data->negVolMap.clear();
-        data->posOiMap.clear();
-        data->negOiMap.clear();
-        data->netMap.clear();
-        data->longMap.clear();
-        data->shortMap.clear();
-        data->majPosMap.clear();
-        data->majNegMap.clear();
-        data->spotMap.clear();
-
-        data->LastBasePath = baseFolder;
-        data->LastTickerForFile = ticker;
-        data->LastDaysCount = days;
-        data->LastTZOffset = tzOffset;
+        memcpy(&out[(size_t)GexbTsOffset(hdr, r)], &ts[r], sizeof(long long));
+        for (int f = 0; f < fieldCount; ++f)
+            memcpy(&out[(size_t)GexbFieldOffset(hdr, f, r)], &values[(size_t)r * fieldCount + f], sizeof(float));
+    }
+
+    std::string tmpPath = path + ".tmp";
+    std::wstring wTmp(tmpPath.begin(), tmpPath.end());
+    std::wstring wPath(path.begin(), path.end());
+    HANDLE h = CreateFileW(wTmp.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return false;
+
+    DWORD bytes = 0;
+    BOOL ok = WriteFile(h, out.data(), (DWORD)out.size(), &bytes, NULL) && bytes == out.size();
+    CloseHandle(h);
+
+    if (!ok || !MoveFileExW(wTmp.c_str(), wPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        DeleteFileW(wTmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Appends one row. Returns false if the existing file has a different schema.
+// rowCount (optional) receives the file's row count after the append.
+bool AppendGexbRow(const std::string& path, const std::string& names, long long tsMs, const std::vector<float>& row,
+    int* rowCount = nullptr)
+{
+    int fieldCount = (int)row.size();
+    if (!FileExists(path))
+    {
+        if (rowCount) *rowCount = 1;
+        return WriteGexbFile(path, names, fieldCount, GEXB_INITIAL_CAPACITY, std::vector<long long>(1, tsMs), row);
+    }
+
+    std::wstring wPath(path.begin(), path.end());
+    HANDLE h = CreateFileW(wPath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return false;
+
+    GexbHeader hdr;
+    DWORD bytes = 0;
+    std::string fileNames;
+    bool ok = ReadFile(h, &hdr, sizeof(hdr), &bytes, NULL) && bytes == sizeof(hdr) &&
+        hdr.Magic == GEXB_MAGIC && hdr.Version == GEXB_VERSION && hdr.FieldCount == fieldCount && hdr.NamesBytes > 0;
+    if (ok)
+    {
+        fileNames.resize(hdr.NamesBytes);
+        ok = ReadFile(h, &fileNames[0], hdr.NamesBytes, &bytes, NULL) && bytes == (DWORD)hdr.NamesBytes;
+        fileNames.resize(strlen(fileNames.c_str()));
+        ok = ok && fileNames == names;
+    }
+    if (!ok)
+    {
+        CloseHandle(h);
+        return false;
+    }
+
+    if (hdr.RowCount >= hdr.Capacity)
+    {
+        // Full: read the columns back and rewrite at double capacity
+        std::vector<long long> ts(hdr.RowCount + 1);
+        std::vector<float> values((size_t)(hdr.RowCount + 1) * fieldCount);
+        LARGE_INTEGER pos;
+        pos.QuadPart = (LONGLONG)GexbTsOffset(hdr, 0);
+        SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+        ReadFile(h, ts.data(), (DWORD)(hdr.RowCount * sizeof(long long)), &bytes, NULL);
+
+        std::vector<float> column(hdr.Capacity);
+        for (int f = 0; f < fieldCount; ++f)
+        {
+            pos.QuadPart = (LONGLONG)GexbFieldOffset(hdr, f, 0);
+            SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+            ReadFile(h, column.data(), (DWORD)(hdr.RowCount * sizeof(float)), &bytes, NULL);
+            for (int r = 0; r < hdr.RowCount; ++r) values[(size_t)r * fieldCount + f] = column[r];
+        }
+        CloseHandle(h);
+
+        ts[hdr.RowCount] = tsMs;
+        for (int f = 0; f < fieldCount; ++f) values[(size_t)hdr.RowCount * fieldCount + f] = row[f];
+        if (rowCount) *rowCount = hdr.RowCount + 1;
+        return WriteGexbFile(path, names, fieldCount, hdr.Capacity * 2, ts, values);
+    }
+
+    LARGE_INTEGER pos;
+    pos.QuadPart = (LONGLONG)GexbTsOffset(hdr, hdr.RowCount);
+    SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+    WriteFile(h, &tsMs, sizeof(tsMs), &bytes, NULL);
+    for (int f = 0; f < fieldCount; ++f)
+    {
+        pos.QuadPart = (LONGLONG)GexbFieldOffset(hdr, f, hdr.RowCount);
+        SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+        WriteFile(h, &row[f], sizeof(float), &bytes, NULL);
+    }
+
+    // Publish the row
+    hdr.RowCount++;
+    pos.QuadPart = 0;
+    SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+    WriteFile(h, &hdr, sizeof(hdr), &bytes, NULL);
+    CloseHandle(h);
+    if (rowCount) *rowCount = hdr.RowCount;
+    return true;
+}
+
+// Field names = CSV header without "timestamp," and the line ending
+std::string GexbNamesFromHeader(const std::string& header)
+{
+    size_t first = header.find(',') + 1;
+    size_t end = header.find_last_not_of("\r\n") + 1;
+    return header.substr(first, end - first);
+}
+
+// Converts a day that already has CSV rows (first .gexb write after an upgrade)
+bool RebuildGexbFromCsv(const std::string& csvPath, const std::string& gexbPath, const std::string& header)
+{
+    unsigned long long fileSize = 0;
+    if (!GetFileSize64(csvPath, fileSize)) return false;
+    unsigned long long committed = GetCommittedLength(csvPath, fileSize);
+
+    std::ifstream in(csvPath, std::ios::binary);
+    std::string content((size_t)committed, '\0');
+    in.read(&content[0], (std::streamsize)content.size());
+    content.resize((size_t)in.gcount());
+
+    int fieldCount = (int)std::count(header.begin(), header.end(), ',');
+    std::vector<long long> ts;
+    std::vector<float> values;
+    size_t lineStart = 0;
+    while (lineStart < content.size())
+    {
+        size_t lineEnd = content.find('\n', lineStart);
+        if (lineEnd == std::string::npos) break; // Torn tail
+        const char* line = content.c_str() + lineStart;
+        lineStart = lineEnd + 1;
+        if (!isdigit((unsigned char)line[0]) && line[0] != '-') continue; // Header / empty
+
+        char* p = nullptr;
+        double t = strtod(line, &p);
+        if (t <= 0) continue;
+        ts.push_back((long long)floor(t * 1000.0 + 0.5));
+        for (int f = 0; f < fieldCount; ++f)
+            values.push_back((p && *p == ',') ? (float)strtod(p + 1, &p) : 0.0f);
+    }
+    return WriteGexbFile(gexbPath, GexbNamesFromHeader(header), fieldCount,
+        (int)ts.size() > GEXB_INITIAL_CAPACITY ? (int)ts.size() : GEXB_INITIAL_CAPACITY, ts, values);
+}
+
+// =========================
+//       DAY CATALOG
+// =========================
+// "<base>\<Ticker>.catalog" lists the day files that exist for a ticker, one
+// line per day and format: date,format,rows,min_ts,max_ts,bytes (Unix
+// seconds, rows -1 = unknown). Same file as GexBotDataCollector.cpp: this
+// study updates it after CSV writes. For the days between its first and last
+// entry it is trusted instead of probing each file; it is read again only
+// when it changes.
+
+#define CATALOG_HEADER "# GexBot day catalog v1: date,format,rows,min_ts,max_ts,bytes\r\n"
+
+struct CatalogEntry
+{
+    int Date;                   // YYYYMMDD of the "Tickers MM.DD.YYYY" folder
+    std::string Format;         // csv, gexb, grid, gexz, db
+    long long Rows;
+    double MinTs;
+    double MaxTs;
+    unsigned long long Bytes;
+};
+
+std::string GetCatalogPath(const std::string& baseFolder, const std::string& ticker)
+{
+    return baseFolder + "\\" + ticker + ".catalog";
+}
+
+bool ReadCatalog(const std::string& path, std::vector<CatalogEntry>& entries)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#') continue;
+        CatalogEntry e;
+        char format[16] = {0};
+        if (sscanf(line.c_str(), "%d,%15[^,],%lld,%lf,%lf,%llu", &e.Date, format, &e.Rows, &e.MinTs, &e.MaxTs, &e.Bytes) != 6)
+            continue;
+        e.Format = format;
+        entries.push_back(e);
+    }
+    return true;
+}
+
+// Reads the catalog again only when its size or write time changed (writers rewrite it whole)
+void RefreshDayCatalog(DayCatalog& catalog, const std::string& path)
+{
+    unsigned long long size = 0, writeTime = 0;
+    std::wstring wPath(path.begin(), path.end());
+    WIN32_FILE_ATTRIBUTE_DATA info;
+    if (GetFileAttributesExW(wPath.c_str(), GetFileExInfoStandard, &info))
+    {
+        size = ((unsigned long long)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+        writeTime = ((unsigned long long)info.ftLastWriteTime.dwHighDateTime << 32) | info.ftLastWriteTime.dwLowDateTime;
+    }
+    if (path == catalog.Path && size == catalog.Size && writeTime == catalog.WriteTime) return;
+
+    catalog.Path = path;
+    catalog.Size = size;
+    catalog.WriteTime = writeTime;
+    catalog.Days.clear();
+    std::vector<CatalogEntry> entries;
+    ReadCatalog(path, entries);
+    for (const CatalogEntry& e : entries)
+        catalog.Days[e.Date].insert(e.Format);
+}
+
+// Writers (Collector, API study, GexBotTerminal.cpp, archive tool) serialize the
+// read-modify-write on "<catalog>.lock"; each writes its own temp file.
+#define CATALOG_LOCK_TRIES   20
+#define CATALOG_LOCK_WAIT_MS 5
+
+// Exclusive handle on "<path>.lock", INVALID_HANDLE_VALUE if another writer
+// still holds it after the wait. Deleted on close, so a writer that dies
+// never leaves it behind.
+HANDLE LockCatalog(const std::string& path)
+{
+    std::string lockPath = path + ".lock";
+    std::wstring wLock(lockPath.begin(), lockPath.end());
+    for (int attempt = 0; attempt < CATALOG_LOCK_TRIES; ++attempt)
+    {
+        HANDLE h = CreateFileW(wLock.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_ALWAYS,
+            FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+        if (h != INVALID_HANDLE_VALUE) return h;
+        Sleep(CATALOG_LOCK_WAIT_MS);
+    }
+    return INVALID_HANDLE_VALUE;
+}
+
+// Inserts or replaces the (Date, Format) entries and swaps the catalog in.
+// keepMinTs: an existing entry keeps its earlier MinTs (appending writers only know the newest row).
+// A catalog left locked is skipped: readers probe the files it does not list yet.
+bool UpdateCatalog(const std::string& path, const std::vector<CatalogEntry>& updates, bool keepMinTs)
+{
+    HANDLE lock = LockCatalog(path);
+    if (lock == INVALID_HANDLE_VALUE) return false;
+
+    std::vector<CatalogEntry> entries;
+    ReadCatalog(path, entries);
+
+    for (const CatalogEntry& u : updates)
+    {
+        bool found = false;
+        for (CatalogEntry& e : entries)
+        {
+            if (e.Date != u.Date || e.Format != u.Format) continue;
+            double minTs = (keepMinTs && e.MinTs > 0 && e.MinTs < u.MinTs) ? e.MinTs : u.MinTs;
+            e = u;
+            e.MinTs = minTs;
+            found = true;
+        }
+        if (!found) entries.push_back(u);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const CatalogEntry& a, const CatalogEntry& b) {
+        return a.Date != b.Date ? a.Date < b.Date : a.Format < b.Format;
+    });
+
+    std::string out = CATALOG_HEADER;
+    char line[160];
+    for (const CatalogEntry& e : entries)
+    {
+        snprintf(line, sizeof(line), "%d,%s,%lld,%.1f,%.1f,%llu\r\n", e.Date, e.Format.c_str(), e.Rows, e.MinTs, e.MaxTs, e.Bytes);
+        out += line;
+    }
+
+    std::string tmpPath = path + "." + std::to_string(GetCurrentProcessId()) + "." + std::to_string(GetCurrentThreadId()) + ".tmp";
+    std::wstring wTmp(tmpPath.begin(), tmpPath.end());
+    std::wstring wPath(path.begin(), path.end());
+    HANDLE h = CreateFileW(wTmp.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(lock);
+        return false;
+    }
+
+    DWORD bytes = 0;
+    BOOL ok = WriteFile(h, out.data(), (DWORD)out.size(), &bytes, NULL) && bytes == out.size();
+    CloseHandle(h);
+
+    if (!ok || !MoveFileExW(wTmp.c_str(), wPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        DeleteFileW(wTmp.c_str());
+        ok = FALSE;
+    }
+    CloseHandle(lock);
+    return ok != FALSE;
+}
+
+#define CATALOG_UPDATE_SEC 60
+
+// Write a single data row to a CSV file (append mode)
+bool WriteToCsvFile(SCStudyInterfaceRef sc, GammaData* data, const std::string& csvPath)
+{
+    if (csvPath.empty()) return false;
+
+    EnsureDirectoryExists(csvPath);
+
+    // Check if file exists to decide whether to write header
+    bool needsHeader = !FileExists(csvPath);
+
+    // Open file for append
+    int fileHandle = 0;
+    SCString scPath(csvPath.c_str());
+    if (!sc.OpenFile(scPath, n_ACSIL::FILE_MODE_OPEN_TO_APPEND, fileHandle))
+    {
+        // File doesn't exist yet - create it
+        if (!sc.OpenFile(scPath, n_ACSIL::FILE_MODE_CREATE_AND_OPEN_FOR_READ_WRITE, fileHandle))
+        {
+            data->LastError = "Failed to open CSV file for writing";
+            return false;
+        }
+        needsHeader = true;
+    }
+
+    unsigned int bytesWritten = 0;
+
+    // Write header if new file
+    if (needsHeader)
+    {
+        int headerLen = (int)strlen(CSV_HEADER);
+        sc.WriteFile(fileHandle, CSV_HEADER, headerLen, &bytesWritten);
+    }
+
+    // Build data line
+    double scDateTime = sc.CurrentSystemDateTime.GetAsDouble();
+    double unixTimestamp = (scDateTime - 25569.0) * 86400.0;
+
+    double spot = 0.0;
+    if (sc.BaseData[SC_CLOSE].GetArraySize() > 0 && sc.Index >= 0)
+        spot = sc.BaseData[SC_CLOSE][sc.Index];
+
+    double netGex = data->Majors.mpos_vol - fabs(data->Majors.mneg_vol);
+    double zeroGamma = data->ProfileMeta.zero_gamma != 0 ? data->ProfileMeta.zero_gamma : data->Majors.zero_gamma;
+    double net = spot + netGex / 100.0;
+
+    char line[1024];
+    int lineLen = snprintf(line, sizeof(line),
+        "%.1f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f\r\n",
+        unixTimestamp,
+        spot,
+        zeroGamma,
+        data->Majors.mpos_vol,
+        data->Majors.mneg_vol,
+        data->Majors.mpos_oi,
+        data->Majors.mneg_oi,
+        data->ProfileMeta.sum_gex_vol,
+        data->ProfileMeta.sum_gex_oi,
+        data->ProfileMeta.delta_risk_reversal,
+        data->Greeks.major_long_gamma,
+        data->Greeks.major_short_gamma,
+        data->Greeks.major_positive,
+        data->Greeks.major_negative,
+        net);
+
+    sc.WriteFile(fileHandle, line, lineLen, &bytesWritten);
+    sc.CloseFile(fileHandle);
+
+    PublishCommit(csvPath, 1, needsHeader);
+
+    unsigned long long csvSize = 0;
+    bool haveSize = GetFileSize64(csvPath, csvSize) && csvSize >= (unsigned long long)lineLen;
+
+    // Self-write watermark: this row is already in the series. If the reader's
+    // cursor sat right before it, step the cursor over it; anything another
+    // writer appended in between leaves the cursor behind and is still read.
+    auto cursor = data->FileOffsets.find(csvPath);
+    if (haveSize && cursor != data->FileOffsets.end() && cursor->second == csvSize - lineLen)
+        cursor->second = csvSize;
+
+    // Time-seek index: first row of each minute
+    long long minute = (long long)floor(unixTimestamp / 60.0);
+    if ((needsHeader || minute != data->LastIndexMinute) && haveSize)
+    {
+        AppendCsvIndex(csvPath, (long long)floor(unixTimestamp * 1000.0 + 0.5), csvSize - lineLen, needsHeader);
+        data->LastIndexMinute = minute;
+    }
+
+    // Binary twin (.gexb), same row. Readers prefer the twin, so when the row
+    // cannot be appended (schema mismatch, file busy) it is rebuilt from the CSV,
+    // or removed until the next row if that fails too.
+    std::string gexbPath = GexbPathFor(csvPath);
+    bool rebuild = !needsHeader && !FileExists(gexbPath);
+    if (!rebuild)
+    {
+        const double fields[14] = { spot, zeroGamma, data->Majors.mpos_vol, data->Majors.mneg_vol, data->Majors.mpos_oi,
+            data->Majors.mneg_oi, data->ProfileMeta.sum_gex_vol, data->ProfileMeta.sum_gex_oi, data->ProfileMeta.delta_risk_reversal,
+            data->Greeks.major_long_gamma, data->Greeks.major_short_gamma, data->Greeks.major_positive, data->Greeks.major_negative, net };
+        std::vector<float> row(fields, fields + 14);
+        int rowCount = 0;
+        auto gexbCursor = data->FileOffsets.find(gexbPath);
+        bool caughtUp = gexbCursor != data->FileOffsets.end();
+        if (!AppendGexbRow(gexbPath, GexbNamesFromHeader(CSV_HEADER), (long long)floor(unixTimestamp * 1000.0 + 0.5), row, &rowCount))
+        {
+            rebuild = true;
+        }
+        else if (caughtUp && gexbCursor->second == (unsigned long long)rowCount - 1)
+        {
+            // Same watermark in rows; a capacity doubling swaps in a new file, so take its identity too
+            gexbCursor->second = (unsigned long long)rowCount;
+            unsigned long long fileId = 0;
+            if (GetFileId(gexbPath, fileId))
+                data->FileIds[gexbPath] = fileId;
+        }
+    }
+    if (rebuild && !RebuildGexbFromCsv(csvPath, gexbPath, CSV_HEADER))
+    {
+        std::wstring wGexb(gexbPath.begin(), gexbPath.end());
+        DeleteFileW(wGexb.c_str());
+    }
+
+    return true;
+}
+
+// Store one row in CSV column order (values[0] = Unix seconds) into the series.
+// span: the file's LoadedSpan, widened by the row if it is stored.
+bool StoreGammaRow(GammaData* data, const double* values, int fieldCount, int tzOffsetHours, LoadedSpan& span)
+{
+    double ts = values[0];
+    if (!(ts > 0)) return false;   // also a missing (NaN) timestamp column
+
+    // Convert Unix timestamp to SCDateTime with timezone offset
+    SCDateTime dt((ts + tzOffsetHours * 3600.0) / 86400.0 + 25569.0);
+
+    double spot  = values[1];
+    double zero  = values[2];
+    double posv  = values[3];
+    double negv  = values[4];
+    double posoi = (fieldCount > 5) ? values[5] : 0;
+    double negoi = (fieldCount > 6) ? values[6] : 0;
+    // 7:sum_gex_vol, 8:sum_gex_oi, 9:delta_risk_reversal (not stored)
+    double lng   = (fieldCount > 10) ? values[10] : 0;
+    double sht   = (fieldCount > 11) ? values[11] : 0;
+    double mjp   = (fieldCount > 12) ? values[12] : 0;
+    double mjn   = (fieldCount > 13) ? values[13] : 0;
+
+    // Zero = not published, same as missing (a duplicate time overwrites what the row carries)
+    double row[GS_COUNT] = { zero, posv, negv, posoi, negoi, NAN, lng, sht, mjp, mjn, spot };
+    float cells[GS_COUNT];
+    for (int s = 0; s < GS_COUNT; ++s)
+        cells[s] = (!std::isnan(row[s]) && row[s] != 0) ? static_cast<float>(row[s]) : NAN;
+
+    // Calculate net (spot + netGex / 100.0)
+    if (!std::isnan(spot) && !std::isnan(posv) && !std::isnan(negv))
+    {
+        double netGex = posv - fabs(negv);
+        cells[GS_NET] = static_cast<float>(spot + netGex / 100.0);
+    }
+
+    data->Series.Add(dt.GetAsDouble(), cells);
+    span.Widen(dt.GetAsDouble());
+    return true;
+}
+
+// Delimiters are found 16 bytes at a time with SSE2 (every x64 CPU has it)
+// and each field is converted in place with std::from_chars: no substrings,
+// no allocations, no exceptions. Other targets use the scalar loop.
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define CSV_TOKENIZER_SSE2 1
+#endif
+
+#ifdef CSV_TOKENIZER_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Bit i set = byte i of the 16 at p is ',' or '\n'
+inline unsigned int CsvDelimiterMask(const char* p)
+{
+    __m128i block = _mm_loadu_si128((const __m128i*)p);
+    __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(',')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\n')));
+    return (unsigned int)_mm_movemask_epi8(hits);
+}
+
+inline int LowestSetBit(unsigned int mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+// Blanks around the number are ignored; empty or non-numeric fields read as 0
+inline double ParseCsvNumber(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    while (end > p && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) --end;
+    if (p < end && *p == '+') ++p;
+    double v = 0.0;
+    if (std::from_chars(p, end, v).ec != std::errc()) return 0.0;
+    return v;
+}
+
+// Splits [begin, end) into lines and calls onRow(values, columnCount,
+// lineBegin, lineEnd) for every non-blank line (lineEnd excludes the '\n').
+// File column c is converted into values[slots[c]]; columns without a slot
+// (-1, or past the end of slots) are only scanned over. values[0, valueCount)
+// is NaN for every slot the line did not fill.
+template <typename RowFn>
+void TokenizeCsv(const char* begin, const char* end, const std::vector<int>& slots, double* values, int valueCount, RowFn onRow)
+{
+    const char* lineStart = begin;
+    const char* fieldStart = begin;
+    const int* slot = slots.data();
+    const int slotCount = (int)slots.size();
+    int column = 0;
+    std::fill(values, values + valueCount, std::numeric_limits<double>::quiet_NaN());
+
+    auto endLine = [&](const char* lineEnd) {
+        bool blank = (lineEnd == lineStart) || (lineEnd - lineStart == 1 && *lineStart == '\r');
+        if (!blank) onRow(values, column, lineStart, lineEnd);
+        column = 0;
+        lineStart = lineEnd + 1;
+        std::fill(values, values + valueCount, std::numeric_limits<double>::quiet_NaN());
+    };
+    auto delimiter = [&](const char* d) {
+        if (column < slotCount && slot[column] >= 0) values[slot[column]] = ParseCsvNumber(fieldStart, d);
+        ++column;
+        fieldStart = d + 1;
+        if (*d == '\n') endLine(d);
+    };
+
+    const char* p = begin;
+#ifdef CSV_TOKENIZER_SSE2
+    for (; end - p >= 16; p += 16)
+    {
+        for (unsigned int mask = CsvDelimiterMask(p); mask; mask &= mask - 1)
+            delimiter(p + LowestSetBit(mask));
+    }
+#endif
+    for (; p < end; ++p)
+        if (*p == ',' || *p == '\n') delimiter(p);
+
+    // Last line without a newline
+    if (lineStart < end)
+    {
+        if (column < slotCount && slot[column] >= 0) values[slot[column]] = ParseCsvNumber(fieldStart, end);
+        ++column;
+        endLine(end);
+    }
+}
+
+// Columns always read for the series: timestamp, spot, zero_gamma, the vol walls
+// (net is derived from them) and the four greek majors. The OI walls (bits 5, 6)
+// only when their subgraph is shown.
+#define GAMMA_BASE_FIELDS ((1u << 0) | (1u << 1) | (1u << 2) | (1u << 3) | (1u << 4) | \
+                           (1u << 10) | (1u << 11) | (1u << 12) | (1u << 13))
+
+// Resolves a CSV header into the values[] slot (CSV_HEADER order) of each file
+// column, by name: reordered or added columns are harmless. Columns outside
+// fieldMask (bit = CSV_HEADER column) and unknown names get -1 and are never
+// converted. An empty header means the positional CSV_HEADER layout.
+void BuildGammaColumnSlots(const std::string& header, unsigned int fieldMask, std::vector<int>& slots)
+{
+    auto splitNames = [](const std::string& line) {
+        std::vector<std::string> names;
+        size_t pos = 0;
+        while (pos <= line.size())
+        {
+            size_t comma = line.find(',', pos);
+            if (comma == std::string::npos) comma = line.size();
+            size_t first = line.find_first_not_of(" \t", pos);
+            size_t last = line.find_last_not_of(" \t\r\n", comma - 1);
+            names.push_back((first < comma && last != std::string::npos && last >= first) ? line.substr(first, last - first + 1) : "");
+            pos = comma + 1;
+        }
+        return names;
+    };
+    static const std::vector<std::string> known = splitNames(CSV_HEADER);
+
+    slots.clear();
+    std::vector<std::string> names = header.empty() ? known : splitNames(header);
+    for (const std::string& name : names)
+    {
+        int c = (int)(std::find(known.begin(), known.end(), name) - known.begin());
+        slots.push_back(c < (int)known.size() && ((fieldMask >> c) & 1) ? c : -1);
+    }
+}
+
+// =========================
+//     PARALLEL LOADING
+// =========================
+// Work is split into chunks that each fill a private GammaData; the chunks'
+// sorted rows are then appended to the shared one on the study thread.
+
+#define CSV_CHUNK_MIN_BYTES (4ull << 20) // Smallest piece of one CSV worth its own thread
+
+// Set while a thread runs pool jobs; a pooled day does not split its file again
+thread_local bool InWorkerPool = false;
+
+// Runs job(i) for every i in [0, count) on up to one thread per core; the study thread takes jobs too
+template <class Job>
+void RunPool(size_t count, Job job)
+{
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        bool nested = InWorkerPool;
+        InWorkerPool = true;
+        for (size_t j = next++; j < count; j = next++)
+            job(j);
+        InWorkerPool = nested;
+    };
+    size_t threads = std::min<size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < threads; ++i) pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool) t.join();
+}
+
+// Moves a chunk parsed into a private GammaData into data. Chunks (days, or pieces
+// of one file) are merged in time order, so the rows are normally appended as a block.
+void MergeGammaChunk(GammaData* data, GammaData& chunk)
+{
+    data->Series.MergeFrom(chunk.Series);
+    for (const auto& kv : chunk.FileOffsets) data->FileOffsets[kv.first] = kv.second;
+    for (const auto& kv : chunk.FileIds) data->FileIds[kv.first] = kv.second;
+    for (auto& kv : chunk.ColumnSlots) data->ColumnSlots[kv.first].swap(kv.second);
+    for (const auto& kv : chunk.LoadedSpans) data->LoadedSpans[kv.first].Widen(kv.second);
+}
+
+// Newline-aligned piece boundaries for [begin, end) (complete lines): one piece per
+// core at most, none smaller than CSV_CHUNK_MIN_BYTES. Two entries = one piece.
+std::vector<const char*> SplitCsvSpan(const char* begin, const char* end)
+{
+    std::vector<const char*> cuts(1, begin);
+    size_t bytes = (size_t)(end - begin);
+    size_t pieces = InWorkerPool ? 1 : std::min<size_t>(bytes / CSV_CHUNK_MIN_BYTES, std::thread::hardware_concurrency());
+    for (size_t k = 1; k < pieces; ++k)
+    {
+        const char* p = std::max(begin + bytes / pieces * k, cuts.back());
+        const char* newline = (const char*)memchr(p, '\n', (size_t)(end - p));
+        if (!newline || newline + 1 >= end) break;
+        cuts.push_back(newline + 1);
+    }
+    cuts.push_back(end);
+    return cuts;
+}
+
+// =========================
+//       LOAD BUDGET
+// =========================
+// A history load can be spread over several study calls so the chart stays
+// responsive. On the study thread, CSV rows are parsed in LOAD_SLICE_BYTES
+// slices and a read stops at the first slice boundary past the call's
+// deadline; the file's offset is the cursor the next call resumes from.
+
+#define LOAD_SLICE_BYTES   (256u << 10)
+#define LOAD_PROGRESS_LINE 7480000      // + StudyGraphInstanceID: chart text while loading
+
+typedef std::chrono::steady_clock::time_point LoadDeadline;
+
+// nullptr = no budget (pool threads, budget input 0)
+inline bool PastDeadline(const LoadDeadline* deadline)
+{
+    return deadline && std::chrono::steady_clock::now() >= *deadline;
+}
+
+// End of the slice starting at from, just past a newline ([from, end) holds complete lines)
+inline const char* NextCsvSlice(const char* from, const char* end)
+{
+    if ((size_t)(end - from) <= LOAD_SLICE_BYTES) return end;
+    const char* newline = (const char*)memchr(from + LOAD_SLICE_BYTES, '\n', (size_t)(end - from) - LOAD_SLICE_BYTES);
+    return newline ? newline + 1 : end;
+}
+
+// Load historical data from a single CSV file. Returns the rows stored, -1 if the file cannot be mapped.
+// fromMs: rows before it are skipped when the time-seek index allows (LLONG_MIN = whole file)
+// fieldMask: columns to convert (see BuildGammaColumnSlots)
+// deadline: stop at the first slice past it and set LoadPending (see LOAD BUDGET)
+// The day loaders touch only their GammaData (no sc calls): pooled days run them on worker threads.
+int LoadSingleCSV(const std::string& fullPath, int tzOffsetHours, long long fromMs, unsigned int fieldMask, GammaData* data,
+    const LoadDeadline* deadline = nullptr)
+{
+    int rowCount = 0;
+
+    unsigned long long fileSize = 0;
+    if (!GetFileSize64(fullPath, fileSize) || fileSize == 0) return 0;
+
+    // Resume exactly where the previous read stopped
+    unsigned long long offset = 0;
+    auto found = data->FileOffsets.find(fullPath);
+    if (found != data->FileOffsets.end())
+        offset = found->second;
+
+    // Replaced file (different identity) -> Start from 0
+    unsigned long long fileId = 0;
+    if (GetFileId(fullPath, fileId))
+    {
+        auto knownId = data->FileIds.find(fullPath);
+        if (knownId != data->FileIds.end() && knownId->second != fileId)
+            offset = 0;
+        data->FileIds[fullPath] = fileId;
+    }
+
+    // Nothing appended since the last read -> No mapping at all
+    unsigned long long committed = GetCommittedLength(fullPath, fileSize);
+    if (committed == offset) return 0;
+
+    // Rows are parsed straight from the mapped pages: no copy, no size limit
+    MappedFile mf;
+    if (!mf.Open(fullPath))
+        return -1;
+
+    // Never read past what the writer has committed (the file may have grown since it was mapped)
+    committed = GetCommittedLength(fullPath, mf.Size);
+
+    // Committed length below our cursor means the file was truncated/recreated -> Start from 0
+    if (committed < offset)
+        offset = 0;
+
+    // The header line (starts with a non-digit, not a minus sign) is needed complete
+    const char* headerEnd = (const char*)memchr(mf.Data, '\n', (size_t)committed);
+    if (!headerEnd) return 0;
+    bool hasHeader = !isdigit((unsigned char)*mf.Data) && *mf.Data != '-';
+
+    // First read starts at the window through the .idx sidecar, columns are resolved again
+    unsigned long long start = offset;
+    if (offset == 0)
+    {
+        start = FindCsvSeekOffset(fullPath, fromMs, committed);
+        data->ColumnSlots.erase(fullPath);
+    }
+    if (hasHeader && start <= (unsigned long long)(headerEnd - mf.Data))
+        start = (unsigned long long)(headerEnd - mf.Data) + 1;
+
+    // Column plan: once per file (tail reads rebuild it from the same header after a restart)
+    auto plan = data->ColumnSlots.find(fullPath);
+    if (plan == data->ColumnSlots.end())
+    {
+        std::string header = hasHeader ? std::string(mf.Data, headerEnd) : std::string();
+        plan = data->ColumnSlots.emplace(fullPath, std::vector<int>()).first;
+        BuildGammaColumnSlots(header, fieldMask, plan->second);
+    }
+    const std::vector<int>& slots = plan->second;
+
+    // Drop a torn trailing row (no newline yet); it is picked up on the next refresh
+    const char* begin = mf.Data + start;
+    const char* end = mf.Data + committed;
+    while (end > begin && end[-1] != '\n') --end;
+    if (end <= begin) return 0;
+
+    // Fields: 0:timestamp, 1:spot, 2:zero_gamma, 3:major_pos_vol, 4:major_neg_vol,
+    // 5:major_pos_oi, 6:major_neg_oi, 7:sum_gex_vol, 8:sum_gex_oi,
+    // 9:delta_risk_reversal, 10:major_long_gamma, 11:major_short_gamma,
+    // 12:major_positive, 13:major_negative, 14:net
+    auto parse = [&](const char* from, const char* to, GammaData* target) {
+        int rows = 0;
+        double values[15];
+        LoadedSpan& span = target->LoadedSpans[fullPath];
+        TokenizeCsv(from, to, slots, values, 15,
+            [&](const double* row, int columnCount, const char*, const char*) {
+                if (columnCount < 5) return; // Need at least timestamp + a few fields
+                if (StoreGammaRow(target, row, 15, tzOffsetHours, span))
+                    ++rows;
+            });
+        return rows;
+    };
+
+    // On a budget: slice by slice on this thread, the cursor following each slice
+    if (deadline)
+    {
+        for (const char* from = begin; from < end; )
+        {
+            const char* to = NextCsvSlice(from, end);
+            rowCount += parse(from, to, data);
+            data->FileOffsets[fullPath] = (unsigned long long)(to - mf.Data);
+            from = to;
+            if (from < end && PastDeadline(deadline))
+            {
+                data->LoadPending = true;
+                data->LoadingPath = fullPath;
+                data->LoadingPercent = (int)((unsigned long long)(from - mf.Data) * 100 / (unsigned long long)(end - mf.Data));
+                break;
+            }
+        }
+        return rowCount;
+    }
+    data->FileOffsets[fullPath] = (unsigned long long)(end - mf.Data);
+
+    // A large span (a whole long day on first read) is parsed in pieces on the pool
+    std::vector<const char*> cuts = SplitCsvSpan(begin, end);
+    if (cuts.size() <= 2)
+    {
+        rowCount = parse(begin, end, data);
+    }
+    else
+    {
+        std::vector<GammaData> chunks(cuts.size() - 1);
+        std::vector<int> chunkRows(chunks.size());
+        RunPool(chunks.size(), [&](size_t j) { chunkRows[j] = parse(cuts[j], cuts[j + 1], &chunks[j]); });
+        for (size_t j = 0; j < chunks.size(); ++j)
+        {
+            MergeGammaChunk(data, chunks[j]);
+            rowCount += chunkRows[j];
+        }
+    }
+
+    return rowCount;
+}
+
+// Maps a .gexb day file and stores every row straight from its columns (no parsing)
+int LoadSingleGexb(const std::string& fullPath, int tzOffsetHours, GammaData* data)
+{
+    MappedFile mf;
+    if (!mf.Open(fullPath)) return 0;
+
+    GexbHeader hdr;
+    if (mf.Size < sizeof(hdr)) return 0;
+    memcpy(&hdr, mf.Data, sizeof(hdr));
+    if (hdr.Magic != GEXB_MAGIC || hdr.Version != GEXB_VERSION || hdr.FieldCount <= 0 || hdr.FieldCount > 63 ||
+        hdr.RowCount > hdr.Capacity || mf.Size < GexbFieldOffset(hdr, hdr.FieldCount, 0))
+        return 0;
+
+    // Rewritten file (grown or backfilled) -> Start from row 0
+    unsigned long long start = data->FileOffsets[fullPath];
+    unsigned long long fileId = 0;
+    if (GetFileId(fullPath, fileId))
+    {
+        auto knownId = data->FileIds.find(fullPath);
+        if (knownId != data->FileIds.end() && knownId->second != fileId)
+            start = 0;
+        data->FileIds[fullPath] = fileId;
+    }
+    if (start > (unsigned long long)hdr.RowCount)
+        start = 0;
+    data->FileOffsets[fullPath] = hdr.RowCount;
+
+    const long long* tsColumn = (const long long*)(mf.Data + GexbTsOffset(hdr, 0));
+    const float* fieldColumns = (const float*)(mf.Data + GexbFieldOffset(hdr, 0, 0));
+    double values[64];
+    int rowCount = 0;
+    LoadedSpan& span = data->LoadedSpans[fullPath];
+    for (int r = (int)start; r < hdr.RowCount; ++r)
+    {
+        values[0] = tsColumn[r] / 1000.0;
+        for (int f = 0; f < hdr.FieldCount; ++f)
+            values[f + 1] = fieldColumns[(size_t)f * hdr.Capacity + r];
+        if (StoreGammaRow(data, values, hdr.FieldCount + 1, tzOffsetHours, span))
+            ++rowCount;
+    }
+
+    return rowCount;
+}
+
+// =========================
+//   ARCHIVED DAYS (.gexz)
+// =========================
+// Closed days compacted by GexBotArchiveTool.cpp (frame-indexed, column-encoded).
+
+#define GEXZ_MAGIC   0x5A585847u  // "GXXZ"
+#define GEXZ_VERSION 1u
+
+struct GexzHeader
+{
+    unsigned int Magic;
+    unsigned int Version;
+    unsigned int FieldCount;
+    unsigned int FrameCount;
+    unsigned long long RowCount;
+    unsigned int NamesBytes;
+    unsigned int Reserved;
+};
+
+struct GexzFrameEntry
+{
+    long long FirstTsMs;
+    long long LastTsMs;
+    unsigned long long Offset;
+    unsigned int Bytes;
+    unsigned int Rows;
+};
+
+bool GetVarint(const unsigned char*& p, const unsigned char* end, unsigned long long& v)
+{
+    v = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7)
+    {
+        unsigned char b = *p++;
+        v |= (unsigned long long)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+// Same codec as GexBotArchiveTool.cpp: delta-run timestamps, XOR/repeat float columns.
+// Output is row-major, fieldCount values per row.
+bool DecodeGexzFrame(const unsigned char* p, const unsigned char* end, int fieldCount, size_t rows,
+    std::vector<long long>& tsMs, std::vector<float>& values)
+{
+    if (rows == 0 || end - p < (long)sizeof(long long)) return false;
+    tsMs.assign(rows, 0);
+    values.assign(rows * fieldCount, 0.0f);
+
+    memcpy(&tsMs[0], p, sizeof(long long));
+    p += sizeof(long long);
+    size_t i = 1;
+    while (i < rows)
+    {
+        unsigned long long zz, run;
+        if (!GetVarint(p, end, zz) || !GetVarint(p, end, run) || run == 0 || i + run > rows) return false;
+        long long delta = (long long)(zz >> 1) ^ -(long long)(zz & 1);
+        for (unsigned long long k = 0; k < run; ++k, ++i)
+            tsMs[i] = tsMs[i - 1] + delta;
+    }
+
+    for (int f = 0; f < fieldCount; ++f)
+    {
+        unsigned int prev = 0;
+        size_t r = 0;
+        while (r < rows)
+        {
+            unsigned long long token;
+            if (!GetVarint(p, end, token)) return false;
+            int nbytes = (int)(token & 3) + 1;
+            unsigned long long repeat = token >> 2;
+            if (end - p < nbytes || r + 1 + repeat > rows) return false;
+
+            unsigned int x = 0;
+            for (int b = 0; b < nbytes; ++b) x |= (unsigned int)p[b] << (8 * b);
+            p += nbytes;
+
+            unsigned int bits = prev ^ x;
+            float v;
+            memcpy(&v, &bits, sizeof(v));
+            for (unsigned long long k = 0; k <= repeat; ++k, ++r)
+                values[r * fieldCount + f] = v;
+            prev = bits;
+        }
+    }
+    return true;
+}
+
+int LoadSingleArchive(const std::string& fullPath, int tzOffsetHours, GammaData* data)
+{
+    std::ifstream in(fullPath, std::ios::binary);
+    if (!in.is_open()) return 0;
+
+    GexzHeader hdr;
+    in.read((char*)&hdr, sizeof(hdr));
+    if (!in || hdr.Magic != GEXZ_MAGIC || hdr.Version != GEXZ_VERSION || hdr.FieldCount == 0 || hdr.FieldCount > 63)
+        return 0;
+
+    in.seekg((std::streamoff)(sizeof(hdr) + hdr.NamesBytes));
+    std::vector<GexzFrameEntry> index(hdr.FrameCount);
+    if (hdr.FrameCount) in.read((char*)index.data(), index.size() * sizeof(GexzFrameEntry));
+    if (!in) return 0;
+
+    std::string buf;
+    std::vector<long long> tsMs;
+    std::vector<float> frameValues;
+    double values[64];
+    int rowCount = 0;
+    LoadedSpan& span = data->LoadedSpans[fullPath];
+    for (const GexzFrameEntry& e : index)
+    {
+        buf.resize(e.Bytes);
+        in.seekg((std::streamoff)e.Offset);
+        in.read(&buf[0], e.Bytes);
+        const unsigned char* p = (const unsigned char*)buf.data();
+        if (!in || !DecodeGexzFrame(p, p + buf.size(), (int)hdr.FieldCount, e.Rows, tsMs, frameValues))
+            break;
+
+        for (size_t r = 0; r < e.Rows; ++r)
+        {
+            values[0] = tsMs[r] / 1000.0;
+            for (unsigned int f = 0; f < hdr.FieldCount; ++f)
+                values[f + 1] = frameValues[r * hdr.FieldCount + f];
+            if (StoreGammaRow(data, values, (int)hdr.FieldCount + 1, tzOffsetHours, span))
+                ++rowCount;
+        }
+    }
+
+    return rowCount;
+}
+
+// =========================
+//     WARM-START CACHE
+// =========================
+// "<base>\<Ticker>.apicache" holds the historical series and the closed day files
+// they were read from (CachedFilePaths, with identity, size and the span of
+// rows each one gave). Written when the study goes away and every
+// GAMMA_CACHE_SAVE_SEC; on the next start the closed days come from it and
+// only today's file is read. Other inputs discard the whole snapshot; a day
+// file that was replaced (backfill, compacted to .gexz), shrank or is gone
+// only loses its own rows, and that day is read again from what is on disk.
+
+#define GAMMA_CACHE_MAGIC    0x43415847u  // "GXAC"
+#define GAMMA_CACHE_VERSION  5u
+#define GAMMA_CACHE_SAVE_SEC 300
+
+struct GammaCacheHeader
+{
+    unsigned int Magic;
+    unsigned int Version;
+    int DaysCount;
+    int TzOffset;
+    long long CsvLoadedFromMs;
+    unsigned int KeyBytes;      // "<base>|<ticker>" follows the header
+    unsigned int FileCount;
+    unsigned int SeriesCount;
+    unsigned int FieldMask;     // CSV columns the series were parsed with
+};
+
+// One per cached day file, followed by the path
+struct GammaCacheFile
+{
+    unsigned long long FileId;  // 0 = the file was gone at save time
+    unsigned long long Size;
+    double LoadedFrom;          // LoadedSpans entry (From > To = no rows)
+    double LoadedTo;
+    unsigned int PathBytes;
+    unsigned int Reserved;
+};
+
+std::string GetGammaCachePath(const std::string& baseFolder, const std::string& ticker)
+{
+    return baseFolder + "\\" + ticker + ".apicache";
+}
+
+// Series section: row count, then the times (SCDateTime doubles), the Observed
+// masks, one column of floats per series, filled cells included, and the Back
+// column of each series
+bool SaveGammaCache(const std::string& path, GammaData* data)
+{
+    std::string key = data->LastBasePath + "|" + data->LastTickerForFile;
+
+    std::string out;
+    auto put = [&out](const void* p, size_t n) { out.append((const char*)p, n); };
+
+    GammaCacheHeader hdr = { GAMMA_CACHE_MAGIC, GAMMA_CACHE_VERSION, data->LastDaysCount, data->LastTZOffset, data->CsvLoadedFromMs,
+        (unsigned int)key.size(), (unsigned int)data->CachedFilePaths.size(), GS_COUNT, data->LastFieldMask };
+    put(&hdr, sizeof(hdr));
+    put(key.data(), key.size());
+
+    for (const std::string& f : data->CachedFilePaths)
+    {
+        // A file removed since it was read is saved as gone: the next start drops its rows
+        GammaCacheFile rec = {};
+        if (!GetFileId(f, rec.FileId) || !GetFileSize64(f, rec.Size))
+            rec.FileId = rec.Size = 0;
+        auto span = data->LoadedSpans.find(f);
+        rec.LoadedFrom = span != data->LoadedSpans.end() ? span->second.From : DBL_MAX;
+        rec.LoadedTo = span != data->LoadedSpans.end() ? span->second.To : -DBL_MAX;
+        rec.PathBytes = (unsigned int)f.size();
+        put(&rec, sizeof(rec));
+        put(f.data(), f.size());
+    }
+
+    const SeriesStore& series = data->Series;
+    unsigned long long rows = series.Times.size();
+    put(&rows, sizeof(rows));
+    put(series.Times.data(), rows * sizeof(double));
+    put(series.Observed.data(), rows * sizeof(unsigned short));
+    for (int s = 0; s < GS_COUNT; ++s)
+        put(series.Columns[s].data(), rows * sizeof(float));
+    for (int s = 0; s < GS_COUNT; ++s)
+        put(series.Back[s].data(), rows * sizeof(unsigned short));
+
+    std::string tmpPath = path + ".tmp";
+    std::wstring wTmp(tmpPath.begin(), tmpPath.end());
+    std::wstring wPath(path.begin(), path.end());
+    HANDLE h = CreateFileW(wTmp.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) return false;
+
+    DWORD bytes = 0;
+    BOOL ok = WriteFile(h, out.data(), (DWORD)out.size(), &bytes, NULL) && bytes == out.size();
+    CloseHandle(h);
+
+    if (!ok || !MoveFileExW(wTmp.c_str(), wPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        DeleteFileW(wTmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Restores a snapshot taken with the same inputs into an empty GammaData
+bool LoadGammaCache(const std::string& path, const std::string& baseFolder, const std::string& ticker, int days, int tzOffset,
+    unsigned int fieldMask, GammaData* data)
+{
+    MappedFile mf;
+    if (!mf.Open(path)) return false;
+    const char* p = mf.Data;
+    const char* end = mf.Data + mf.Size;
+    auto take = [&](void* dst, size_t n) {
+        if ((size_t)(end - p) < n) return false;
+        memcpy(dst, p, n);
+        p += n;
+        return true;
+    };
+
+    GammaCacheHeader hdr;
+    if (!take(&hdr, sizeof(hdr)) || hdr.Magic != GAMMA_CACHE_MAGIC || hdr.Version != GAMMA_CACHE_VERSION ||
+        hdr.DaysCount != days || hdr.TzOffset != tzOffset || hdr.SeriesCount != GS_COUNT || hdr.FieldMask != fieldMask)
+        return false;
+    std::string key = baseFolder + "|" + ticker;
+    if (hdr.KeyBytes != key.size() || (size_t)(end - p) < key.size() || key.compare(0, key.size(), p, key.size()) != 0)
+        return false;
+    p += key.size();
+
+    std::set<std::string> files;
+    std::map<std::string, LoadedSpan> spans;
+    std::vector<LoadedSpan> dropped;
+    for (unsigned int i = 0; i < hdr.FileCount; ++i)
+    {
+        GammaCacheFile rec;
+        if (!take(&rec, sizeof(rec)) || (size_t)(end - p) < rec.PathBytes) return false;
+        std::string f(p, rec.PathBytes);
+        p += rec.PathBytes;
+
+        LoadedSpan span;
+        span.From = rec.LoadedFrom;
+        span.To = rec.LoadedTo;
+
+        // Same file, not rewritten since (compaction or backfill swaps in a new one). Otherwise
+        // its rows go and the day is read again, in whatever format it is in now.
+        unsigned long long fileId = 0, size = 0;
+        if (rec.FileId == 0 || !GetFileId(f, fileId) || fileId != rec.FileId || !GetFileSize64(f, size) || size < rec.Size)
+        {
+            dropped.push_back(span);
+            continue;
+        }
+        files.insert(f);
+        spans[f] = span;
+    }
+
+    // Saved sorted and filled: the columns are copied back as they are
+    SeriesStore loaded;
+    unsigned long long rows = 0;
+    if (!take(&rows, sizeof(rows)) ||
+        (unsigned long long)(end - p) / (sizeof(double) + sizeof(unsigned short) + GS_COUNT * (sizeof(float) + sizeof(unsigned short))) < rows)
+        return false;
+    loaded.Truncate((size_t)rows);
+    take(loaded.Times.data(), rows * sizeof(double));
+    take(loaded.Observed.data(), rows * sizeof(unsigned short));
+    for (int s = 0; s < GS_COUNT; ++s)
+        take(loaded.Columns[s].data(), rows * sizeof(float));
+    for (int s = 0; s < GS_COUNT; ++s)
+        take(loaded.Back[s].data(), rows * sizeof(unsigned short));
+    loaded.Refill((size_t)rows); // Only finds each series' last value for the next append
+    for (const LoadedSpan& span : dropped)
+        if (span.From <= span.To)
+            loaded.Erase(span.From, std::nextafter(span.To, DBL_MAX));
+
+    data->Series = std::move(loaded);
+    data->CachedFilePaths.swap(files);
+    data->LoadedSpans.swap(spans);
+    data->CsvLoadedFromMs = hdr.CsvLoadedFromMs;
+    data->LastBasePath = baseFolder;
+    data->LastTickerForFile = ticker;
+    data->LastDaysCount = days;
+    data->LastTZOffset = tzOffset;
+    data->LastFieldMask = fieldMask;
+    return true;
+}
+
+// =========================
+//     DATE/TIME HELPERS
+// =========================
+
+// Helper to format date as MM.dd.yyyy
+std::string FormatDateSuffix(const SCDateTime& dt)
+{
+    int year = dt.GetYear();
+    int month = dt.GetMonth();
+    int day = dt.GetDay();
+    
+    char buffer[20];
+    snprintf(buffer, sizeof(buffer), "%02d.%02d.%04d", month, day, year);
+    return buffer;
+}
+
+SCDateTime SubtractDays(SCDateTime base, int days)
+{
+    double adjusted = base.GetAsDouble() - days;
+    return SCDateTime(adjusted);
+}
+
+// Forward fill: the most recent value <= targetTime with 5 minute tolerance.
+// row = series.Seek(targetTime, ...), looked up once per bar for every series.
+float GetValueAtTime(const SeriesStore& series, size_t row, int s, SCDateTime targetTime)
+{
+    if (row == SeriesStore::NONE) return -FLT_MAX;
+
+    float v = series.Columns[s][row];
+    if (std::isnan(v)) return -FLT_MAX;
+
+    double delta = fabs((targetTime.GetAsDouble() - series.SourceTime(row, s)) * 86400.0);
+    if (delta <= GAMMA_FILL_SEC)
+        return v;
+    
+    return -FLT_MAX;
+}
+
+// =========================
+//  HISTORICAL DATA LOADING
+// =========================
+
+// Logs one day load on the study thread; returns the rows to count (-1 = cannot open)
+int ReportDayLoad(SCStudyInterfaceRef sc, const std::string& path, int rows)
+{
+    SCString msg;
+    if (rows < 0)
+        msg.Format("GEX_TERMINAL: Cannot open %s", path.c_str());
+    else if (rows > 0)
+        msg.Format("GEX_TERMINAL: Loaded %d rows from %s", rows, path.c_str());
+    else
+        return 0;
+    sc.AddMessageToLog(msg, 0);
+    return rows < 0 ? 0 : rows;
+}
+
+// Reads one day file of any format into data (see LoadSingleCSV for fromMs, fieldMask and deadline;
+// binary formats are read whole)
+int LoadGammaDay(const std::string& path, int tzOffset, long long fromMs, unsigned int fieldMask, GammaData* data,
+    const LoadDeadline* deadline = nullptr)
+{
+    if (path.size() > 5 && path.compare(path.size() - 5, 5, ".gexb") == 0) return LoadSingleGexb(path, tzOffset, data);
+    if (path.size() > 5 && path.compare(path.size() - 5, 5, ".gexz") == 0) return LoadSingleArchive(path, tzOffset, data);
+    return LoadSingleCSV(path, tzOffset, fromMs, fieldMask, data, deadline);
+}
+
+
+// deadline: this call's load budget (see LOAD BUDGET). It covers the reads on this thread (today,
+// resumed files); closed days never read are parsed whole on the pool, which is not budgeted.
+// What moved is recorded in Series.ChangedFrom.
+void LoadRecentGammaFiles(SCStudyInterfaceRef sc, GammaData* data, const std::string& baseFolder, const std::string& ticker, int days, int tzOffset, int refreshSeconds,
+    unsigned int fieldMask, const LoadDeadline* deadline)
+{
+    data->LoadPending = false;
+    data->LoadingPath.clear();
+
+    // Clear if parameters changed (an OI wall shown that was not parsed included)
+    if (baseFolder != data->LastBasePath || ticker != data->LastTickerForFile || days != data->LastDaysCount || tzOffset != data->LastTZOffset ||
+        fieldMask != data->LastFieldMask)
+    {
+        data->CachedFilePaths.clear();
+        data->FileOffsets.clear();
+        data->FileIds.clear();
+        data->ColumnSlots.clear();
+        data->LoadedSpans.clear();
+        data->Series.Clear();
+
+        data->CsvLoadedFromMs = LLONG_MAX;
+
+        data->LastBasePath = baseFolder;
+        data->LastTickerForFile = ticker;
+        data->LastDaysCount = days;
+        data->LastTZOffset = tzOffset;
+        data->LastFieldMask = fieldMask;
+    }
+
+    // Day CSVs are read from the chart's first bar on; an earlier window re-reads the cached days
+    long long fromMs = LLONG_MIN;
+    if (sc.ArraySize > 0)
+        fromMs = (long long)(((sc.BaseDateTimeIn[0].GetAsDouble() - 25569.0) * 86400.0 - tzOffset * 3600.0) * 1000.0);
+    if (fromMs < data->CsvLoadedFromMs)
+    {
+        data->CachedFilePaths.clear();
+        data->FileOffsets.clear();
+        data->FileIds.clear();
+        data->ColumnSlots.clear();
+        data->CsvLoadedFromMs = fromMs;
     }
 
     SCDateTime reference = sc.GetCurrentDateTime();
 
-    int totalRowsLoaded = 0;
+    // The catalog replaces the per-day probes for the days it covers (see DayCatalog::Covers)
+    RefreshDayCatalog(data->Catalog, GetCatalogPath(baseFolder, ticker));
+
+    // Resolve each day to the file it is read from ("" = nothing on disk)
+    std::vector<std::string> dayPaths(days);
     for (int i = days - 1; i >= 0; --i)
     {
         SCDateTime date = SubtractDays(reference, i);
+        int ymd = date.GetYear() * 10000 + date.GetMonth() * 100 + date.GetDay();
+
         std::string suffix = FormatDateSuffix(date);
         std::string path = baseFolder + "\\Tickers " + suffix + "\\" + ticker + ".csv";
+        std::string gexbPath = GexbPathFor(path);
+        std::string archivePath = path.substr(0, path.size() - 4) + ".gexz";
+
+        // A covered day is taken as listed, the other formats are not probed. A listed
+        // file not read yet is looked for once: if it is gone the catalog missed a
+        // change and the day is probed like an uncovered one (older than the catalog,
+        // or today, which writers list at most once a minute).
+        static const char* formats[] = { "gexb", "csv", "gexz" };
+        const std::string* formatPaths[] = { &gexbPath, &path, &archivePath };
+        bool trusted = i > 0 && data->Catalog.Covers(ymd);
+        for (int k = 0; k < 3 && trusted; ++k)
+        {
+            const std::string& listedPath = *formatPaths[k];
+            if (data->Catalog.Lists(ymd, formats[k]) && data->CachedFilePaths.count(listedPath) == 0 &&
+                data->FileOffsets.count(listedPath) == 0 && !FileExists(listedPath))
+                trusted = false;
+        }
+        auto has = [&](int k) { return trusted ? data->Catalog.Lists(ymd, formats[k]) : FileExists(*formatPaths[k]); };
+
+        // Prefer the binary columnar twin when present: mapped, no parsing
+        if (has(0)) dayPaths[i] = gexbPath;
+        else if (has(1)) dayPaths[i] = path;
+        else if (has(2)) dayPaths[i] = archivePath; // Compacted closed day
+        else if (i < 3)
+        {
+            SCString msg;
+            msg.Format("GEX_TERMINAL: File not found: %s", path.c_str());
+            sc.AddMessageToLog(msg, 0);
+        }
+    }
+
+    // Closed days never read before (startup, a longer DaysToLoad) are parsed on the
+    // pool, each into its own GammaData; today and resumed files stay on the study thread
+    struct PooledDay
+    {
+        std::string Path;
+        int Rows = 0;
+        GammaData Chunk;
+    };
+    std::vector<PooledDay> pooled;
+    std::vector<int> pooledAt(days, -1);
+    for (int i = days - 1; i >= 1; --i)
+    {
+        const std::string& path = dayPaths[i];
+        if (path.empty() || data->CachedFilePaths.count(path) > 0 || data->FileOffsets.count(path) > 0)
+            continue;
+        pooledAt[i] = (int)pooled.size();
+        pooled.emplace_back();
+        pooled.back().Path = path;
+    }
+    bool usePool = pooled.size() > 1 && std::thread::hardware_concurrency() > 1;
+    if (usePool)
+    {
+        long long fromMs = data->CsvLoadedFromMs;
+        RunPool(pooled.size(), [&](size_t j) {
+            pooled[j].Rows = LoadGammaDay(pooled[j].Path, tzOffset, fromMs, fieldMask, &pooled[j].Chunk);
+        });
+    }
+
+    int totalRowsLoaded = 0;
+    for (int i = days - 1; i >= 0; --i)
+    {
+        const std::string& path = dayPaths[i];
+        if (path.empty())
+            continue;
 
         bool isToday = (i == 0);
         bool isAlreadyLoaded = data->CachedFilePaths.count(path) > 0;
         bool refreshDue = (sc.CurrentSystemDateTime - data->LastRefreshTime).GetAsDouble() > (refreshSeconds / 86400.0);
+        bool parsedOnPool = pooledAt[i] >= 0 && usePool;
 
-        if (FileExists(path))
+        // Out of time: the remaining files wait for the next call (days the pool parsed are merged regardless)
+        if ((isToday ? refreshDue : !isAlreadyLoaded) && !parsedOnPool && PastDeadline(deadline))
         {
-            if (isToday && refreshDue)
-            {
-                int rows = LoadSingleCSV(sc, path, tzOffset, data);
+            data->LoadPending = true;
+            continue;
+        }
+
+        if (isToday && refreshDue)
+        {
+            int rows = ReportDayLoad(sc, path, LoadGammaDay(path, tzOffset, data->CsvLoadedFromMs, fieldMask, data, deadline));
+            if (!data->LoadPending) // A read stopped half way stays due
                 data->LastRefreshTime = sc.CurrentSystemDateTime;
-                totalRowsLoaded += rows;
+            totalRowsLoaded += rows;
+        }
+        else if (!isToday && !isAlreadyLoaded)
+        {
+            int rows;
+            if (parsedOnPool)
+            {
+                // Parsed on the pool: merged in day order, oldest first
+                PooledDay& day = pooled[pooledAt[i]];
+                MergeGammaChunk(data, day.Chunk);
+                rows = ReportDayLoad(sc, path, day.Rows);
             }
-            else if (!isToday && !isAlreadyLoaded)
+            else
             {
-                int rows = LoadSingleCSV(sc, path, tzOffset, data);
-                if (rows > 0)
-                {
-                    data->CachedFilePaths.insert(path);
-                    totalRowsLoaded += rows;
-                }
+                // Yesterday's file read as today's resumes from its cursor and may add no rows
+                rows = ReportDayLoad(sc, path, LoadGammaDay(path, tzOffset, data->CsvLoadedFromMs, fieldMask, data, deadline));
             }
-        }
-        else
-        {
-            if (i < 3)
+            if (data->LoadPending)
+                totalRowsLoaded += rows; // Stopped at the deadline: resumed from its cursor next call
+            else if (rows > 0 || data->FileOffsets.count(path) > 0)
             {
-                SCString msg;
-                msg.Format("GEX_TERMINAL: File not found: %s", path.c_str());
-                sc.AddMessageToLog(msg, 0);
+                data->CachedFilePaths.insert(path);
+                totalRowsLoaded += rows;
             }
         }
     }
     
+    // Rows that arrived out of order (overlapping day files) are merged before the chart reads them
+    data->Series.Flush();
+
     if (totalRowsLoaded > 0)
     {
         SCString msg;
-        msg.Format("GEX_TERMINAL: Total loaded: %d rows, Zero points: %d", totalRowsLoaded, (int)data->zeroMap.size());
+        msg.Format("GEX_TERMINAL: Total loaded: %d rows, Series rows: %d", totalRowsLoaded, (int)data->Series.Size());
         sc.AddMessageToLog(msg, 0);
     }
 }
 
+// Chart text at the top left while history is still loading; empty text removes it
+void ShowLoadProgress(SCStudyInterfaceRef sc, GammaData* data, const std::string& text)
+{
+    if (text == data->ShownProgress) return;
+    data->ShownProgress = text;
+    if (text.empty())
+    {
+        sc.DeleteACSChartDrawing(sc.ChartNumber, TOOL_DELETE_CHARTDRAWING, LOAD_PROGRESS_LINE + sc.StudyGraphInstanceID);
+        return;
+    }
+
+    s_UseTool tool;
+    tool.Clear();
+    tool.ChartNumber = sc.ChartNumber;
+    tool.DrawingType = DRAWING_TEXT;
+    tool.LineNumber = LOAD_PROGRESS_LINE + sc.StudyGraphInstanceID;
+    tool.AddMethod = UTAM_ADD_OR_ADJUST;
+    tool.Region = sc.GraphRegion;
+    tool.UseRelativeVerticalValues = 1;
+    tool.BeginDateTime = 2;     // % from the left
+    tool.BeginValue = 97;       // % from the bottom
+    tool.Color = RGB(252, 177, 3);
+    tool.FontSize = 9;
+    tool.Text = text.c_str();
+    sc.UseTool(tool);
+}
+
 // =========================
 //   UPDATE MAPS + WRITE
 // =========================
@@ -682,15 +2356,11 @@ void UpdateMapsAndWriteCSV(SCStudyInterfaceRef sc, GammaData* data,
         ? static_cast<float>(data->ProfileMeta.zero_gamma)
         : static_cast<float>(data->Majors.zero_gamma);
     
-    if (zeroGamma != 0) data->zeroMap[scDateTime] = zeroGamma;
-    if (data->Majors.mpos_vol != 0) data->posVolMap[scDateTime] = static_cast<float>(data->Majors.mpos_vol);
-    if (data->Majors.mneg_vol != 0) data->negVolMap[scDateTime] = static_cast<float>(data->Majors.mneg_vol);
-    if (data->Majors.mpos_oi != 0) data->posOiMap[scDateTime] = static_cast<float>(data->Majors.mpos_oi);
-    if (data->Majors.mneg_oi != 0) data->negOiMap[scDateTime] = static_cast<float>(data->Majors.mneg_oi);
-    if (data->Greeks.major_long_gamma != 0) data->longMap[scDateTime] = static_cast<float>(data->Greeks.major_long_gamma);
-    if (data->Greeks.major_short_gamma != 0) data->shortMap[scDateTime] = static_cast<float>(data->Greeks.major_short_gamma);
-    if (data->Greeks.major_positive != 0) data->majPosMap[scDateTime] = static_cast<float>(data->Greeks.major_positive);
-    if (data->Greeks.major_negative != 0) data->majNegMap[scDateTime] = static_cast<float>(data->Greeks.major_negative);
+    double row[GS_COUNT] = { zeroGamma, data->Majors.mpos_vol, data->Majors.mneg_vol, data->Majors.mpos_oi, data->Majors.mneg_oi, 0,
+        data->Greeks.major_long_gamma, data->Greeks.major_short_gamma, data->Greeks.major_positive, data->Greeks.major_negative, 0 };
+    float cells[GS_COUNT];
+    for (int s = 0; s < GS_COUNT; ++s)
+        cells[s] = (row[s] != 0) ? static_cast<float>(row[s]) : NAN;
     
     // Calculate net
     if (sc.BaseData[SC_CLOSE].GetArraySize() > 0 && sc.Index >= 0)
@@ -699,9 +2369,12 @@ void UpdateMapsAndWriteCSV(SCStudyInterfaceRef sc, GammaData* data,
         if (spot != 0 && data->Majors.mpos_vol != 0 && data->Majors.mneg_vol != 0)
         {
             float netGex = static_cast<float>(data->Majors.mpos_vol - fabs(data->Majors.mneg_vol));
-            data->netMap[scDateTime] = spot + netGex / 100.0f;
+            cells[GS_NET] = spot + netGex / 100.0f;
         }
     }
+
+    data->Series.Add(scDateTime.GetAsDouble(), cells);
+    data->Series.Flush();
     
     // Write to CSV file
     if (!writePath.empty() && !ticker.empty())
@@ -714,7 +2387,28 @@ void UpdateMapsAndWriteCSV(SCStudyInterfaceRef sc, GammaData* data,
         snprintf(dateStr, sizeof(dateStr), "%02d.%02d.%04d", month, day, year);
         std::string todayCsvPath = writePath + "\\Tickers " + dateStr + "\\" + ticker + ".csv";
         
-        WriteToCsvFile(sc, data, todayCsvPath);
+        if (WriteToCsvFile(sc, data, todayCsvPath))
+        {
+            // Day catalog: right away for a new day file, then at most once per CATALOG_UPDATE_SEC
+            CommitRecord rec;
+            long long rows = ReadCommitRecord(todayCsvPath, rec) ? (long long)rec.RowCount : -1;
+            if (rows == 1 || (scDateTime - data->LastCatalogUpdate).GetAsDouble() * 86400.0 >= CATALOG_UPDATE_SEC)
+            {
+                double unixTs = (scDateTime.GetAsDouble() - 25569.0) * 86400.0;
+                int ymd = year * 10000 + month * 100 + day;
+                std::vector<CatalogEntry> updates;
+                static const char* formats[] = { "csv", "gexb" };
+                for (const char* format : formats)
+                {
+                    unsigned long long bytes = 0;
+                    if (!GetFileSize64(todayCsvPath.substr(0, todayCsvPath.size() - 3) + format, bytes)) continue;
+                    CatalogEntry e = { ymd, format, rows, unixTs, unixTs, bytes };
+                    updates.push_back(e);
+                }
+                UpdateCatalog(GetCatalogPath(writePath, ticker), updates, rows != 1);
+                data->LastCatalogUpdate = scDateTime;
+            }
+        }
     }
 }
 
@@ -755,6 +2449,7 @@ SCSFExport scsf_GexBotAPI(SCStudyInterfaceRef sc)
     SCInputRef ShowGreekMajorNegInput = sc.Input[14];
     SCInputRef ShowMajorLongGammaInput = sc.Input[15];
     SCInputRef ShowMajorShortGammaInput = sc.Input[16];
+    SCInputRef LoadBudgetMsInput = sc.Input[17];
 
     if (sc.SetDefaults)
     {
@@ -763,7 +2458,8 @@ SCSFExport scsf_GexBotAPI(SCStudyInterfaceRef sc)
         sc.GraphRegion = 0;
         sc.ValueFormat = 2;
         // sc.MakeHTTPRequest automatically triggers a study callback when the response arrives.
-        // No need for UpdateAlways - normal bar/tick updates handle refresh timing.
+        // No need for UpdateAlways - normal bar/tick updates handle refresh timing
+        // (it is only on while a time-budgeted history load is still in progress).
 
         // Subgraphs
         LongGamma.Name = "Long Gamma"; LongGamma.DrawStyle = DRAWSTYLE_DASH; LongGamma.PrimaryColor = RGB(0, 255, 255); LongGamma.LineWidth = 2;
@@ -803,6 +2499,7 @@ SCSFExport scsf_GexBotAPI(SCStudyInterfaceRef sc)
         ShowGreekMajorNegInput.Name = "Show Greek Major -"; ShowGreekMajorNegInput.SetYesNo(1);
         ShowMajorLongGammaInput.Name = "Show Major Long Gamma"; ShowMajorLongGammaInput.SetYesNo(0);
         ShowMajorShortGammaInput.Name = "Show Major Short Gamma"; ShowMajorShortGammaInput.SetYesNo(0);
+        LoadBudgetMsInput.Name = "History Load Time per Update (ms, 0=All at Once)"; LoadBudgetMsInput.SetInt(20);
 
         return;
     }
@@ -812,6 +2509,9 @@ SCSFExport scsf_GexBotAPI(SCStudyInterfaceRef sc)
         GammaData* data = static_cast<GammaData*>(sc.GetPersistentPointer(1));
         if (data)
         {
+            // Next start restores this instead of re-reading every closed day
+            if (data->HistoricalDataLoaded && data->Series.Size() != data->CacheSavedRows)
+                SaveGammaCache(GetGammaCachePath(data->LastBasePath, data->LastTickerForFile), data);
             delete data;
             sc.SetPersistentPointer(1, nullptr);
         }
@@ -829,6 +2529,21 @@ SCSFExport scsf_GexBotAPI(SCStudyInterfaceRef sc)
     float multiplier = MultiplierInput.GetFloat();
     bool isLastBar = (sc.Index == sc.ArraySize - 1);
 
+    // History is read at the last bar: rows it added are drawn on the next call, from the
+    // first bar they can affect rather than with a full recalculation
+    if (sc.Index == sc.UpdateStartIndex && data->Series.ChangedFrom < DBL_MAX)
+    {
+        double changedFrom = data->Series.ChangedFrom;
+        data->Series.ChangedFrom = DBL_MAX;
+        if (sc.UpdateStartIndex > 0)
+        {
+            int firstBar = (changedFrom == -DBL_MAX) ? 0 : sc.GetContainingIndexForSCDateTime(sc.ChartNumber, SCDateTime(changedFrom));
+            sc.UpdateStartIndex = std::max(0, std::min(sc.UpdateStartIndex, firstBar));
+        }
+        if (!data->LoadPending)
+            sc.UpdateAlways = 0;
+    }
+
     // ========================================
     //   LAST BAR ONLY: CSV loading + async HTTP
     // ========================================
@@ -843,16 +2558,54 @@ SCSFExport scsf_GexBotAPI(SCStudyInterfaceRef sc)
         std::string readPath = CsvReadPathInput.GetString();
         int daysToLoad = DaysToLoadInput.GetInt();
         int tzOffset = TZOffsetInput.GetInt();
+        // Only the CSV columns something draws are parsed; showing an OI wall reloads
+        unsigned int fieldMask = GAMMA_BASE_FIELDS | (ShowMajorPosOiInput.GetYesNo() ? 1u << 5 : 0u) |
+                                 (ShowMajorNegOiInput.GetYesNo() ? 1u << 6 : 0u);
         
         bool paramsChanged = (readPath != data->LastBasePath || 
                              ticker != data->LastTickerForFile || 
                              daysToLoad != data->LastDaysCount || 
-                             tzOffset != data->LastTZOffset);
+                             tzOffset != data->LastTZOffset ||
+                             fieldMask != data->LastFieldMask);
         
-        if (!readPath.empty() && !ticker.empty() && (paramsChanged || !data->HistoricalDataLoaded))
+        if (!readPath.empty() && !ticker.empty() && (paramsChanged || !data->HistoricalDataLoaded || data->LoadPending))
         {
-            LoadRecentGammaFiles(sc, data, readPath, ticker, daysToLoad, tzOffset, refreshInterval);
+            // Cold start: closed days come from the last snapshot, only today's file is read
+            if (!data->HistoricalDataLoaded && data->Series.Empty() &&
+                LoadGammaCache(GetGammaCachePath(readPath, ticker), readPath, ticker, daysToLoad, tzOffset, fieldMask, data))
+                data->CacheSavedRows = data->Series.Size();
+
+            // On a budget the load goes on over the next calls (see LOAD BUDGET)
+            LoadDeadline deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(LoadBudgetMsInput.GetInt());
+            LoadRecentGammaFiles(sc, data, readPath, ticker, daysToLoad, tzOffset, refreshInterval, fieldMask,
+                LoadBudgetMsInput.GetInt() > 0 ? &deadline : nullptr);
             data->HistoricalDataLoaded = true;
+
+            // Ask for calls without ticks until done and drawn; earlier bars are redrawn as history fills in
+            sc.UpdateAlways = (data->LoadPending || data->Series.ChangedFrom < DBL_MAX) ? 1 : 0;
+
+            std::string progress;
+            if (data->LoadPending)
+            {
+                progress = "GEX BOT API: loading history";
+                size_t folder = data->LoadingPath.find("Tickers ");
+                if (folder != std::string::npos)
+                {
+                    char buffer[64];
+                    std::string day = data->LoadingPath.substr(folder + 8, data->LoadingPath.find('\\', folder) - folder - 8);
+                    snprintf(buffer, sizeof(buffer), " - %s %d%%", day.c_str(), data->LoadingPercent);
+                    progress += buffer;
+                }
+            }
+            ShowLoadProgress(sc, data, progress);
+        }
+
+        if (data->HistoricalDataLoaded && (sc.CurrentSystemDateTime - data->LastCacheSave).GetAsDouble() * 86400.0 >= GAMMA_CACHE_SAVE_SEC)
+        {
+            size_t rows = data->Series.Size();
+            if (rows != data->CacheSavedRows && SaveGammaCache(GetGammaCachePath(data->LastBasePath, data->LastTickerForFile), data))
+                data->CacheSavedRows = rows;
+            data->LastCacheSave = sc.CurrentSystemDateTime;
         }
 
         // ------ STATE: IDLE ------
@@ -1003,29 +2756,30 @@ SCSFExport scsf_GexBotAPI(SCStudyInterfaceRef sc)
 
     SCDateTime now = sc.BaseDateTimeIn[sc.Index];
     
-    // Debug: log map sizes once on full recalculation
-    if (sc.Index == 0 && sc.IsFullRecalculation && !data->zeroMap.empty())
+    // Debug: log the series size once on full recalculation
+    if (sc.Index == 0 && sc.IsFullRecalculation && !data->Series.Empty())
     {
         SCString msg;
-        msg.Format("GEX_TERMINAL: Maps loaded - Zero: %d, PosVol: %d, Long: %d", 
-                   (int)data->zeroMap.size(), (int)data->posVolMap.size(), (int)data->longMap.size());
+        msg.Format("GEX_TERMINAL: Series loaded - %d rows", (int)data->Series.Size());
         sc.AddMessageToLog(msg, 0);
     }
     
-    auto getVal = [&](const std::map<SCDateTime, float>& map) -> float {
-        return GetValueAtTime(map, now);
+    // One row serves every series of the bar, found by stepping on from the previous bar's
+    size_t row = data->Series.Seek(now.GetAsDouble(), data->BarCursor);
+    auto getVal = [&](int series) -> float {
+        return GetValueAtTime(data->Series, row, series, now);
     };
     
-    float zeroVal = getVal(data->zeroMap);
-    float posVolVal = getVal(data->posVolMap);
-    float negVolVal = getVal(data->negVolMap);
-    float posOiVal = getVal(data->posOiMap);
-    float negOiVal = getVal(data->negOiMap);
-    float netVal = getVal(data->netMap);
-    float longVal = getVal(data->longMap);
-    float shortVal = getVal(data->shortMap);
-    float majPosVal = getVal(data->majPosMap);
-    float majNegVal = getVal(data->majNegMap);
+    float zeroVal = getVal(GS_ZERO);
+    float posVolVal = getVal(GS_POS_VOL);
+    float negVolVal = getVal(GS_NEG_VOL);
+    float posOiVal = getVal(GS_POS_OI);
+    float negOiVal = getVal(GS_NEG_OI);
+    float netVal = getVal(GS_NET);
+    float longVal = getVal(GS_LONG);
+    float shortVal = getVal(GS_SHORT);
+    float majPosVal = getVal(GS_MAJ_POS);
+    float majNegVal = getVal(GS_MAJ_NEG);
 
     float zeroGamma = (zeroVal != -FLT_MAX) ? zeroVal : ((data->ProfileMeta.zero_gamma != 0) ? static_cast<float>(data->ProfileMeta.zero_gamma) : static_cast<float>(data->Majors.zero_gamma));
     LongGamma[sc.Index] = multiplier * ((longVal != -FLT_MAX) ? longVal : static_cast<float>(data->Greeks.major_long_gamma));
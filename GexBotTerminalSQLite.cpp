@@ -1,7 +1,12 @@
 #include "sierrachart.h"
 #include "sqlite3.h"
 #include <vector>
+#include <set>
 #include <string>
+#include <fstream>
+#include <climits>
+#include <atomic>
+#include <thread>
 #include <oleauto.h>
 
 SCDLLName("GEX_TERMINAL")
@@ -30,6 +35,7 @@ struct GammaData
     int LastBarIndex = -1;
     bool HasCachedRow = false;
     GammaRow CachedRow = {}; // évite warning "uninitialized"
+    size_t RowCursor = 0;    // Position de FindLastInBar à la dernière bougie
 };
 
 static bool FileExists(const std::string& p)
@@ -57,6 +63,7 @@ static void ResetAll(GammaData* d)
     d->LastBarIndex = -1;
     d->HasCachedRow = false;
     d->CachedRow = {};
+    d->RowCursor = 0;
 
     if (d->TodayDB)
     {
@@ -107,26 +114,32 @@ static void LoadIncremental(sqlite3* db, const SCDateTime& TimeScaleAdjustment,
     sqlite3_finalize(st);
 }
 
+// cursor : nombre de lignes avant la fin de la bougie précédente. Les bougies
+// sont parcourues dans l'ordre, on avance donc depuis là (recalcul complet en
+// O(bougies + lignes)) ; une bougie plus ancienne relance la recherche binaire.
 static bool FindLastInBar(
     const std::vector<GammaRow>& rows,
     double barStart,
     double barEnd,
     double maxAgeDays,
+    size_t& cursor,
     GammaRow& out)
 {
-    if (rows.empty())
-        return false;
-
-    auto it = std::lower_bound(
-        rows.begin(),
-        rows.end(),
-        barEnd,
-        [](const GammaRow& r, double t) { return r.ts < t; });
+    if (cursor > rows.size() || (cursor > 0 && rows[cursor - 1].ts >= barEnd))
+    {
+        cursor = std::lower_bound(
+            rows.begin(),
+            rows.end(),
+            barEnd,
+            [](const GammaRow& r, double t) { return r.ts < t; }) - rows.begin();
+    }
+    while (cursor < rows.size() && rows[cursor].ts < barEnd)
+        ++cursor;
 
-    if (it == rows.begin())
+    if (cursor == 0)
         return false;
 
-    --it;
+    auto it = rows.begin() + (cursor - 1);
 
     if (it->ts < barStart)
         return false;
@@ -140,12 +153,178 @@ static bool FindLastInBar(
     return false;
 }
 
-static void EnsureLoaded(
+// Catalogue des jours : "<base>\<Ticker>.catalog" liste les fichiers de jour
+// existants d'un ticker, une ligne par jour et par format :
+// date,format,rows,min_ts,max_ts,bytes (secondes Unix, rows -1 = inconnu).
+// Écrit par le Collector, l'étude API et GexBotTerminal.cpp ; lu ici au lieu
+// de sonder chaque jour du calendrier. Entre son premier et son dernier .db
+// listés il fait foi : seuls les jours hors de cette plage sont sondés.
+
+#define CATALOG_HEADER "# GexBot day catalog v1: date,format,rows,min_ts,max_ts,bytes\r\n"
+
+struct CatalogEntry
+{
+    int Date;                   // YYYYMMDD du dossier "Tickers MM.DD.YYYY"
+    std::string Format;         // csv, gexb, grid, gexz, db
+    long long Rows;
+    double MinTs;
+    double MaxTs;
+    unsigned long long Bytes;
+};
+
+std::string GetCatalogPath(const std::string& baseFolder, const std::string& ticker)
+{
+    return baseFolder + "\\" + ticker + ".catalog";
+}
+
+bool ReadCatalog(const std::string& path, std::vector<CatalogEntry>& entries)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#') continue;
+        CatalogEntry e;
+        char format[16] = {0};
+        if (sscanf(line.c_str(), "%d,%15[^,],%lld,%lf,%lf,%llu", &e.Date, format, &e.Rows, &e.MinTs, &e.MaxTs, &e.Bytes) != 6)
+            continue;
+        e.Format = format;
+        entries.push_back(e);
+    }
+    return true;
+}
+
+// Surveillance des fichiers : un thread attend dans ReadDirectoryChangesW sur
+// le dossier racine (dossiers de jour compris) et lève Changed quand un fichier
+// du ticker surveillé est écrit ou créé (<ticker>.db et son journal -wal). La DB
+// du jour n'est relue que si le drapeau est levé, et non à chaque appel ; si la
+// racine ne peut pas être surveillée, ou si la surveillance échoue plus tard,
+// chaque appel relit la DB.
+
+#define WATCH_BUFFER_BYTES 65536
+
+struct DirectoryWatcher
+{
+    std::string Folder;
+    std::string Ticker;
+    std::atomic<bool> Changed{ true };  // Levé au départ : le premier appel charge
+    std::atomic<bool> Active{ false };  // False = relecture à chaque appel
+
+    HANDLE Dir = INVALID_HANDLE_VALUE;
+    HANDLE StopEvent = NULL;
+    std::thread Thread;
+
+    bool Start(const std::string& folder, const std::string& ticker)
+    {
+        Folder = folder;
+        Ticker = ticker;
+        std::wstring wPath(folder.begin(), folder.end());
+        Dir = CreateFileW(wPath.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+        if (Dir == INVALID_HANDLE_VALUE) return false;
+        StopEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+        if (!StopEvent) { Stop(); return false; }
+
+        Active = true;
+        Thread = std::thread([this] { Run(); });
+        return true;
+    }
+
+    void Stop()
+    {
+        if (StopEvent) SetEvent(StopEvent);
+        if (Thread.joinable()) Thread.join();
+        if (StopEvent) CloseHandle(StopEvent);
+        if (Dir != INVALID_HANDLE_VALUE) CloseHandle(Dir);
+        StopEvent = NULL;
+        Dir = INVALID_HANDLE_VALUE;
+        Active = false;
+    }
+
+    ~DirectoryWatcher() { Stop(); }
+
+    // "<ticker>.<extension>" à la racine ou dans un dossier de jour ; sauf les
+    // fichiers temporaires (leur renommage est signalé à part) et l'index -shm
+    // que nos propres lectures mettent à jour
+    bool IsRelevant(const wchar_t* name, size_t length) const
+    {
+        std::wstring path(name, length);
+        size_t slash = path.find_last_of(L'\\');
+        std::wstring file = (slash == std::wstring::npos) ? path : path.substr(slash + 1);
+        std::wstring prefix(Ticker.begin(), Ticker.end());
+        prefix += L'.';
+        if (file.compare(0, prefix.size(), prefix) != 0) return false;
+
+        static const wchar_t* IGNORED[] = { L".tmp", L"-shm", L".viewcache", L".apicache" };
+        for (const wchar_t* ext : IGNORED)
+        {
+            size_t n = wcslen(ext);
+            if (file.size() >= n && file.compare(file.size() - n, n, ext) == 0) return false;
+        }
+        return true;
+    }
+
+    void Run()
+    {
+        std::vector<DWORD> buffer(WATCH_BUFFER_BYTES / sizeof(DWORD)); // Aligné sur DWORD, comme l'exige l'API
+        OVERLAPPED ov = {};
+        ov.hEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+        if (!ov.hEvent) { Active = false; return; }
+
+        HANDLE waits[2] = { StopEvent, ov.hEvent };
+        for (;;)
+        {
+            ResetEvent(ov.hEvent);
+            if (!ReadDirectoryChangesW(Dir, buffer.data(), WATCH_BUFFER_BYTES, TRUE,
+                    FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE, NULL, &ov, NULL))
+                break;
+
+            DWORD bytes = 0;
+            if (WaitForMultipleObjects(2, waits, FALSE, INFINITE) != WAIT_OBJECT_0 + 1)
+            {
+                // Arrêt demandé : la lecture en cours doit finir avant de libérer le tampon
+                CancelIoEx(Dir, &ov);
+                GetOverlappedResult(Dir, &ov, &bytes, TRUE);
+                CloseHandle(ov.hEvent);
+                return;
+            }
+            if (!GetOverlappedResult(Dir, &ov, &bytes, FALSE))
+                break;
+
+            // Zéro octet = liste des changements débordée : tout a pu changer
+            if (bytes == 0) { Changed = true; continue; }
+
+            const char* p = (const char*)buffer.data();
+            for (;;)
+            {
+                const FILE_NOTIFY_INFORMATION* info = (const FILE_NOTIFY_INFORMATION*)p;
+                if (IsRelevant(info->FileName, info->FileNameLength / sizeof(wchar_t)))
+                {
+                    Changed = true;
+                    break;
+                }
+                if (info->NextEntryOffset == 0) break;
+                p += info->NextEntryOffset;
+            }
+        }
+
+        // Surveillance perdue (dossier supprimé, partage coupé) : relecture à chaque appel
+        CloseHandle(ov.hEvent);
+        Changed = true;
+        Active = false;
+    }
+};
+
+// Retourne true si la DB du jour doit être relue (fichiers modifiés, rechargement ou nouveau jour)
+static bool EnsureLoaded(
     SCStudyInterfaceRef sc,
     GammaData* d,
     const std::string& folder,
     const std::string& ticker,
-    int days)
+    int days,
+    bool filesChanged)
 {
     SCDateTime systemDay = sc.CurrentSystemDateTime.GetDate();
 
@@ -158,6 +337,8 @@ static void EnsureLoaded(
         d->LastSystemDay != 0 &&
         systemDay != d->LastSystemDay;
 
+    bool readToday = filesChanged || !d->Initialized || paramsChanged || dayChanged;
+
     if (!d->Initialized || paramsChanged)
     {
         ResetAll(d);
@@ -171,10 +352,46 @@ static void EnsureLoaded(
         int loadedDays = 0;
         SCDateTime day = systemDay;
 
+        // Catalogue présent : prendre directement les derniers jours .db listés
+        // (le catalogue est trié par date). Un fichier listé qui ne s'ouvre plus
+        // (supprimé depuis) ne compte pas : on passe au jour listé précédent.
+        std::vector<CatalogEntry> catalog;
+        std::vector<int> dbDays;
+        int today = systemDay.GetYear() * 10000 + systemDay.GetMonth() * 100 + systemDay.GetDay();
+        if (ReadCatalog(GetCatalogPath(folder, ticker), catalog))
+            for (const CatalogEntry& e : catalog)
+                if (e.Format == "db" && e.Date < today)
+                    dbDays.push_back(e.Date);
+
+        for (int k = (int)dbDays.size() - 1; k >= 0 && loadedDays < days - 1; --k)
+        {
+            char suffix[16];
+            sprintf_s(suffix, "%02d.%02d.%04d", dbDays[k] / 100 % 100, dbDays[k] % 100, dbDays[k] / 10000);
+            std::string path = folder + "\\Tickers " + suffix + "\\" + ticker + ".db";
+
+            sqlite3* db = nullptr;
+            if (sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK)
+            {
+                if (db) sqlite3_close(db);
+                continue;
+            }
+            LoadIncremental(db, sc.TimeScaleAdjustment, d);
+            sqlite3_close(db);
+            loadedDays++;
+        }
+
+        // Jours hors du catalogue (plus anciens que lui, écrits avant qu'il existe,
+        // ou pas de catalogue) : sondés jour par jour. Ceux de sa plage sont déjà pris.
+        int firstListed = dbDays.empty() ? INT_MAX : dbDays.front();
+        int lastListed = dbDays.empty() ? INT_MIN : dbDays.back();
         while (loadedDays < days - 1)
         {
             day = SCDateTime(day.GetAsDouble() - 1);
 
+            int ymd = day.GetYear() * 10000 + day.GetMonth() * 100 + day.GetDay();
+            if (ymd >= firstListed && ymd <= lastListed)
+                continue;
+
             int dow = day.GetDayOfWeek();
             if (dow == SATURDAY || dow == SUNDAY)
                 continue;
@@ -224,10 +441,11 @@ static void EnsureLoaded(
         FormatDateSuffix(systemDay) + "\\" +
         ticker + ".db";
 
-    if (!d->TodayDB && FileExists(todayPath))
+    if (!d->TodayDB && readToday && FileExists(todayPath))
     {
         sqlite3_open_v2(todayPath.c_str(), &d->TodayDB, SQLITE_OPEN_READONLY, nullptr);
     }
+    return readToday;
 }
 
 SCSFExport scsf_GEX_TERMINAL(SCStudyInterfaceRef sc)
@@ -274,6 +492,13 @@ SCSFExport scsf_GEX_TERMINAL(SCStudyInterfaceRef sc)
 
     if (sc.LastCallToFunction)
     {
+        DirectoryWatcher* w0 = (DirectoryWatcher*)sc.GetPersistentPointer(1);
+        if (w0)
+        {
+            delete w0;
+            sc.SetPersistentPointer(1, nullptr);
+        }
+
         GammaData* d0 = (GammaData*)sc.GetPersistentPointer(0);
         if (d0)
         {
@@ -291,13 +516,26 @@ SCSFExport scsf_GEX_TERMINAL(SCStudyInterfaceRef sc)
         sc.SetPersistentPointer(0, d);
     }
 
-    EnsureLoaded(sc, d,
+    // Surveillance du dossier (voir DirectoryWatcher) : une par dossier et ticker
+    DirectoryWatcher* w = (DirectoryWatcher*)sc.GetPersistentPointer(1);
+    if (!w || w->Folder != Folder.GetString() || w->Ticker != Ticker.GetString())
+    {
+        delete w;
+        w = new DirectoryWatcher();
+        w->Start(Folder.GetString(), Ticker.GetString());
+        sc.SetPersistentPointer(1, w);
+    }
+    // Drapeau baissé avant la lecture : une écriture pendant celle-ci sera vue au prochain appel
+    bool filesChanged = !w->Active || w->Changed.exchange(false);
+
+    bool readToday = EnsureLoaded(sc, d,
         Folder.GetString(),
         Ticker.GetString(),
-        Days.GetInt());
+        Days.GetInt(),
+        filesChanged);
 
-    // Lecture DB immédiate (sans Refresh)
-    if (d->TodayDB)
+    // Lecture DB du jour dès qu'elle a changé (sans Refresh)
+    if (d->TodayDB && readToday)
         LoadIncremental(d->TodayDB, sc.TimeScaleAdjustment, d);
 
     const double maxAgeDays = MaxAgeSec.GetInt() / 86400.0;
@@ -321,7 +559,7 @@ SCSFExport scsf_GEX_TERMINAL(SCStudyInterfaceRef sc)
         if (!d->HasCachedRow)
         {
             GammaRow r;
-            if (FindLastInBar(d->Rows, barStart, barEnd, maxAgeDays, r))
+            if (FindLastInBar(d->Rows, barStart, barEnd, maxAgeDays, d->RowCursor, r))
             {
                 d->CachedRow = r;
                 d->HasCachedRow = true;
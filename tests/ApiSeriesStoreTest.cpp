@@ -0,0 +1,169 @@
+// Randomized test of the API study's SeriesStore (GexBotTerminalAPI.cpp)
+// against the per-series std::map it replaced: at any time, a series reads
+// the last value recorded at or before it, if at most GAMMA_FILL_SEC older.
+// Rows arrive in order, out of order (Pending), and as day chunks merged with
+// MergeFrom; a day dropped from the warm-start cache is erased. The fill
+// source of every cell (SourceTime) and ChangedFrom are checked too.
+//
+// Build and run (from the repository root; needs Sierra Chart's ACS_Source for sierrachart.h):
+//   Windows (MSVC): cl /std:c++17 /O2 /EHsc /I C:\SierraChart\ACS_Source tests\ApiSeriesStoreTest.cpp && ApiSeriesStoreTest.exe
+// Exit code 0 = all passed.
+
+#include "../GexBotTerminalAPI.cpp"
+
+#include <random>
+
+static int Checks = 0;
+static int Failures = 0;
+
+#define CHECK(cond, ...)                                                      \
+    do {                                                                      \
+        ++Checks;                                                             \
+        if (!(cond))                                                          \
+        {                                                                     \
+            if (++Failures <= 20)                                             \
+            {                                                                 \
+                fprintf(stderr, "FAILED %s:%d: %s: ", __FILE__, __LINE__, #cond); \
+                fprintf(stderr, __VA_ARGS__);                                 \
+                fprintf(stderr, "\n");                                        \
+            }                                                                 \
+        }                                                                     \
+    } while (0)
+
+// The old history: one map per series, recorded values only
+struct Reference
+{
+    std::map<double, float> Values[GS_COUNT];
+
+    void Add(double t, const float* values)
+    {
+        for (int s = 0; s < GS_COUNT; ++s)
+            if (!std::isnan(values[s])) Values[s][t] = values[s];
+    }
+
+    void Erase(double from, double to)
+    {
+        for (int s = 0; s < GS_COUNT; ++s)
+            Values[s].erase(Values[s].lower_bound(from), Values[s].lower_bound(to));
+    }
+
+    float Get(int s, double t) const
+    {
+        auto it = Values[s].upper_bound(t);
+        if (it == Values[s].begin()) return -FLT_MAX;
+        --it;
+        return (t - it->first) * 86400.0 <= GAMMA_FILL_SEC ? it->second : -FLT_MAX;
+    }
+};
+
+// A row at a random second of [45000, 45000 + span), each series present with probability 1 / every
+static double RandomRow(std::mt19937& rng, double from, int spanSec, int every, float* values)
+{
+    for (int s = 0; s < GS_COUNT; ++s)
+        values[s] = (rng() % every == 0) ? (float)(rng() % 100000) / 8.0f + 1.0f : NAN;
+    return from + (double)(rng() % spanSec) / 86400.0;
+}
+
+static void CompareAt(const SeriesStore& store, const Reference& ref, double t, size_t& cursor, int iter)
+{
+    size_t row = store.Seek(t, cursor);
+    for (int s = 0; s < GS_COUNT; ++s)
+    {
+        float got = GetValueAtTime(store, row, s, SCDateTime(t));
+        float want = ref.Get(s, t);
+        CHECK(got == want, "iteration %d, t %.6f, series %d: %g, expected %g", iter, t, s, got, want);
+    }
+}
+
+// SourceTime of every filled cell = the recorded row found by walking back
+static void CheckSources(const SeriesStore& store, int iter)
+{
+    bool ok = true;
+    for (int s = 0; s < GS_COUNT && ok; ++s)
+    {
+        size_t recorded = SeriesStore::NONE;
+        for (size_t r = 0; r < store.Times.size() && ok; ++r)
+        {
+            if (store.Observed[r] & (1u << s)) recorded = r;
+            if (std::isnan(store.Columns[s][r])) continue;
+            ok = recorded != SeriesStore::NONE && store.SourceTime(r, s) == store.Times[recorded] &&
+                 store.Columns[s][r] == store.Columns[s][recorded];
+        }
+    }
+    CHECK(ok, "iteration %d: a filled cell does not point at its recorded row", iter);
+}
+
+static void TestAgainstMap()
+{
+    std::mt19937 rng(11);
+    float values[GS_COUNT];
+    for (int iter = 0; iter < 400; ++iter)
+    {
+        SeriesStore store, chunk;
+        Reference ref;
+        int spanSec = 600 + (int)(rng() % 7200);
+        int every = 1 + (int)(rng() % 6);
+        int rows = (int)(rng() % 800);
+        for (int k = 0; k < rows; ++k)
+        {
+            double t = RandomRow(rng, 45000.0, spanSec, every, values);
+            ref.Add(t, values);
+            if (rng() % 4 == 0)
+            {
+                // Another day file parsed on its own, merged later
+                chunk.Add(t, values);
+                if (rng() % 20 == 0) store.MergeFrom(chunk);
+            }
+            else
+            {
+                if (!chunk.Empty()) store.MergeFrom(chunk);
+                store.Add(t, values);
+            }
+            if (rng() % 50 == 0) store.Flush();
+        }
+        store.MergeFrom(chunk);
+        store.Flush();
+
+        // Live rows at the tail, as the fetch appends them
+        store.ChangedFrom = DBL_MAX;
+        double tail = store.Times.empty() ? 45000.0 : store.Times.back();
+        double firstAdded = DBL_MAX;
+        for (int k = 0; k < 20; ++k)
+        {
+            tail += (1.0 + rng() % 400) / 86400.0;
+            RandomRow(rng, 0.0, 1, every, values);
+            ref.Add(tail, values);
+            store.Add(tail, values);
+            firstAdded = std::min(firstAdded, tail);
+        }
+        CHECK(store.ChangedFrom == firstAdded, "iteration %d: ChangedFrom %.6f, expected %.6f", iter, store.ChangedFrom, firstAdded);
+
+        // A changed day file (LoadGammaCache): its span goes, the rows after it fill again
+        if (rng() % 3 == 0 && !store.Times.empty())
+        {
+            double from = store.Times[rng() % store.Times.size()];
+            double to = from + (rng() % 3600) / 86400.0;
+            store.ChangedFrom = DBL_MAX;
+            size_t before = store.Size();
+            store.Erase(from, to);
+            ref.Erase(from, to);
+            CHECK(store.Size() == before || store.ChangedFrom <= from, "iteration %d: ChangedFrom after Erase", iter);
+        }
+
+        CheckSources(store, iter);
+
+        // Bars in time order (forward cursor), then random times (cursor searches again)
+        size_t cursor = 0;
+        for (int sec = -60; sec < spanSec + 9000; sec += 1 + (int)(rng() % 90))
+            CompareAt(store, ref, 45000.0 + sec / 86400.0, cursor, iter);
+        for (int q = 0; q < 300; ++q)
+            CompareAt(store, ref, 45000.0 + (double)(rng() % (spanSec + 9000)) / 86400.0, cursor, iter);
+    }
+}
+
+int main()
+{
+    TestAgainstMap();
+    printf("%d checks, %d failed\n", Checks, Failures);
+    return Failures ? 1 : 0;
+}
@@ -0,0 +1,333 @@
+// Tests for the CSV reading shared by the studies and GexBotArchiveTool.cpp:
+// ParseCsvNumber, TokenizeCsv (SSE2 and scalar paths, column slots) and the
+// day reader's committed length and torn last line. They run against the
+// archive tool's copy, which builds without Sierra Chart; the first test
+// checks that the copies in GexBotCSVViewer.cpp and GexBotTerminalAPI.cpp
+// are still the same code.
+//
+// Build and run (from the repository root):
+//   Linux/MinGW:    g++ -std=c++17 -O2 -pthread tests/CsvReaderTest.cpp -o CsvReaderTest && ./CsvReaderTest
+//   Windows (MSVC): cl /std:c++17 /O2 /EHsc tests\CsvReaderTest.cpp && CsvReaderTest.exe
+// Exit code 0 = all passed. --mb N sets the size of the generated CSVs (default 8).
+
+#define GEXBOT_ARCHIVE_TOOL_NO_MAIN
+#include "../GexBotArchiveTool.cpp"
+
+#include <random>
+
+static int Checks = 0;
+static int Failures = 0;
+
+#define CHECK(cond, ...)                                                      \
+    do {                                                                      \
+        ++Checks;                                                             \
+        if (!(cond))                                                          \
+        {                                                                     \
+            if (++Failures <= 20)                                             \
+            {                                                                 \
+                fprintf(stderr, "FAILED %s:%d: %s: ", __FILE__, __LINE__, #cond); \
+                fprintf(stderr, __VA_ARGS__);                                 \
+                fprintf(stderr, "\n");                                        \
+            }                                                                 \
+        }                                                                     \
+    } while (0)
+
+static bool Same(double a, double b) { return (std::isnan(a) && std::isnan(b)) || a == b; }
+
+static std::string ReadWholeFile(const fs::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+static void WriteWholeFile(const fs::path& path, const std::string& content)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), (std::streamsize)content.size());
+}
+
+// =========================
+//     SHARED CODE IN SYNC
+// =========================
+
+// From ParseCsvNumber's comment to the end of TokenizeCsv
+static std::string ExtractTokenizer(const std::string& source)
+{
+    size_t from = source.find("// Blanks around the number are ignored");
+    size_t body = source.find("void TokenizeCsv(", from);
+    if (from == std::string::npos || body == std::string::npos) return "";
+    size_t to = source.find("\n}\n", body);
+    return to == std::string::npos ? "" : source.substr(from, to + 3 - from);
+}
+
+static void TestCopiesInSync(const fs::path& root)
+{
+    std::string tool = ExtractTokenizer(ReadWholeFile(root / "GexBotArchiveTool.cpp"));
+    CHECK(!tool.empty(), "tokenizer not found in GexBotArchiveTool.cpp");
+    for (const char* study : { "GexBotCSVViewer.cpp", "GexBotTerminalAPI.cpp" })
+    {
+        std::string copy = ExtractTokenizer(ReadWholeFile(root / study));
+        CHECK(!copy.empty(), "tokenizer not found in %s", study);
+        CHECK(copy == tool, "%s: ParseCsvNumber/TokenizeCsv differ from GexBotArchiveTool.cpp", study);
+    }
+}
+
+// =========================
+//     PARSE CSV NUMBER
+// =========================
+
+static double Parse(const char* text) { return ParseCsvNumber(text, text + strlen(text)); }
+
+static void TestParseCsvNumber()
+{
+    CHECK(Parse("5123.25") == 5123.25, "plain");
+    CHECK(Parse("-0.5") == -0.5, "negative");
+    CHECK(Parse("+42") == 42.0, "leading plus");
+    CHECK(Parse("  7.5\t") == 7.5, "blanks around");
+    CHECK(Parse("7.5\r") == 7.5, "CR of a CRLF line");
+    CHECK(Parse("1e6") == 1e6 && Parse("2.5E-3") == 2.5e-3, "exponent");
+    CHECK(Parse("1767362400.1") == 1767362400.1, "timestamp");
+    CHECK(Parse("") == 0.0 && Parse("   ") == 0.0, "empty");
+    CHECK(Parse("abc") == 0.0 && Parse("--1") == 0.0, "not a number");
+    CHECK(std::isnan(Parse("nan")), "nan");
+
+    // Every float written with %.9g reads back exactly
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(-1e7f, 1e7f);
+    bool exact = true;
+    char text[32];
+    for (int i = 0; i < 100000 && exact; ++i)
+    {
+        float v = dist(rng);
+        snprintf(text, sizeof(text), "%.9g", v);
+        exact = ((float)Parse(text) == v);
+    }
+    CHECK(exact, "%%.9g float round trip");
+}
+
+// =========================
+//       TOKENIZE CSV
+// =========================
+
+struct RefRow
+{
+    std::vector<double> Values;     // Slot values, NaN = not filled
+    int Columns;
+    std::string Line;
+};
+
+// Straightforward split of the same input, for comparison
+static std::vector<RefRow> ReferenceTokenize(const std::string& text, const std::vector<int>& slots, int valueCount)
+{
+    std::vector<RefRow> rows;
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        size_t nl = text.find('\n', pos);
+        if (nl == std::string::npos) nl = text.size();
+        std::string line = text.substr(pos, nl - pos);
+        pos = nl + 1;
+        if (line.empty() || line == "\r") continue;
+
+        RefRow row;
+        row.Values.assign(valueCount, std::numeric_limits<double>::quiet_NaN());
+        row.Columns = 0;
+        row.Line = line;
+        size_t start = 0;
+        while (true)
+        {
+            size_t comma = line.find(',', start);
+            size_t stop = (comma == std::string::npos) ? line.size() : comma;
+            int c = row.Columns++;
+            if (c < (int)slots.size() && slots[c] >= 0)
+                row.Values[slots[c]] = ParseCsvNumber(line.data() + start, line.data() + stop);
+            if (comma == std::string::npos) break;
+            start = comma + 1;
+        }
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+static void CompareTokenizer(const std::string& text, const std::vector<int>& slots, int valueCount, const char* what)
+{
+    std::vector<RefRow> expected = ReferenceTokenize(text, slots, valueCount);
+    std::vector<double> values(valueCount);
+    size_t n = 0;
+    bool match = true;
+    TokenizeCsv(text.data(), text.data() + text.size(), slots, values.data(), valueCount,
+        [&](const double* row, int columns, const char* lineBegin, const char* lineEnd) {
+            if (!match) return;
+            if (n >= expected.size()) { match = false; return; }
+            const RefRow& e = expected[n++];
+            match = columns == e.Columns && std::string(lineBegin, lineEnd) == e.Line;
+            for (int s = 0; s < valueCount && match; ++s) match = Same(row[s], e.Values[s]);
+            if (!match) fprintf(stderr, "  %s: row %zu differs: \"%s\"\n", what, n - 1, e.Line.c_str());
+        });
+    CHECK(match && n == expected.size(), "%s: %zu of %zu rows matched", what, n, expected.size());
+}
+
+static void TestTokenizeCsv(size_t bytes)
+{
+    std::vector<int> all = { 0, 1, 2, 3, 4 };
+
+    // Hand-written edge cases: blank and CR-only lines, CRLF, empty fields, no final newline
+    CompareTokenizer("1,2,3\n\n\r\n4,,6\r\n7,8,9", all, 5, "edge lines");
+    CompareTokenizer("", all, 5, "empty input");
+    CompareTokenizer("\n\n", all, 5, "only newlines");
+    CompareTokenizer("1,2,3,4,5,6,7,8,9\n", { 0, -1, 1 }, 2, "skipped and extra columns");
+
+    // Lines of every length around the 16-byte SSE2 block, so delimiters land on each position
+    std::string blocks;
+    for (int len = 1; len <= 40; ++len)
+    {
+        std::string line;
+        for (int i = 0; (int)line.size() < len; ++i) line += (i % 3 == 2) ? ',' : (char)('0' + i % 10);
+        blocks += line + ((len % 2) ? "\n" : "\r\n");
+    }
+    CompareTokenizer(blocks, all, 5, "block boundaries");
+
+    // Generated day file of `bytes`: random column counts, blanks, CRLF, junk and a torn tail
+    std::mt19937 rng(7);
+    std::string text = "timestamp,spot,zero_gamma,major_pos_vol\n";
+    char field[48];
+    double ts = 1767362400.0;
+    while (text.size() < bytes)
+    {
+        int kind = rng() % 100;
+        if (kind == 0) { text += "\n"; continue; }
+        if (kind == 1) { text += "\r\n"; continue; }
+        ts += 0.1 * (rng() % 30);
+        snprintf(field, sizeof(field), "%.1f", ts);
+        text += field;
+        int columns = (kind < 90) ? 15 : (int)(rng() % 25);
+        for (int c = 1; c < columns; ++c)
+        {
+            int f = rng() % 50;
+            if (f == 0) snprintf(field, sizeof(field), ",");
+            else if (f == 1) snprintf(field, sizeof(field), ", %d ", (int)(rng() % 1000));
+            else if (f == 2) snprintf(field, sizeof(field), ",x%d", (int)(rng() % 10));
+            else snprintf(field, sizeof(field), ",%.9g", (float)((int)(rng() % 2000000) - 1000000) / 7.0f);
+            text += field;
+        }
+        text += (rng() % 2) ? "\r\n" : "\n";
+    }
+    text += "1767400000.0,6000.5,59"; // Torn last line, no newline
+
+    std::vector<int> slots;
+    for (int c = 0; c < 15; ++c) slots.push_back(c);
+    CompareTokenizer(text, slots, 15, "generated CSV, all columns");
+
+    std::vector<int> some(15, -1);
+    some[0] = 0; some[2] = 1; some[11] = 2;
+    CompareTokenizer(text, some, 3, "generated CSV, three columns");
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<double> values(15);
+    size_t rows = 0;
+    TokenizeCsv(text.data(), text.data() + text.size(), slots, values.data(), 15,
+        [&](const double*, int, const char*, const char*) { ++rows; });
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("  tokenized %.1f MB, %zu rows in %.1f ms (%.0f MB/s)\n", text.size() / 1048576.0, rows, sec * 1000.0,
+        text.size() / 1048576.0 / std::max(sec, 1e-9));
+}
+
+// =========================
+//   COMMITTED LENGTH / TORN
+// =========================
+
+static void WriteCommit(const fs::path& csv, unsigned long long committedBytes, unsigned long long rows, bool valid)
+{
+    CommitRecord rec = { COMMIT_MAGIC, COMMIT_VERSION, committedBytes, rows, 0 };
+    rec.Checksum = CommitChecksum(rec) ^ (valid ? 0 : 1);
+    std::ofstream out(csv.string() + ".commit", std::ios::binary | std::ios::trunc);
+    out.write((const char*)&rec, sizeof(rec));
+}
+
+static void TestCommittedSpan(const fs::path& dir, size_t bytes)
+{
+    fs::path csv = dir / "ES.csv";
+    std::string content = "timestamp,spot,zero_gamma\r\n";
+    std::vector<size_t> rowEnds;    // Byte length of the file after each complete row
+    std::mt19937 rng(11);
+    for (long long i = 0; content.size() < bytes; ++i)
+    {
+        char line[64];
+        snprintf(line, sizeof(line), "%.1f,%.9g,%.9g\r\n", 1767362400.0 + i * 0.5, 6000.0f + (rng() % 1000) / 8.0f,
+            5900.0f + (rng() % 1000) / 8.0f);
+        content += line;
+        rowEnds.push_back(content.size());
+    }
+    size_t complete = rowEnds.size();
+    std::string torn = content + "1767999999.0,6001.5,59";   // Writer stopped mid-row
+    WriteWholeFile(csv, torn);
+
+    // No commit record: every complete line, never the torn one
+    fs::remove(csv.string() + ".commit");
+    DayTable t;
+    CHECK(ReadCsvDay(csv.string(), t), "read without commit record");
+    CHECK(t.TsMs.size() == complete, "without commit: %zu rows, expected %zu", t.TsMs.size(), complete);
+    CHECK(t.FieldCount == 2 && t.Names == "spot,zero_gamma", "header: %d fields, \"%s\"", t.FieldCount, t.Names.c_str());
+    CHECK(!t.TsMs.empty() && t.TsMs.back() == (long long)((1767362400.0 + (complete - 1) * 0.5) * 1000.0 + 0.5),
+        "last row timestamp");
+
+    // Commit record: rows past CommittedBytes are not read, even when complete
+    size_t committedRows = complete / 3;
+    WriteCommit(csv, rowEnds[committedRows - 1], committedRows, true);
+    t = DayTable();
+    CHECK(ReadCsvDay(csv.string(), t), "read with commit record");
+    CHECK(t.TsMs.size() == committedRows, "with commit: %zu rows, expected %zu", t.TsMs.size(), committedRows);
+
+    // Committed length in the middle of a row: only the rows before it
+    WriteCommit(csv, rowEnds[committedRows - 1] + 7, committedRows, true);
+    t = DayTable();
+    CHECK(ReadCsvDay(csv.string(), t) && t.TsMs.size() == committedRows, "commit mid-row: %zu rows, expected %zu",
+        t.TsMs.size(), committedRows);
+
+    // Damaged record or one past the end of the file: ignored, the physical size is used
+    WriteCommit(csv, rowEnds[committedRows - 1], committedRows, false);
+    t = DayTable();
+    CHECK(ReadCsvDay(csv.string(), t) && t.TsMs.size() == complete, "bad checksum: %zu rows", t.TsMs.size());
+    WriteCommit(csv, torn.size() + 100, complete + 1, true);
+    t = DayTable();
+    CHECK(ReadCsvDay(csv.string(), t) && t.TsMs.size() == complete, "commit past end: %zu rows", t.TsMs.size());
+
+    // Values are the ones written
+    bool valuesOk = true;
+    std::string firstRow = content.substr(content.find('\n') + 1, 64);
+    double spot = strtod(firstRow.c_str() + firstRow.find(',') + 1, nullptr);
+    valuesOk = !t.Values.empty() && t.Values[0] == (float)spot;
+    CHECK(valuesOk, "first spot value");
+
+    // Only a header, and only a torn header: no rows
+    WriteWholeFile(csv, "timestamp,spot,zero_gamma\r\n");
+    fs::remove(csv.string() + ".commit");
+    t = DayTable();
+    CHECK(ReadCsvDay(csv.string(), t) && t.TsMs.empty(), "header only");
+    WriteWholeFile(csv, "timestamp,spo");
+    t = DayTable();
+    CHECK(ReadCsvDay(csv.string(), t) && t.TsMs.empty(), "torn header");
+}
+
+int main(int argc, char** argv)
+{
+    size_t mb = 8;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::string(argv[i]) == "--mb") mb = (size_t)std::max(1, atoi(argv[i + 1]));
+
+    fs::path root = fs::path(__FILE__).parent_path().parent_path();
+    fs::path dir = fs::temp_directory_path() / "GexBotCsvReaderTest";
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    fs::create_directories(dir);
+
+    printf("CSV reader tests (%zu MB generated)\n", mb);
+    TestCopiesInSync(root);
+    TestParseCsvNumber();
+    TestTokenizeCsv(mb << 20);
+    TestCommittedSpan(dir, mb << 20);
+
+    fs::remove_all(dir, ec);
+    printf("%d checks, %d failed\n", Checks, Failures);
+    return Failures ? 1 : 0;
+}
@@ -0,0 +1,140 @@
+// Startup benchmark of the Viewer's history load (GexBotCSVViewer.cpp): 30
+// days of 1 s rows (one package block) read from the CSVs with LoadViewerCSV,
+// then from their .gexb twins with LoadViewerGexb, each into an empty
+// ViewerData. Prints the time of each and checks both loads hold the same
+// rows and values (the twins carry the CSV values, see GexbTwinTest.cpp).
+//
+// Build and run (from the repository root; needs Sierra Chart's ACS_Source for sierrachart.h):
+//   Windows (MSVC): cl /std:c++17 /O2 /EHsc /I C:\SierraChart\ACS_Source tests\GexbStartupBench.cpp && GexbStartupBench.exe
+// Exit code 0 = both loads agree. --days N sets the number of days (default 30).
+
+#include "../GexBotCSVViewer.cpp"
+
+#include <filesystem>
+#include <random>
+
+namespace fs = std::filesystem;
+
+#define BENCH_ROWS_PER_DAY 23400    // 1 s rows over 09:30-16:00
+
+static std::string DayHeader()
+{
+    std::string header;
+    for (int c = 0; c < 15; ++c) header += std::string(c ? "," : "") + CSV_COLUMN_NAMES[c];
+    for (int f = 0; f < PACKAGE_FIELDS; ++f) header += std::string(",SPX.") + PACKAGE_FIELD_NAMES[f];
+    return header;
+}
+
+// One day as the Collector writes it: the CSV (4 decimals) and its twin with the same values
+static void WriteDay(const std::string& csvPath, const std::string& gexbPath, long long openUnix, std::mt19937& rng)
+{
+    std::string header = DayHeader();
+    int fieldCount = 14 + PACKAGE_FIELDS;
+    std::vector<long long> ts(BENCH_ROWS_PER_DAY);
+    std::vector<float> columns((size_t)fieldCount * BENCH_ROWS_PER_DAY);
+    std::string csv = header + "\r\n";
+    char buf[64];
+    double spot = 5000.0;
+    for (int r = 0; r < BENCH_ROWS_PER_DAY; ++r)
+    {
+        ts[r] = (openUnix + r) * 1000;
+        snprintf(buf, sizeof(buf), "%lld.0", openUnix + r);
+        csv += buf;
+        spot += ((int)(rng() % 2001) - 1000) / 4000.0;
+        for (int f = 0; f < fieldCount; ++f)
+        {
+            double v = f == 0 ? spot : spot + ((int)(rng() % 200001) - 100000) / 1000.0;
+            snprintf(buf, sizeof(buf), ",%.4f", v);
+            csv += buf;
+            columns[(size_t)f * BENCH_ROWS_PER_DAY + r] = (float)strtod(buf + 1, nullptr);
+        }
+        csv += "\r\n";
+    }
+    std::ofstream(csvPath, std::ios::binary).write(csv.data(), (std::streamsize)csv.size());
+
+    GexbHeader hdr;
+    hdr.Magic = GEXB_MAGIC;
+    hdr.Version = GEXB_VERSION;
+    hdr.FieldCount = fieldCount;
+    hdr.Capacity = BENCH_ROWS_PER_DAY;
+    hdr.RowCount = BENCH_ROWS_PER_DAY;
+    std::string names = header.substr(header.find(',') + 1);
+    hdr.NamesBytes = (int)((names.size() + 1 + 7) & ~(size_t)7);
+    names.resize(hdr.NamesBytes, '\0');
+
+    std::ofstream out(gexbPath, std::ios::binary);
+    out.write((const char*)&hdr, sizeof(hdr));
+    out.write(names.data(), (std::streamsize)names.size());
+    out.write((const char*)ts.data(), (std::streamsize)(ts.size() * sizeof(long long)));
+    out.write((const char*)columns.data(), (std::streamsize)(columns.size() * sizeof(float)));
+}
+
+// Loads every day into data (pooled, as ReloadFiles does); returns the milliseconds taken
+static double LoadAll(const std::vector<std::string>& paths, bool gexb, ViewerData& data)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ViewerData> chunks(paths.size());
+    RunPool(paths.size(), [&](size_t j) {
+        if (gexb) LoadViewerGexb(paths[j], 0, &chunks[j]);
+        else LoadViewerCSV(paths[j], 0, LLONG_MIN, 0xFFFFFFFFu, &chunks[j]);
+    });
+    for (ViewerData& chunk : chunks)
+        MergeViewerChunk(&data, chunk);
+    data.Series.Flush();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool SameStore(const SeriesStore& a, const SeriesStore& b)
+{
+    if (a.Times != b.Times || a.Observed != b.Observed || a.Active != b.Active) return false;
+    for (int s = 0; s < VS_COUNT; ++s)
+    {
+        if (a.Columns[s].size() != b.Columns[s].size()) return false;
+        for (size_t r = 0; r < a.Columns[s].size(); ++r)
+            if (!(a.Columns[s][r] == b.Columns[s][r] || (std::isnan(a.Columns[s][r]) && std::isnan(b.Columns[s][r]))))
+                return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    int days = 30;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (strcmp(argv[i], "--days") == 0) days = atoi(argv[i + 1]);
+
+    fs::path dir = fs::temp_directory_path() / "GexBotGexbStartupBench";
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    fs::create_directories(dir);
+
+    std::mt19937 rng(30);
+    std::vector<std::string> csvPaths, gexbPaths;
+    unsigned long long csvBytes = 0, gexbBytes = 0;
+    for (int d = 0; d < days; ++d)
+    {
+        csvPaths.push_back((dir / ("SPX_" + std::to_string(d) + ".csv")).string());
+        gexbPaths.push_back((dir / ("SPX_" + std::to_string(d) + ".gexb")).string());
+        WriteDay(csvPaths.back(), gexbPaths.back(), 1760000000LL + 14 * 3600 + 1800 + d * 86400LL, rng);
+        csvBytes += fs::file_size(csvPaths.back());
+        gexbBytes += fs::file_size(gexbPaths.back());
+    }
+
+    // Warm the page cache so both loads read from memory, as on a restart
+    ViewerData warm;
+    LoadAll(csvPaths, false, warm);
+    LoadAll(gexbPaths, true, warm);
+
+    ViewerData fromCsv, fromGexb;
+    double csvMs = LoadAll(csvPaths, false, fromCsv);
+    double gexbMs = LoadAll(gexbPaths, true, fromGexb);
+    bool same = SameStore(fromCsv.Series, fromGexb.Series);
+
+    printf("%d days, %zu rows, %u threads\n", days, fromCsv.Series.Size(), std::max(1u, std::thread::hardware_concurrency()));
+    printf("  CSV : %8.1f ms  (%.1f MB)\n", csvMs, csvBytes / 1048576.0);
+    printf("  gexb: %8.1f ms  (%.1f MB)  %.1fx\n", gexbMs, gexbBytes / 1048576.0, gexbMs > 0 ? csvMs / gexbMs : 0.0);
+    printf("  stores %s\n", same ? "identical" : "DIFFER");
+
+    fs::remove_all(dir, ec);
+    return same ? 0 : 1;
+}
@@ -0,0 +1,208 @@
+// Test of the Collector's binary twin (.gexb, GexBotDataCollector.cpp): a day
+// written the way the live writer does it (CSV row, commit record, then the
+// same row appended to the twin) must hold exactly the rows and values a
+// reader of the committed CSV gets, through the capacity doublings, and so
+// must the twin RebuildGexb makes from that CSV. A torn CSV tail stays out of
+// both; a twin with another schema refuses the append (the writer rebuilds).
+//
+// Build and run (from the repository root; needs Sierra Chart's ACS_Source for sierrachart.h):
+//   Windows (MSVC): cl /std:c++17 /O2 /EHsc /I C:\SierraChart\ACS_Source tests\GexbTwinTest.cpp && GexbTwinTest.exe
+// Exit code 0 = all passed.
+
+#include "../GexBotDataCollector.cpp"
+
+#include <filesystem>
+#include <random>
+
+namespace fs = std::filesystem;
+
+static int Checks = 0;
+static int Failures = 0;
+
+#define CHECK(cond, ...)                                                      \
+    do {                                                                      \
+        ++Checks;                                                             \
+        if (!(cond))                                                          \
+        {                                                                     \
+            if (++Failures <= 20)                                             \
+            {                                                                 \
+                fprintf(stderr, "FAILED %s:%d: %s: ", __FILE__, __LINE__, #cond); \
+                fprintf(stderr, __VA_ARGS__);                                 \
+                fprintf(stderr, "\n");                                        \
+            }                                                                 \
+        }                                                                     \
+    } while (0)
+
+struct Twin
+{
+    GexbHeader Header;
+    std::string Names;
+    std::vector<long long> Ts;
+    std::vector<float> Values;  // Row-major, FieldCount per row
+};
+
+static bool ReadTwin(const std::string& path, Twin& twin)
+{
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (bytes.size() < sizeof(GexbHeader)) return false;
+    memcpy(&twin.Header, bytes.data(), sizeof(GexbHeader));
+    const GexbHeader& h = twin.Header;
+    if (h.Magic != GEXB_MAGIC || h.Version != GEXB_VERSION || h.RowCount > h.Capacity ||
+        bytes.size() < GexbFieldOffset(h, h.FieldCount, 0))
+        return false;
+
+    twin.Names = std::string(bytes.data() + sizeof(GexbHeader), strnlen(bytes.data() + sizeof(GexbHeader), h.NamesBytes));
+    twin.Ts.resize(h.RowCount);
+    twin.Values.resize((size_t)h.RowCount * h.FieldCount);
+    for (int r = 0; r < h.RowCount; ++r)
+    {
+        memcpy(&twin.Ts[r], &bytes[(size_t)GexbTsOffset(h, r)], sizeof(long long));
+        for (int f = 0; f < h.FieldCount; ++f)
+            memcpy(&twin.Values[(size_t)r * h.FieldCount + f], &bytes[(size_t)GexbFieldOffset(h, f, r)], sizeof(float));
+    }
+    return true;
+}
+
+// The twin against the committed CSV rows, field by field as a reader parses the text
+static void CompareWithCsv(const std::string& csvPath, const std::string& gexbPath, const std::string& header, const char* what)
+{
+    std::vector<std::pair<double, std::string>> lines;
+    ReadCommittedCsvRows(csvPath, lines);
+    int fieldCount = (int)std::count(header.begin(), header.end(), ',');
+
+    Twin twin;
+    bool read = ReadTwin(gexbPath, twin);
+    CHECK(read, "%s: twin not readable", what);
+    if (!read) return;
+    CHECK(twin.Header.FieldCount == fieldCount, "%s: %d fields, expected %d", what, twin.Header.FieldCount, fieldCount);
+    CHECK(twin.Names == GexbNamesFromHeader(header), "%s: names '%s'", what, twin.Names.c_str());
+    CHECK(twin.Header.RowCount == (int)lines.size(), "%s: %d rows, CSV has %d", what, twin.Header.RowCount, (int)lines.size());
+    if (twin.Header.FieldCount != fieldCount) return;
+
+    int mismatches = 0;
+    for (size_t r = 0; r < lines.size() && r < twin.Ts.size(); ++r)
+    {
+        char* p = nullptr;
+        double ts = strtod(lines[r].second.c_str(), &p);
+        bool same = twin.Ts[r] == (long long)floor(ts * 1000.0 + 0.5);
+        for (int f = 0; f < fieldCount && same; ++f)
+        {
+            float want = (float)strtod(p + 1, &p);
+            same = twin.Values[r * fieldCount + f] == want;
+        }
+        if (!same && ++mismatches <= 3)
+            CHECK(same, "%s: row %d differs from '%s'", what, (int)r, lines[r].second.c_str());
+    }
+    CHECK(mismatches == 0, "%s: %d rows differ from the CSV", what, mismatches);
+}
+
+// One row as the live writer produces it: CSV line, commit record, twin append
+static bool WriteLiveRow(const std::string& csvPath, const std::string& gexbPath, const std::string& header,
+    double unixTs, const double* fields, const std::vector<double>& extras)
+{
+    bool fresh = !FileExists(csvPath);
+    std::string line = FormatCsvRow(unixTs, fields, extras);
+    {
+        std::ofstream out(csvPath, std::ios::binary | std::ios::app);
+        if (fresh) out << header;
+        out << line;
+    }
+    PublishCommit(csvPath, 1, fresh);
+
+    std::vector<float> binRow;
+    long long tsMs = ParseGexbRow(line, (int)(GRID_FIELDS + extras.size()), binRow);
+    return AppendGexbRow(gexbPath, GexbNamesFromHeader(header), tsMs, binRow);
+}
+
+static void TestLiveDay(const fs::path& dir)
+{
+    std::vector<SourcePackage> extras(1);
+    extras[0].Label = "SPX";
+    std::string header = BuildCsvHeader(extras);
+    std::string csvPath = (dir / "SPX_live.csv").string();
+    std::string gexbPath = GexbPathFor(csvPath);
+
+    // Values with more decimals than the CSV keeps, and timestamps off the 0.1 s grid
+    std::mt19937 rng(30);
+    std::uniform_real_distribution<double> value(-5000.0, 5000.0);
+    int rows = GEXB_INITIAL_CAPACITY * 2 + 1000;
+    double unixTs = 1760000000.0;
+    bool allAppended = true;
+    for (int k = 0; k < rows; ++k)
+    {
+        double fields[GRID_FIELDS];
+        for (double& f : fields) f = value(rng);
+        std::vector<double> extraValues(PACKAGE_FIELDS);
+        for (double& v : extraValues) v = value(rng);
+        unixTs += 1.0 + (rng() % 1000) / 1000.0;
+        allAppended &= WriteLiveRow(csvPath, gexbPath, header, unixTs, fields, extraValues);
+    }
+    CHECK(allAppended, "an append failed");
+
+    Twin twin;
+    ReadTwin(gexbPath, twin);
+    CHECK(twin.Header.Capacity == GEXB_INITIAL_CAPACITY * 4, "capacity %d after %d rows", twin.Header.Capacity, rows);
+    CompareWithCsv(csvPath, gexbPath, header, "appended");
+
+    // A torn CSV tail past the commit record is in neither
+    {
+        std::ofstream out(csvPath, std::ios::binary | std::ios::app);
+        out << "1760099999.0,12.5,3";
+    }
+    CompareWithCsv(csvPath, gexbPath, header, "torn tail");
+
+    // Rebuilt from the CSV (backfill, failed append): same rows as the appended twin
+    std::vector<std::pair<double, std::string>> lines;
+    ReadCommittedCsvRows(csvPath, lines);
+    std::string rebuiltPath = (dir / "SPX_rebuilt.gexb").string();
+    CHECK(RebuildGexb(rebuiltPath, header, lines), "rebuild failed");
+    CompareWithCsv(csvPath, rebuiltPath, header, "rebuilt");
+
+    Twin rebuilt;
+    ReadTwin(rebuiltPath, rebuilt);
+    CHECK(rebuilt.Ts == twin.Ts && rebuilt.Values == twin.Values, "rebuilt twin differs from the appended one");
+
+    // The rebuilt twin takes further appends
+    double fields[GRID_FIELDS] = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0, 13.0, 14.0 };
+    std::vector<double> extraValues(PACKAGE_FIELDS, 0.5);
+    fs::rename(rebuiltPath, gexbPath);
+    CommitRecord rec;
+    if (ReadCommitRecord(csvPath, rec)) fs::resize_file(csvPath, rec.CommittedBytes);   // Drop the torn tail
+    CHECK(WriteLiveRow(csvPath, gexbPath, header, unixTs + 1.0, fields, extraValues), "append after rebuild failed");
+    CompareWithCsv(csvPath, gexbPath, header, "appended after rebuild");
+}
+
+// A twin written for another layout (package added mid-day) refuses the row
+static void TestSchemaChange(const fs::path& dir)
+{
+    std::string csvPath = (dir / "SPX_schema.csv").string();
+    std::string gexbPath = GexbPathFor(csvPath);
+    std::string header = BuildCsvHeader(std::vector<SourcePackage>());
+    double fields[GRID_FIELDS] = { 5000.25, 4990.5 };
+    CHECK(WriteLiveRow(csvPath, gexbPath, header, 1760000000.0, fields, std::vector<double>()), "first append failed");
+
+    std::vector<SourcePackage> extras(1);
+    extras[0].Label = "NDX";
+    std::vector<float> row(GRID_FIELDS + PACKAGE_FIELDS, 1.0f);
+    CHECK(!AppendGexbRow(gexbPath, GexbNamesFromHeader(BuildCsvHeader(extras)), 1760000001000LL, row), "append with another schema accepted");
+
+    std::vector<float> renamed(GRID_FIELDS, 1.0f);
+    CHECK(!AppendGexbRow(gexbPath, "x" + GexbNamesFromHeader(header), 1760000001000LL, renamed), "append with other names accepted");
+    CompareWithCsv(csvPath, gexbPath, header, "schema");
+}
+
+int main()
+{
+    fs::path dir = fs::temp_directory_path() / "GexBotGexbTwinTest";
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    fs::create_directories(dir);
+
+    TestLiveDay(dir);
+    TestSchemaChange(dir);
+
+    fs::remove_all(dir, ec);
+    printf("%d checks, %d failed\n", Checks, Failures);
+    return Failures ? 1 : 0;
+}
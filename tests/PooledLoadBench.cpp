@@ -0,0 +1,148 @@
+// Scaling of the Viewer's pooled day load (GexBotCSVViewer.cpp) with the
+// number of threads: 30 days of 1 s rows (one package block) written as CSVs,
+// then read
+//   - one after another into the shared ViewerData, as ReloadFiles did before
+//     the pool, and
+//   - each into a private chunk on 1, 2, 4, ... threads (RunPool's job loop
+//     with a fixed thread count), the chunks merged in day order with
+//     MergeViewerChunk.
+// Prints the time of each and its speedup over the sequential load, and
+// checks that every load holds the same rows and values.
+//
+// Build and run (from the repository root; needs Sierra Chart's ACS_Source for sierrachart.h):
+//   Windows (MSVC): cl /std:c++17 /O2 /EHsc /I C:\SierraChart\ACS_Source tests\PooledLoadBench.cpp && PooledLoadBench.exe
+// Exit code 0 = all loads agree. --days N sets the number of days (default 30),
+// --threads N the most threads tried (default: one per core).
+
+#include "../GexBotCSVViewer.cpp"
+
+#include <filesystem>
+#include <random>
+
+namespace fs = std::filesystem;
+
+#define BENCH_ROWS_PER_DAY 23400    // 1 s rows over 09:30-16:00
+
+// One day as the Collector writes it (4 decimals)
+static void WriteDay(const std::string& csvPath, long long openUnix, std::mt19937& rng)
+{
+    std::string csv;
+    for (int c = 0; c < 15; ++c) csv += std::string(c ? "," : "") + CSV_COLUMN_NAMES[c];
+    for (int f = 0; f < PACKAGE_FIELDS; ++f) csv += std::string(",SPX.") + PACKAGE_FIELD_NAMES[f];
+    csv += "\r\n";
+
+    int fieldCount = 14 + PACKAGE_FIELDS;
+    char buf[64];
+    double spot = 5000.0;
+    for (int r = 0; r < BENCH_ROWS_PER_DAY; ++r)
+    {
+        snprintf(buf, sizeof(buf), "%lld.0", openUnix + r);
+        csv += buf;
+        spot += ((int)(rng() % 2001) - 1000) / 4000.0;
+        for (int f = 0; f < fieldCount; ++f)
+        {
+            snprintf(buf, sizeof(buf), ",%.4f", f == 0 ? spot : spot + ((int)(rng() % 200001) - 100000) / 1000.0);
+            csv += buf;
+        }
+        csv += "\r\n";
+    }
+    std::ofstream(csvPath, std::ios::binary).write(csv.data(), (std::streamsize)csv.size());
+}
+
+// threads = 0: every day straight into data on this thread. Otherwise RunPool's
+// loop on that many threads (this one included). Returns the milliseconds taken.
+static double LoadDays(const std::vector<std::string>& paths, size_t threads, ViewerData& data)
+{
+    auto start = std::chrono::steady_clock::now();
+    InWorkerPool = true;    // Days only: a file is not split into pieces
+    if (threads == 0)
+    {
+        for (const std::string& path : paths)
+            LoadViewerCSV(path, 0, LLONG_MIN, 0xFFFFFFFFu, &data);
+    }
+    else
+    {
+        std::vector<ViewerData> chunks(paths.size());
+        std::atomic<size_t> next(0);
+        auto worker = [&]() {
+            InWorkerPool = true;
+            for (size_t j = next++; j < paths.size(); j = next++)
+                LoadViewerCSV(paths[j], 0, LLONG_MIN, 0xFFFFFFFFu, &chunks[j]);
+        };
+        std::vector<std::thread> pool;
+        for (size_t i = 1; i < threads; ++i) pool.emplace_back(worker);
+        worker();
+        for (std::thread& t : pool) t.join();
+        for (ViewerData& chunk : chunks)
+            MergeViewerChunk(&data, chunk);
+    }
+    data.Series.Flush();
+    InWorkerPool = false;
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool SameStore(const SeriesStore& a, const SeriesStore& b)
+{
+    if (a.Times != b.Times || a.Observed != b.Observed || a.Active != b.Active) return false;
+    for (int s = 0; s < VS_COUNT; ++s)
+    {
+        if (a.Columns[s].size() != b.Columns[s].size()) return false;
+        for (size_t r = 0; r < a.Columns[s].size(); ++r)
+            if (!(a.Columns[s][r] == b.Columns[s][r] || (std::isnan(a.Columns[s][r]) && std::isnan(b.Columns[s][r]))))
+                return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    int days = 30;
+    size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (strcmp(argv[i], "--days") == 0) days = atoi(argv[i + 1]);
+        if (strcmp(argv[i], "--threads") == 0) maxThreads = (size_t)std::max(1, atoi(argv[i + 1]));
+    }
+
+    fs::path dir = fs::temp_directory_path() / "GexBotPooledLoadBench";
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    fs::create_directories(dir);
+
+    std::mt19937 rng(42);
+    std::vector<std::string> paths;
+    unsigned long long bytes = 0;
+    for (int d = 0; d < days; ++d)
+    {
+        paths.push_back((dir / ("SPX_" + std::to_string(d) + ".csv")).string());
+        WriteDay(paths.back(), 1760000000LL + 14 * 3600 + 1800 + d * 86400LL, rng);
+        bytes += fs::file_size(paths.back());
+    }
+
+    // Warm the page cache so every load reads from memory
+    ViewerData warm;
+    LoadDays(paths, 0, warm);
+
+    ViewerData sequential;
+    double sequentialMs = LoadDays(paths, 0, sequential);
+    printf("%d days, %zu rows, %.1f MB, %u cores\n", days, sequential.Series.Size(), bytes / 1048576.0,
+        std::max(1u, std::thread::hardware_concurrency()));
+    printf("  sequential : %8.1f ms\n", sequentialMs);
+
+    bool allSame = true;
+    std::vector<size_t> counts;
+    for (size_t threads = 1; threads < maxThreads; threads *= 2) counts.push_back(threads);
+    counts.push_back(maxThreads);
+    for (size_t threads : counts)
+    {
+        ViewerData pooled;
+        double ms = LoadDays(paths, threads, pooled);
+        bool same = SameStore(sequential.Series, pooled.Series);
+        allSame &= same;
+        printf("  %2zu thread%s: %8.1f ms  %.2fx%s\n", threads, threads == 1 ? " " : "s", ms,
+            ms > 0 ? sequentialMs / ms : 0.0, same ? "" : "  stores DIFFER");
+    }
+
+    fs::remove_all(dir, ec);
+    return allSame ? 0 : 1;
+}
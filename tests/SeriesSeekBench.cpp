@@ -0,0 +1,94 @@
+// Cost of finding the row of every bar in a full recalculation of the Viewer
+// (GexBotCSVViewer.cpp): 30 sessions of 1 s rows and 200,000 tick bars in
+// time order, 9 series read per bar, looked up
+//   - in one std::map per series (the history before SeriesStore),
+//   - with one binary search of SeriesStore::Times per bar, and
+//   - with SeriesStore::Seek's forward cursor (what the study does).
+// Prints the time of each and checks that the three find the same values.
+//
+// Build and run (from the repository root; needs Sierra Chart's ACS_Source for sierrachart.h):
+//   Windows (MSVC): cl /std:c++17 /O2 /EHsc /I C:\SierraChart\ACS_Source tests\SeriesSeekBench.cpp && SeriesSeekBench.exe
+// Exit code 0 = all lookups agree. --bars N sets the number of bars (default 200000).
+
+#include "../GexBotCSVViewer.cpp"
+
+#include <random>
+
+#define BENCH_SESSIONS      30
+#define BENCH_ROWS_PER_DAY  23400   // 1 s rows over the session
+#define BENCH_SERIES        9       // Subgraphs read per bar
+
+static double Milliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    size_t barCount = 200000;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (strcmp(argv[i], "--bars") == 0) barCount = (size_t)std::max(1, atoi(argv[i + 1]));
+
+    // Sessions from 14:30 (chart in UTC), every series in every row
+    std::mt19937 rng(49);
+    SeriesStore store;
+    std::map<double, float> maps[BENCH_SERIES];
+    float values[VS_COUNT];
+    for (int d = 0; d < BENCH_SESSIONS; ++d)
+    {
+        for (int r = 0; r < BENCH_ROWS_PER_DAY; ++r)
+        {
+            double t = 45000.0 + d + (14.5 * 3600 + r) / 86400.0;
+            for (int s = 0; s < VS_COUNT; ++s)
+                values[s] = s < BENCH_SERIES ? (float)(rng() % 100000) / 8.0f + 1.0f : NAN;
+            store.Add(t, values);
+            for (int s = 0; s < BENCH_SERIES; ++s) maps[s][t] = values[s];
+        }
+    }
+
+    // Tick bars: sorted random times over the sessions
+    std::vector<double> bars(barCount);
+    for (double& t : bars)
+        t = 45000.0 + rng() % BENCH_SESSIONS + (14.5 * 3600 + (rng() % (BENCH_ROWS_PER_DAY * 10)) / 10.0) / 86400.0;
+    std::sort(bars.begin(), bars.end());
+
+    // Sum of the values read, so no lookup is optimized away and the three can be compared
+    auto start = std::chrono::steady_clock::now();
+    double mapSum = 0;
+    for (double t : bars)
+        for (int s = 0; s < BENCH_SERIES; ++s)
+        {
+            auto it = maps[s].upper_bound(t);
+            if (it != maps[s].begin()) mapSum += std::prev(it)->second;
+        }
+    double mapMs = Milliseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    double searchSum = 0;
+    for (double t : bars)
+    {
+        size_t row = std::upper_bound(store.Times.begin(), store.Times.end(), t) - store.Times.begin();
+        if (row == 0) continue;
+        for (int s = 0; s < BENCH_SERIES; ++s) searchSum += store.Value(row - 1, s);
+    }
+    double searchMs = Milliseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    double seekSum = 0;
+    size_t cursor = 0;
+    for (double t : bars)
+    {
+        size_t row = store.Seek(t, cursor);
+        if (row == SeriesStore::NONE) continue;
+        for (int s = 0; s < BENCH_SERIES; ++s) seekSum += store.Value(row, s);
+    }
+    double seekMs = Milliseconds(start);
+
+    bool same = mapSum == searchSum && searchSum == seekSum;
+    printf("%zu bars over %zu rows (%d sessions), %d series per bar\n", barCount, store.Size(), BENCH_SESSIONS, BENCH_SERIES);
+    printf("  std::map per series : %8.1f ms\n", mapMs);
+    printf("  binary search / bar : %8.1f ms\n", searchMs);
+    printf("  Seek cursor         : %8.1f ms  %.1fx over the search\n", seekMs, seekMs > 0 ? searchMs / seekMs : 0.0);
+    printf("  values %s\n", same ? "identical" : "DIFFER");
+    return same ? 0 : 1;
+}
@@ -0,0 +1,250 @@
+// Test of the Viewer's mapped CSV read path (GexBotCSVViewer.cpp): MappedFile,
+// then LoadViewerCSV parsing straight from the mapped view of a multi-MB day.
+// The read stops at the committed length in "<file>.commit" (complete rows
+// past it wait for the next commit), never takes a torn last line, resumes
+// at its offset when the day grows, falls back to the physical size when the
+// commit record is stale, and gives the same rows when read slice by slice on
+// a budget. CsvReaderTest.cpp covers the tokenizer itself.
+//
+// Build and run (from the repository root; needs Sierra Chart's ACS_Source for sierrachart.h):
+//   Windows (MSVC): cl /std:c++17 /O2 /EHsc /I C:\SierraChart\ACS_Source tests\ViewerMappedReaderTest.cpp && ViewerMappedReaderTest.exe
+// Exit code 0 = all passed. --mb N sets the size of the generated day (default 8).
+
+#include "../GexBotCSVViewer.cpp"
+
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+static int Checks = 0;
+static int Failures = 0;
+
+#define CHECK(cond, ...)                                                      \
+    do {                                                                      \
+        ++Checks;                                                             \
+        if (!(cond))                                                          \
+        {                                                                     \
+            if (++Failures <= 20)                                             \
+            {                                                                 \
+                fprintf(stderr, "FAILED %s:%d: %s: ", __FILE__, __LINE__, #cond); \
+                fprintf(stderr, __VA_ARGS__);                                 \
+                fprintf(stderr, "\n");                                        \
+            }                                                                 \
+        }                                                                     \
+    } while (0)
+
+#define SESSION_OPEN_UNIX 1759987800LL  // 2025-10-09 14:30 UTC; the chart is in UTC
+
+// Row i of the generated day; zero_gamma carries the row number
+static std::string DayRow(long long i)
+{
+    char line[160];
+    snprintf(line, sizeof(line), "%lld.0,5000.5,%.2f,1,2,3,4,5,6,7,8,9,10,11,12\r\n", SESSION_OPEN_UNIX + i, 1000.0 + (i % 4000) * 0.25);
+    return line;
+}
+
+static std::string DayHeader()
+{
+    std::string header;
+    for (int c = 0; c < 15; ++c) header += std::string(c ? "," : "") + CSV_COLUMN_NAMES[c];
+    return header + "\r\n";
+}
+
+static void WriteWholeFile(const std::string& path, const std::string& content)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), (std::streamsize)content.size());
+}
+
+static void AppendToFile(const std::string& path, const std::string& content)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    out.write(content.data(), (std::streamsize)content.size());
+}
+
+static void WriteCommit(const std::string& csvPath, unsigned long long committedBytes, unsigned long long rows)
+{
+    CommitRecord rec = { COMMIT_MAGIC, COMMIT_VERSION, committedBytes, rows, 0 };
+    rec.Checksum = CommitChecksum(rec);
+    std::ofstream out(csvPath + ".commit", std::ios::binary | std::ios::trunc);
+    out.write((const char*)&rec, sizeof(rec));
+}
+
+// The store holds exactly rows [0, count) of the day
+static void CheckRows(const ViewerData& data, long long count, const char* what)
+{
+    const SeriesStore& series = data.Series;
+    CHECK((long long)series.Size() == count, "%s: %zu rows, expected %lld", what, series.Size(), count);
+    int mismatches = 0;
+    for (long long i = 0; i < count && i < (long long)series.Times.size(); ++i)
+    {
+        double t = SCDateTime((SESSION_OPEN_UNIX + i) / 86400.0 + 25569.0).GetAsDouble();
+        float zero = (float)(1000.0 + (i % 4000) * 0.25);
+        if ((series.Times[i] != t || series.Value((size_t)i, VS_ZERO) != zero) && ++mismatches <= 3)
+            CHECK(false, "%s: row %lld holds %.8f / %g", what, i, series.Times[i], series.Value((size_t)i, VS_ZERO));
+    }
+    CHECK(mismatches == 0, "%s: %d rows differ", what, mismatches);
+}
+
+static void Load(const std::string& path, ViewerData& data, const LoadDeadline* deadline = nullptr)
+{
+    LoadViewerCSV(path, 0, LLONG_MIN, 0xFFFFFFFFu, &data, deadline);
+    data.Series.Flush();
+}
+
+// =========================
+//       MAPPED FILE
+// =========================
+
+static void TestMappedFile(const fs::path& dir, size_t bytes)
+{
+    std::string path = (dir / "mapped.bin").string();
+    std::string content;
+    for (size_t i = 0; content.size() < bytes; ++i) content += DayRow((long long)i);
+    WriteWholeFile(path, content);
+
+    MappedFile mf;
+    CHECK(mf.Open(path), "cannot map %s", path.c_str());
+    CHECK(mf.Size == content.size(), "mapped %llu bytes, file has %zu", mf.Size, content.size());
+    CHECK(mf.Data && memcmp(mf.Data, content.data(), content.size()) == 0, "mapped bytes differ from the file");
+    mf.Close();
+    CHECK(mf.Data == nullptr && mf.Size == 0, "Close left the view");
+
+    std::string empty = (dir / "empty.bin").string();
+    WriteWholeFile(empty, "");
+    MappedFile none;
+    CHECK(!none.Open(empty) && none.Data == nullptr, "an empty file was mapped");
+    CHECK(!none.Open((dir / "missing.bin").string()), "a missing file was mapped");
+}
+
+// =========================
+//     COMMITTED LENGTH
+// =========================
+
+static void TestCommittedRead(const fs::path& dir, size_t bytes)
+{
+    std::string path = (dir / "SPX_commit.csv").string();
+    std::string content = DayHeader();
+    long long committedRows = 0;
+    while (content.size() < bytes) content += DayRow(committedRows++);
+    unsigned long long committedBytes = content.size();
+
+    // Complete rows the writer has not committed yet, then a torn one
+    long long writtenRows = committedRows;
+    for (int k = 0; k < 50; ++k) content += DayRow(writtenRows++);
+    std::string torn = DayRow(writtenRows);
+    content += torn.substr(0, torn.size() / 2);
+    WriteWholeFile(path, content);
+    WriteCommit(path, committedBytes, committedRows);
+
+    ViewerData data;
+    Load(path, data);
+    CheckRows(data, committedRows, "committed");
+    CHECK(data.FileOffsets[path] == committedBytes, "offset %llu, committed %llu", data.FileOffsets[path], committedBytes);
+
+    // Nothing new committed: the next read takes nothing
+    Load(path, data);
+    CheckRows(data, committedRows, "nothing new");
+
+    // The writer commits its complete rows: only they are read, from the offset
+    unsigned long long completeBytes = content.size() - torn.size() / 2;
+    WriteCommit(path, completeBytes, writtenRows);
+    data.Series.ChangedFrom = DBL_MAX;
+    Load(path, data);
+    CheckRows(data, writtenRows, "tail");
+    double firstNew = SCDateTime((SESSION_OPEN_UNIX + committedRows) / 86400.0 + 25569.0).GetAsDouble();
+    CHECK(data.Series.ChangedFrom == firstNew, "tail read changed from %.8f, expected %.8f", data.Series.ChangedFrom, firstNew);
+    CHECK(data.FileOffsets[path] == completeBytes, "offset %llu after the tail, expected %llu", data.FileOffsets[path], completeBytes);
+
+    // A commit record past the end (a file recreated shorter) is not trusted
+    std::string stale = (dir / "SPX_stale.csv").string();
+    WriteWholeFile(stale, content);
+    WriteCommit(stale, content.size() + 4096, writtenRows + 100);
+    ViewerData fromStale;
+    Load(stale, fromStale);
+    CheckRows(fromStale, writtenRows, "stale commit");
+}
+
+// =========================
+//        TORN LINE
+// =========================
+
+static void TestTornLine(const fs::path& dir, size_t bytes)
+{
+    // No commit record: the physical size, up to the last newline
+    std::string path = (dir / "SPX_torn.csv").string();
+    std::string content = DayHeader();
+    long long rows = 0;
+    while (content.size() < bytes) content += DayRow(rows++);
+    std::string torn = DayRow(rows);
+    size_t cut = torn.find(',', torn.find(',') + 1) + 3;    // Mid zero_gamma
+    WriteWholeFile(path, content + torn.substr(0, cut));
+
+    ViewerData data;
+    Load(path, data);
+    CheckRows(data, rows, "torn line left out");
+    CHECK(data.FileOffsets[path] == content.size(), "offset %llu, last newline at %zu", data.FileOffsets[path], content.size());
+
+    // The rest of the line arrives: it is read whole, once
+    AppendToFile(path, torn.substr(cut));
+    Load(path, data);
+    CheckRows(data, rows + 1, "torn line completed");
+
+    // A last line cut right after "\r" is still torn
+    AppendToFile(path, DayRow(rows + 1).substr(0, DayRow(rows + 1).size() - 1));
+    Load(path, data);
+    CheckRows(data, rows + 1, "line without its newline");
+    AppendToFile(path, "\n");
+    Load(path, data);
+    CheckRows(data, rows + 2, "newline arrived");
+}
+
+// =========================
+//      BUDGETED READ
+// =========================
+
+static void TestBudgetedRead(const fs::path& dir, size_t bytes)
+{
+    std::string path = (dir / "SPX_budget.csv").string();
+    std::string content = DayHeader();
+    long long rows = 0;
+    while (content.size() < bytes) content += DayRow(rows++);
+    WriteWholeFile(path, content);
+    WriteCommit(path, content.size(), rows);
+
+    // A deadline already past: one slice per call, the offset following each
+    LoadDeadline past = std::chrono::steady_clock::now();
+    ViewerData data;
+    int calls = 0;
+    do
+    {
+        data.LoadPending = false;
+        Load(path, data, &past);
+        ++calls;
+    } while (data.LoadPending && calls < 10000);
+    CheckRows(data, rows, "budgeted");
+    size_t slices = (content.size() + LOAD_SLICE_BYTES - 1) / LOAD_SLICE_BYTES;
+    CHECK(calls > 1 && (size_t)calls <= slices + 1, "%d calls for %zu slices", calls, slices);
+    CHECK(data.FileOffsets[path] == content.size(), "offset %llu after the budgeted read", data.FileOffsets[path]);
+}
+
+int main(int argc, char** argv)
+{
+    size_t mb = 8;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (strcmp(argv[i], "--mb") == 0) mb = (size_t)std::max(1, atoi(argv[i + 1]));
+
+    fs::path dir = fs::temp_directory_path() / "GexBotViewerMappedReaderTest";
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    fs::create_directories(dir);
+
+    TestMappedFile(dir, mb << 20);
+    TestCommittedRead(dir, mb << 20);
+    TestTornLine(dir, mb << 20);
+    TestBudgetedRead(dir, mb << 20);
+
+    fs::remove_all(dir, ec);
+    printf("%d checks, %d failed\n", Checks, Failures);
+    return Failures ? 1 : 0;
+}
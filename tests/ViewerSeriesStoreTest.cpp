@@ -0,0 +1,159 @@
+// Randomized test of the Viewer's SeriesStore (GexBotCSVViewer.cpp) against
+// the per-series std::map it replaced: at a bar, a series reads the last value
+// recorded at or before it on the same date (GetValue). Rows arrive in order,
+// out of order (Pending), and as day chunks merged with MergeFrom; extra
+// package series only appear part way through, and evicted spans are erased.
+//
+// Build and run (from the repository root; needs Sierra Chart's ACS_Source for sierrachart.h):
+//   Windows (MSVC): cl /std:c++17 /O2 /EHsc /I C:\SierraChart\ACS_Source tests\ViewerSeriesStoreTest.cpp && ViewerSeriesStoreTest.exe
+// Exit code 0 = all passed.
+
+#include "../GexBotCSVViewer.cpp"
+
+#include <random>
+
+static int Checks = 0;
+static int Failures = 0;
+
+#define CHECK(cond, ...)                                                      \
+    do {                                                                      \
+        ++Checks;                                                             \
+        if (!(cond))                                                          \
+        {                                                                     \
+            if (++Failures <= 20)                                             \
+            {                                                                 \
+                fprintf(stderr, "FAILED %s:%d: %s: ", __FILE__, __LINE__, #cond); \
+                fprintf(stderr, __VA_ARGS__);                                 \
+                fprintf(stderr, "\n");                                        \
+            }                                                                 \
+        }                                                                     \
+    } while (0)
+
+#define TZ_OFFSET 0     // Chart in UTC: market hours 14:30-21:00
+
+// The old history: one map per series, recorded values only
+struct Reference
+{
+    std::map<double, float> Values[VS_COUNT];
+
+    void Add(double t, const float* values)
+    {
+        for (int s = 0; s < VS_COUNT; ++s)
+            if (!std::isnan(values[s])) Values[s][t] = values[s];
+    }
+
+    void Erase(double from, double to)
+    {
+        for (int s = 0; s < VS_COUNT; ++s)
+            Values[s].erase(Values[s].lower_bound(from), Values[s].lower_bound(to));
+    }
+
+    // Any series at or before t: the store has a row there even when s is not in it
+    double LastRowTime(double t) const
+    {
+        double last = -DBL_MAX;
+        for (int s = 0; s < VS_COUNT; ++s)
+        {
+            auto it = Values[s].upper_bound(t);
+            if (it != Values[s].begin()) last = std::max(last, std::prev(it)->first);
+        }
+        return last;
+    }
+
+    float Get(int s, double t) const
+    {
+        if (!IsWithinMarketHours(SCDateTime(t), TZ_OFFSET)) return -FLT_MAX;
+        double row = LastRowTime(t);
+        if (row == -DBL_MAX || SCDateTime(row).GetDate() != SCDateTime(t).GetDate()) return -FLT_MAX;
+        auto it = Values[s].upper_bound(t);
+        if (it == Values[s].begin()) return -FLT_MAX;
+        --it;
+        return SCDateTime(it->first).GetDate() == SCDateTime(t).GetDate() ? it->second : -FLT_MAX;
+    }
+};
+
+// A row during the session of day 45000 + 0..2; package series only when packages is set
+static double RandomRow(std::mt19937& rng, bool packages, float* values)
+{
+    bool any = false;
+    while (!any)
+    {
+        for (int s = 0; s < VS_COUNT; ++s)
+        {
+            bool present = (s < VS_PACKAGE || (packages && s < VS_PACKAGE + PACKAGE_FIELDS)) && rng() % 3 == 0;
+            values[s] = present ? (float)(rng() % 100000) / 8.0f + 1.0f : NAN;
+            any |= present;
+        }
+    }
+    return 45000.0 + rng() % 3 + (14.0 * 3600 + rng() % (8 * 3600)) / 86400.0;
+}
+
+static void CompareAt(const SeriesStore& store, const Reference& ref, double t, size_t& cursor, int iter)
+{
+    size_t row = store.Seek(t, cursor);
+    for (int s = 0; s < VS_COUNT; ++s)
+    {
+        float got = GetValue(store, row, s, SCDateTime(t), TZ_OFFSET);
+        float want = ref.Get(s, t);
+        CHECK(got == want, "iteration %d, t %.6f, series %d: %g, expected %g", iter, t, s, got, want);
+    }
+}
+
+static void TestAgainstMap()
+{
+    std::mt19937 rng(7);
+    float values[VS_COUNT];
+    for (int iter = 0; iter < 400; ++iter)
+    {
+        SeriesStore store, chunk;
+        Reference ref;
+        int rows = (int)(rng() % 800);
+        for (int k = 0; k < rows; ++k)
+        {
+            // Odd iterations: a second package shows up half way through
+            double t = RandomRow(rng, (iter % 2) && k > rows / 2, values);
+            ref.Add(t, values);
+            if (rng() % 4 == 0)
+            {
+                chunk.Add(t, values);
+                if (rng() % 20 == 0) store.MergeFrom(chunk);
+            }
+            else
+            {
+                if (!chunk.Empty()) store.MergeFrom(chunk);
+                store.Add(t, values);
+            }
+            if (rng() % 50 == 0) store.Flush();
+        }
+        store.MergeFrom(chunk);
+        store.Flush();
+
+        CHECK(store.IsActive(VS_PACKAGE) == !ref.Values[VS_PACKAGE].empty(), "iteration %d: package column allocation", iter);
+        CHECK(!store.IsActive(VS_PACKAGE + PACKAGE_FIELDS), "iteration %d: second package block allocated", iter);
+
+        // An evicted span (EvictViewerDay): rows in [from, to) go, ChangedFrom covers them
+        if (rng() % 3 == 0 && !store.Times.empty())
+        {
+            double from = store.Times[rng() % store.Times.size()];
+            double to = from + (rng() % 40000) / 86400.0;
+            store.ChangedFrom = DBL_MAX;
+            size_t before = store.Size();
+            store.Erase(from, to);
+            ref.Erase(from, to);
+            CHECK(store.Size() == before || store.ChangedFrom <= from, "iteration %d: ChangedFrom after Erase", iter);
+        }
+
+        size_t cursor = 0;
+        for (double t = 44999.9; t < 45003.0; t += (1 + rng() % 600) / 86400.0)
+            CompareAt(store, ref, t, cursor, iter);
+        for (int q = 0; q < 300; ++q)
+            CompareAt(store, ref, 45000.0 + (rng() % (3 * 86400)) / 86400.0, cursor, iter);
+    }
+}
+
+int main()
+{
+    TestAgainstMap();
+    printf("%d checks, %d failed\n", Checks, Failures);
+    return Failures ? 1 : 0;
+}